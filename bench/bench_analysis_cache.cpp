@@ -0,0 +1,92 @@
+// Benchmark: segunda compilación de un proyecto sin cambios. En frío se analizan todas
+// las unidades; con la caché en disco se carga el archivo, se calcula la huella de cada
+// unidad y se toma el resultado guardado. También mide el costo de mantener la huella en
+// cada inserción.
+#include "../src/AnalysisCache.hpp"
+#include "../src/CompileSession.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int UNITS = 200;
+    const int SYMBOLS = 2000;
+    const int ENTRIES = 200000;
+
+    std::vector<std::string> symbolNames;
+
+    // "Análisis" de una unidad: llena su global y resuelve cada símbolo
+    std::string analyze(TranslationUnit &unit)
+    {
+        int arr = unit.types().addArrayType(0, static_cast<int>(unit.name().size()));
+        SymbolTableStack &stack = unit.symbols();
+        for (int s = 0; s < SYMBOLS; ++s)
+            stack.insertTop({symbolNames[s], arr, Category::VAR, s * 4, {}});
+        long sum = 0;
+        for (int s = 0; s < SYMBOLS; ++s)
+            sum += stack.find(symbolNames[(s * 7) % SYMBOLS])->address;
+        return unit.name() + ":" + std::to_string(sum);
+    }
+
+    double msSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main()
+{
+    for (int s = 0; s < SYMBOLS; ++s)
+        symbolNames.push_back("sym_" + std::to_string(s));
+    std::vector<std::string> names, sources;
+    for (int u = 0; u < UNITS; ++u)
+    {
+        names.push_back("unit" + std::to_string(u) + ".c");
+        sources.push_back(std::string(4096, static_cast<char>('a' + u % 26)));
+    }
+    auto inputsOf = [&](const std::string &name)
+    { return FingerprintBuilder().add(sources[std::stoi(name.substr(4))]).result(); };
+
+    CompileSession session;
+    const std::string path = "/tmp/bench_analysis_cache.bin";
+
+    auto start = std::chrono::steady_clock::now();
+    AnalysisCache cold;
+    auto first = session.compileCached(names, cold, inputsOf, analyze);
+    cold.save(path);
+    double coldMs = msSince(start);
+
+    start = std::chrono::steady_clock::now();
+    AnalysisCache warm;
+    warm.load(path);
+    auto second = session.compileCached(names, warm, inputsOf, analyze);
+    double warmMs = msSince(start);
+    std::remove(path.c_str());
+
+    // Huella de una entrada (lo que se agrega a cada insert)
+    std::vector<SymbolEntry> entries;
+    for (int i = 0; i < ENTRIES; ++i)
+        entries.push_back({"var_" + std::to_string(i), 1, Category::VAR, i, {}});
+    start = std::chrono::steady_clock::now();
+    Fingerprint sum;
+    for (const SymbolEntry &entry : entries)
+        sum += entryFingerprint(entry);
+    double printMs = msSince(start);
+
+    start = std::chrono::steady_clock::now();
+    SymbolTable table;
+    for (const SymbolEntry &entry : entries)
+        table.insert(entry);
+    double insertMs = msSince(start);
+
+    std::printf("%d unidades x %d símbolos\n", UNITS, SYMBOLS);
+    std::printf("en frío (analiza y guarda): %8.1f ms\n", coldMs);
+    std::printf("con caché (carga y consulta): %6.1f ms (%zu aciertos)\n", warmMs, warm.hits());
+    std::printf("huella por entrada: %.1f ns; insert completo: %.1f ns\n", printMs * 1e6 / ENTRIES,
+                insertMs * 1e6 / ENTRIES);
+    std::printf("(iguales: %s, tabla %s, checksum %s)\n", first == second ? "sí" : "no",
+                table.fingerprint().toHex().c_str(), sum.toHex().c_str());
+    return 0;
+}
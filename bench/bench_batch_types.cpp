@@ -0,0 +1,73 @@
+// Benchmark: comprobación de tipos por lotes (TypeManager::checkBatch) contra llamadas
+// por nodo a max/areCompatible/isValidConversion sobre un árbol de expresión aplanado.
+#include "../src/TypeManager.hpp"
+#include "../src/TypeTable.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+int main()
+{
+    TypeTable table;
+    table.addBasicType("void", 0);
+    table.addBasicType("bool", 1);
+    table.addBasicType("char", 1);
+    int tInt = table.addBasicType("int", 4);
+    table.addBasicType("float", 4);
+    table.addBasicType("double", 8);
+    table.addArrayType(tInt, 10);
+    TypeManager manager(table);
+
+    const size_t NODES = 1 << 20;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> typeDist(2, 5); // solo numéricos para que max no lance
+    std::uniform_int_distribution<int> opDist(0, static_cast<int>(TypeOp::COUNT) - 1);
+
+    std::vector<int32_t> t1(NODES), t2(NODES), result(NODES);
+    std::vector<TypeOp> ops(NODES);
+    std::vector<uint8_t> error(NODES);
+    for (size_t i = 0; i < NODES; ++i)
+    {
+        t1[i] = typeDist(rng);
+        t2[i] = typeDist(rng);
+        ops[i] = static_cast<TypeOp>(opDist(rng));
+    }
+
+    const int ROUNDS = 10;
+    long long checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        for (size_t i = 0; i < NODES; ++i)
+        {
+            switch (ops[i])
+            {
+            case TypeOp::MAX: result[i] = manager.max(t1[i], t2[i]); break;
+            case TypeOp::MIN: result[i] = manager.min(t1[i], t2[i]); break;
+            case TypeOp::COMPATIBLE: result[i] = manager.areCompatible(t1[i], t2[i]); break;
+            case TypeOp::IMPLICIT: result[i] = manager.isValidConversion(t1[i], t2[i], true); break;
+            default: result[i] = manager.isValidConversion(t1[i], t2[i], false); break;
+            }
+        }
+        checksum += result[r];
+    }
+    double scalar = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    manager.prepareBatch();
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; ++r)
+    {
+        manager.checkBatch(t1.data(), t2.data(), ops.data(), NODES, result.data(), error.data());
+        checksum += result[r];
+    }
+    double batch = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const char *mode = TypeManager::batchAvx2Available() ? "AVX2" : "escalar";
+    std::printf("%zu nodos x %d rondas\n", NODES, ROUNDS);
+    std::printf("por nodo:        %10.2f ms\n", scalar);
+    std::printf("por lotes (%s): %8.2f ms  (%.1fx)\n", mode, batch, scalar / batch);
+    std::printf("checksum %lld\n", checksum);
+    return 0;
+}
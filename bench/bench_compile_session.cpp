@@ -0,0 +1,92 @@
+// Benchmark: arranque de una unidad de compilación. Sin preludio compartido cada unidad
+// vuelve a registrar los tipos básicos, recalcula la retícula del TypeManager y llena su
+// global con las declaraciones de biblioteca; con CompileSession abre una capa vacía sobre
+// los tipos del preludio (sin copiarlos) y monta su pila sobre el global congelado.
+#include "../src/CompileSession.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int UNITS = 2000;
+    const int PRELUDE_SYMBOLS = 200;
+    const int PRELUDE_ARRAYS = 50;
+
+    std::vector<std::string> preludeNames;
+
+    void addPreludeTypes(TypeTable &types)
+    {
+        int tInt = types.addBasicType("int", 4);
+        types.addBasicType("char", 1);
+        types.addBasicType("float", 4);
+        types.addBasicType("double", 8);
+        for (int i = 1; i <= PRELUDE_ARRAYS; ++i)
+            types.addArrayType(tInt, i);
+    }
+
+    // El trabajo propio de la unidad, igual en ambos casos
+    long compileBody(TypeTable &types, SymbolTableStack &stack)
+    {
+        int arr = types.addArrayType(0, 1000);
+        stack.insertTop({"main", arr, Category::FUNCTION, 0, {}});
+        return stack.find(preludeNames[PRELUDE_SYMBOLS / 2])->address + stack.find("main")->typeId;
+    }
+
+    long coldUnit()
+    {
+        TypeTable types;
+        addPreludeTypes(types);
+        TypeManager manager(types);
+        manager.prepareBatch();
+
+        SymbolTableStack stack;
+        stack.pushScope();
+        for (int s = 0; s < PRELUDE_SYMBOLS; ++s)
+            stack.insertBase({preludeNames[s], 0, Category::FUNCTION, s, {}});
+        return compileBody(types, stack) + manager.max(0, 2);
+    }
+
+    long sharedUnit(const CompileSession &session)
+    {
+        auto unit = session.openUnit("unit.c");
+        return compileBody(unit->types(), unit->symbols()) + unit->typeManager().max(0, 2);
+    }
+
+    double msSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main()
+{
+    for (int s = 0; s < PRELUDE_SYMBOLS; ++s)
+        preludeNames.push_back("lib_" + std::to_string(s));
+
+    TypeTable types;
+    addPreludeTypes(types);
+    SymbolTable symbols;
+    for (int s = 0; s < PRELUDE_SYMBOLS; ++s)
+        symbols.insert({preludeNames[s], 0, Category::FUNCTION, s, {}});
+    CompileSession session(std::make_shared<const Prelude>(std::move(types), std::move(symbols)));
+
+    long sum = coldUnit() + sharedUnit(session); // calentamiento
+
+    auto start = std::chrono::steady_clock::now();
+    for (int u = 0; u < UNITS; ++u)
+        sum += coldUnit();
+    double coldMs = msSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int u = 0; u < UNITS; ++u)
+        sum += sharedUnit(session);
+    double sharedMs = msSince(start);
+
+    std::printf("%d unidades (preludio: %d tipos, %d símbolos)\n", UNITS, PRELUDE_ARRAYS + 4, PRELUDE_SYMBOLS);
+    std::printf("sin preludio compartido: %8.1f ms (%.2f us/unidad)\n", coldMs, coldMs * 1000 / UNITS);
+    std::printf("CompileSession:          %8.1f ms (%.2f us/unidad)\n", sharedMs, sharedMs * 1000 / UNITS);
+    std::printf("(checksum %ld)\n", sum);
+    return 0;
+}
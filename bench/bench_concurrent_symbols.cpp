@@ -0,0 +1,88 @@
+// Benchmark de escalabilidad: inserción concurrente de declaraciones globales.
+// Compara ConcurrentSymbolTable (sin candados) contra una SymbolTable protegida con un mutex,
+// con 1 a 64 hilos insertando y consultando un total fijo de ids. La tabla sin candados se
+// mide dimensionada de antemano y creciendo desde sus cubetas por omisión.
+#include "../src/ConcurrentSymbolTable.hpp"
+#include "../src/SymbolTable.hpp"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const int TOTAL_IDS = 200000;
+
+    std::vector<std::string> makeIds()
+    {
+        std::vector<std::string> ids;
+        ids.reserve(TOTAL_IDS);
+        for (int i = 0; i < TOTAL_IDS; ++i)
+            ids.push_back("global_" + std::to_string(i));
+        return ids;
+    }
+
+    // Cada hilo inserta su bloque de ids y luego consulta todos los del bloque
+    template <typename Work>
+    double run(int threads, Work work)
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool;
+        int chunk = TOTAL_IDS / threads;
+        for (int t = 0; t < threads; ++t)
+        {
+            int begin = t * chunk;
+            int end = (t == threads - 1) ? TOTAL_IDS : begin + chunk;
+            pool.emplace_back([=]
+                              { work(begin, end); });
+        }
+        for (auto &th : pool)
+            th.join();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main()
+{
+    auto ids = makeIds();
+    std::printf("%8s %16s %16s %16s\n", "hilos", "lock-free (ms)", "crece (ms)", "mutex (ms)");
+
+    for (int threads = 1; threads <= 64; threads *= 2)
+    {
+        ConcurrentSymbolTable concurrent(1 << 18);
+        double lockFree = run(threads, [&](int begin, int end)
+                              {
+                                  for (int i = begin; i < end; ++i)
+                                      concurrent.insert({ids[i], 3, Category::VAR, i, {}});
+                                  for (int i = begin; i < end; ++i)
+                                      concurrent.lookup(ids[i]); });
+
+        ConcurrentSymbolTable growing;
+        double grown = run(threads, [&](int begin, int end)
+                           {
+                               for (int i = begin; i < end; ++i)
+                                   growing.insert({ids[i], 3, Category::VAR, i, {}});
+                               for (int i = begin; i < end; ++i)
+                                   growing.lookup(ids[i]); });
+
+        SymbolTable table;
+        std::mutex mutex;
+        double locked = run(threads, [&](int begin, int end)
+                            {
+                                for (int i = begin; i < end; ++i)
+                                {
+                                    std::lock_guard<std::mutex> lock(mutex);
+                                    table.insert({ids[i], 3, Category::VAR, i, {}});
+                                }
+                                for (int i = begin; i < end; ++i)
+                                {
+                                    std::lock_guard<std::mutex> lock(mutex);
+                                    table.lookup(ids[i]);
+                                } });
+
+        std::printf("%8d %16.2f %16.2f %16.2f\n", threads, lockFree, grown, locked);
+    }
+    return 0;
+}
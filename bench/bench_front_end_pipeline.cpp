@@ -0,0 +1,112 @@
+// Benchmark: front-end por eventos. Pasadas completas (todo el flujo en memoria y cada
+// etapa lo recorre entero, como con un AST) contra el pipeline por lotes acotados, sin
+// hilos y con un hilo por etapa.
+#include "../src/FrontEndPipeline.hpp"
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int FUNCTIONS = 20000;
+    const int STATEMENTS = 4;
+
+    using K = FrontEndEventKind;
+
+    // Genera el programa evento por evento, sin guardarlo
+    class Generator
+    {
+    private:
+        int tInt, tFloat;
+        std::vector<FrontEndEvent> pending;
+        size_t next = 0;
+        int function = 0;
+
+        void refill()
+        {
+            pending.clear();
+            next = 0;
+            pending.push_back({K::BEGIN_FUNCTION, "f" + std::to_string(function), tInt});
+            pending.push_back({K::DECLARE, "i", tInt, Category::PARAM});
+            pending.push_back({K::DECLARE, "n", tInt, Category::PARAM});
+            pending.push_back({K::DECLARE, "x", tFloat});
+            pending.push_back({K::DECLARE, "acc", tFloat});
+            for (int s = 0; s < STATEMENTS; ++s)
+            {
+                // acc = acc + x * i - n
+                pending.push_back({K::LOAD, "acc"});
+                pending.push_back({K::LOAD, "x"});
+                pending.push_back({K::LOAD, "i"});
+                pending.push_back({K::BINARY, "*"});
+                pending.push_back({K::BINARY, "+"});
+                pending.push_back({K::LOAD, "n"});
+                pending.push_back({K::BINARY, "-"});
+                pending.push_back({K::ASSIGN, "acc"});
+            }
+            pending.push_back({K::END_FUNCTION, ""});
+            ++function;
+        }
+
+    public:
+        Generator(int intType, int floatType) : tInt(intType), tFloat(floatType) {}
+
+        bool operator()(FrontEndEvent &event)
+        {
+            if (next == pending.size())
+            {
+                if (function == FUNCTIONS)
+                    return false;
+                refill();
+            }
+            event = std::move(pending[next++]);
+            return true;
+        }
+    };
+
+    struct Result
+    {
+        double ms;
+        PipelineStats stats;
+        size_t quads;
+    };
+
+    Result run(PipelineOptions options)
+    {
+        TypeTable types;
+        int tInt = types.addBasicType("int", 4);
+        int tFloat = types.addBasicType("float", 4);
+        TypeManager manager(types);
+        SymbolTableStack symbols;
+        symbols.pushScope();
+        CodeGenerator gen;
+
+        auto start = std::chrono::steady_clock::now();
+        FrontEndPipeline pipeline(symbols, manager, gen, options);
+        PipelineStats stats = pipeline.run(Generator(tInt, tFloat));
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return {ms, stats, gen.getCode().size()};
+    }
+
+    void report(const char *label, const Result &r)
+    {
+        std::printf("%-28s %8.1f ms  en tránsito: %8zu eventos (~%6.1f KiB)\n", label, r.ms,
+                    r.stats.peakBufferedEvents, r.stats.peakBufferedEvents * sizeof(FrontEndEvent) / 1024.0);
+    }
+}
+
+int main()
+{
+    run(PipelineOptions{256, 4, false}); // calentamiento
+
+    Result whole = run(PipelineOptions{std::numeric_limits<size_t>::max() / 2, 1, false});
+    Result batched = run(PipelineOptions{256, 4, false});
+    Result threaded = run(PipelineOptions{256, 4, true});
+
+    std::printf("%zu eventos, %zu cuádruplos\n", whole.stats.events, whole.quads);
+    report("pasadas completas:", whole);
+    report("lotes de 256, sin hilos:", batched);
+    report("lotes de 256, 3 hilos:", threaded);
+    return 0;
+}
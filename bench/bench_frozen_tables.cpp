@@ -0,0 +1,71 @@
+// Benchmark: memoria y búsqueda de miembros en tablas de campos normales (SymbolTable)
+// contra las mismas tablas congeladas con hash perfecto.
+#include "../src/SymbolTable.hpp"
+#include <chrono>
+#include <cstdio>
+#include <malloc.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Bytes reservados en el heap, incluidos los bloques grandes que malloc pide con mmap
+    size_t heapInUse()
+    {
+        struct mallinfo2 info = mallinfo2();
+        return info.uordblks + info.hblkhd;
+    }
+
+    const int FIELDS = 8;
+
+    template <typename Table>
+    double lookupNs(const std::vector<Table> &tables, const std::vector<std::string> &names, long &found)
+    {
+        const int ROUNDS = 4000000 / (tables.size() * names.size()) + 1;
+        auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < ROUNDS; ++r)
+            for (const Table &table : tables)
+                for (const std::string &name : names)
+                    found += table.lookup(name) != nullptr;
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / (double(ROUNDS) * tables.size() * names.size());
+    }
+}
+
+// Mide con `structs` tablas: pocas caben en caché, muchas obligan a ir a memoria
+void run(int structs, const std::vector<std::string> &names)
+{
+    size_t before = heapInUse();
+    std::vector<SymbolTable> tables(structs);
+    for (SymbolTable &table : tables)
+        for (int f = 0; f < FIELDS; ++f)
+            table.insert({names[f], 0, Category::VAR, f * 4, {}});
+    size_t normalBytes = heapInUse() - before;
+
+    before = heapInUse();
+    std::vector<FrozenSymbolTable> frozen;
+    frozen.reserve(structs);
+    for (const SymbolTable &table : tables)
+        frozen.push_back(table.freeze());
+    size_t frozenBytes = heapInUse() - before;
+
+    long found = 0;
+    double normalNs = lookupNs(tables, names, found);
+    double frozenNs = lookupNs(frozen, names, found);
+
+    std::printf("%d estructuras x %d campos (%ld encontrados)\n", structs, FIELDS, found);
+    std::printf("  normal:    %9.1f KiB  %6.2f ns/búsqueda\n", normalBytes / 1024.0, normalNs);
+    std::printf("  congelada: %9.1f KiB  %6.2f ns/búsqueda\n", frozenBytes / 1024.0, frozenNs);
+}
+
+int main()
+{
+    std::vector<std::string> names;
+    for (int f = 0; f < FIELDS; ++f)
+        names.push_back("campo_" + std::to_string(f));
+
+    run(100, names);
+    run(20000, names);
+    return 0;
+}
@@ -0,0 +1,172 @@
+// Benchmark: caché de símbolos calientes de SymbolTableStack. Un flujo de búsquedas sesgado
+// (índices de ciclo, receptores y unos cuantos globales acaparan la mayoría) sobre una pila
+// profunda, sin caché y con distintos tamaños de caché, más la tasa de aciertos de cada uno.
+#include "../src/SymbolTableStack.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int GLOBALS = 2000;
+    const int BLOCKS = 4;        // Bloques anidados dentro de cada función
+    const int LOCALS = 20;       // Locales por bloque
+    const int FUNCTIONS = 400;   // Funciones por pasada
+    const int LOOKUPS = 200;     // Búsquedas por bloque
+    const int PASSES = 5;
+
+    // Ids calientes: declarados en la función o en el bloque más interno
+    const std::vector<std::string> HOT = {"i", "self", "n", "acc", "out"};
+
+    struct Workload
+    {
+        std::vector<std::string> globals;
+        std::vector<std::vector<std::string>> locals; // Por bloque
+        std::vector<std::string> stream;              // Búsquedas de un bloque interno
+    };
+
+    Workload makeWorkload()
+    {
+        Workload w;
+        for (int g = 0; g < GLOBALS; ++g)
+            w.globals.push_back("global_" + std::to_string(g));
+        w.locals.resize(BLOCKS);
+        for (int b = 0; b < BLOCKS; ++b)
+            for (int l = 0; l < LOCALS; ++l)
+                w.locals[b].push_back("b" + std::to_string(b) + "_local" + std::to_string(l));
+
+        // 60% ids calientes, 25% locales de los bloques, 10% unos pocos globales comunes
+        // y 5% cualquier global
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> pick(0, 99);
+        for (int k = 0; k < LOOKUPS; ++k)
+        {
+            int p = pick(rng);
+            if (p < 60)
+                w.stream.push_back(HOT[rng() % HOT.size()]);
+            else if (p < 85)
+                w.stream.push_back(w.locals[rng() % BLOCKS][rng() % LOCALS]);
+            else if (p < 95)
+                w.stream.push_back(w.globals[rng() % 8]);
+            else
+                w.stream.push_back(w.globals[rng() % GLOBALS]);
+        }
+        return w;
+    }
+
+    struct Result
+    {
+        double lookupNs = 0;
+        double hitRate = 0;
+        HotCacheStats stats;
+    };
+
+    // Pasadas completas: abrir funciones y bloques, declarar y buscar. Se toma la mejor.
+    Result run(const Workload &w, size_t slots, long &found)
+    {
+        Result result;
+        result.lookupNs = 1e30;
+        for (int pass = 0; pass < PASSES; ++pass)
+        {
+            SymbolTableStack stack;
+            stack.setHotCache(slots);
+            stack.pushScope();
+            for (const std::string &g : w.globals)
+                stack.insertBase({g, 1, Category::VAR, 0, {}});
+            stack.freezeBase();
+
+            long lookups = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (int f = 0; f < FUNCTIONS; ++f)
+            {
+                stack.pushScope();
+                for (size_t h = 1; h < HOT.size(); ++h)
+                    stack.insertTop({HOT[h], 1, Category::PARAM, 0, {}});
+                for (int b = 0; b < BLOCKS; ++b)
+                {
+                    stack.pushScope();
+                    for (const std::string &local : w.locals[b])
+                        stack.insertTop({local, 1, Category::VAR, 0, {}});
+                    if (b == BLOCKS - 1)
+                    {
+                        stack.insertTop({HOT[0], 1, Category::VAR, 0, {}});
+                        for (const std::string &id : w.stream)
+                            found += stack.find(id) != nullptr;
+                        lookups += w.stream.size();
+                    }
+                }
+                for (int b = 0; b <= BLOCKS; ++b)
+                    stack.popScope();
+            }
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            result.lookupNs = std::min(result.lookupNs, elapsed.count() / lookups);
+            result.stats = stack.hotCacheStats();
+            result.hitRate = result.stats.hitRate();
+        }
+        return result;
+    }
+
+    // Solo búsquedas: la pila queda armada una vez (bloque más interno abierto) y el flujo
+    // se repite. Es el caso de un cuerpo de ciclo largo.
+    double steadyNs(const Workload &w, size_t slots, long &found, double &hitRate)
+    {
+        SymbolTableStack stack;
+        stack.setHotCache(slots);
+        stack.pushScope();
+        for (const std::string &g : w.globals)
+            stack.insertBase({g, 1, Category::VAR, 0, {}});
+        stack.pushScope();
+        for (size_t h = 1; h < HOT.size(); ++h)
+            stack.insertTop({HOT[h], 1, Category::PARAM, 0, {}});
+        for (int b = 0; b < BLOCKS; ++b)
+        {
+            stack.pushScope();
+            for (const std::string &local : w.locals[b])
+                stack.insertTop({local, 1, Category::VAR, 0, {}});
+        }
+        stack.insertTop({HOT[0], 1, Category::VAR, 0, {}});
+
+        const int ROUNDS = 4000000 / w.stream.size();
+        double best = 1e30;
+        for (int pass = 0; pass < PASSES; ++pass)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (int r = 0; r < ROUNDS; ++r)
+                for (const std::string &id : w.stream)
+                    found += stack.find(id) != nullptr;
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count() / (double(ROUNDS) * w.stream.size()));
+        }
+        hitRate = stack.hotCacheStats().hitRate();
+        return best;
+    }
+}
+
+int main()
+{
+    Workload w = makeWorkload();
+    long found = 0;
+    std::printf("%d globales, %d bloques x %d locales, %d búsquedas por función\n",
+                GLOBALS, BLOCKS, LOCALS, LOOKUPS);
+    std::printf("(tiempo total de la pasada, declaraciones incluidas, entre búsquedas)\n");
+    Result base = run(w, 0, found);
+    std::printf("  sin caché:      %7.2f ns/búsqueda\n", base.lookupNs);
+    for (size_t slots : {16, 64, 256})
+    {
+        Result r = run(w, slots, found);
+        std::printf("  caché %4zu:     %7.2f ns/búsqueda  aciertos %5.1f%%  desalojos %zu  invalidaciones %zu\n",
+                    slots, r.lookupNs, 100.0 * r.hitRate, r.stats.evictions, r.stats.invalidations);
+    }
+    std::printf("solo búsquedas (pila armada, %d niveles)\n", BLOCKS + 2);
+    for (size_t slots : {0, 16, 64, 256})
+    {
+        double hitRate = 0;
+        double ns = steadyNs(w, slots, found, hitRate);
+        std::printf("  caché %4zu:     %7.2f ns/búsqueda  aciertos %5.1f%%\n", slots, ns, 100.0 * hitRate);
+    }
+    std::printf("(%ld encontrados)\n", found);
+    return 0;
+}
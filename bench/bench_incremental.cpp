@@ -0,0 +1,138 @@
+// Benchmark: latencia de edición a resultado en modo watch. Tras editar unas cuantas
+// declaraciones globales se compara volver a comprobar todo el programa contra
+// re-comprobar solo las funciones que dependen de lo editado (DependencyTracker).
+#include "../src/DependencyTracker.hpp"
+#include "../src/SymbolTableStack.hpp"
+#include "../src/TypeManager.hpp"
+#include "../src/TypeTable.hpp"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const int GLOBALS = 5000;
+    const int FUNCTIONS = 2000;
+    const int GLOBAL_READS = 20; // Globales distintos que lee cada función
+    const int LOCALS = 30;
+    const int STATEMENTS = 200;
+
+    struct Function
+    {
+        std::string name;
+        std::vector<std::string> globals;
+    };
+
+    std::vector<std::string> localNames;
+
+    // Comprueba el cuerpo de una función: declara locales y en cada sentencia busca dos
+    // operandos (locales o globales) y calcula el tipo del resultado
+    long checkFunction(const Function &f, SymbolTableStack &stack, const TypeManager &types)
+    {
+        long sum = 0;
+        ScopeGuard scope(stack);
+        for (int i = 0; i < LOCALS; ++i)
+            stack.insertTop({localNames[i], 2 + i % 4, Category::VAR, i * 8, {}});
+        for (int s = 0; s < STATEMENTS; ++s)
+        {
+            const std::string &a = (s % 3 == 0) ? f.globals[s % f.globals.size()] : localNames[s % LOCALS];
+            const std::string &b = localNames[(s * 7) % LOCALS];
+            SymbolEntry *ea = stack.lookup(a);
+            SymbolEntry *eb = stack.lookup(b);
+            if (ea && eb)
+                sum += types.max(ea->typeId, eb->typeId) + types.getTypeTable().getSize(ea->typeId);
+        }
+        return sum;
+    }
+
+    double msSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main()
+{
+    TypeTable table;
+    table.addBasicType("void", 0);
+    table.addBasicType("bool", 1);
+    table.addBasicType("char", 1);
+    table.addBasicType("int", 4);
+    table.addBasicType("float", 4);
+    table.addBasicType("double", 8);
+    TypeManager types(table);
+
+    for (int i = 0; i < LOCALS; ++i)
+        localNames.push_back("local" + std::to_string(i));
+
+    SymbolTableStack stack;
+    stack.pushScope();
+    for (int g = 0; g < GLOBALS; ++g)
+        stack.insertBase({"global" + std::to_string(g), 2 + g % 4, Category::VAR, g * 8, {}});
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pick(0, GLOBALS - 1);
+    std::vector<Function> functions(FUNCTIONS);
+    for (int i = 0; i < FUNCTIONS; ++i)
+    {
+        functions[i].name = "f" + std::to_string(i);
+        for (int r = 0; r < GLOBAL_READS; ++r)
+            functions[i].globals.push_back("global" + std::to_string(pick(rng)));
+    }
+
+    // Comprobación completa sin registro (referencia)
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const Function &f : functions)
+        sum += checkFunction(f, stack, types);
+    double plainMs = msSince(start);
+
+    // Comprobación completa inicial con registro de dependencias
+    DependencyTracker deps;
+    stack.attachDependencyTracker(&deps);
+    table.attachDependencyTracker(&deps);
+    std::unordered_map<std::string, const Function *> byName;
+    for (const Function &f : functions)
+        byName[f.name] = &f;
+    auto check = [&](const std::string &name)
+    { sum += checkFunction(*byName[name], stack, types); };
+
+    start = std::chrono::steady_clock::now();
+    for (const Function &f : functions)
+    {
+        deps.beginRegion(f.name);
+        check(f.name);
+        deps.endRegion();
+    }
+    double trackedMs = msSince(start);
+
+    // Edición: cambia el tipo de 3 globales
+    const int EDITS = 3;
+    std::vector<std::string> edited;
+    for (int e = 0; e < EDITS; ++e)
+    {
+        std::string id = "global" + std::to_string(pick(rng));
+        stack.lookupBase(id)->typeId = 5;
+        edited.push_back(id);
+    }
+
+    start = std::chrono::steady_clock::now();
+    for (const Function &f : functions)
+        sum += checkFunction(f, stack, types);
+    double fullMs = msSince(start);
+
+    start = std::chrono::steady_clock::now();
+    deps.invalidate(edited, {});
+    size_t rechecked = deps.recheck(check);
+    double incrementalMs = msSince(start);
+
+    std::printf("%d funciones, %d globales, %d editados\n", FUNCTIONS, GLOBALS, EDITS);
+    std::printf("comprobación completa sin registro: %8.2f ms\n", plainMs);
+    std::printf("comprobación completa con registro: %8.2f ms\n", trackedMs);
+    std::printf("edición -> resultado, todo:         %8.2f ms\n", fullMs);
+    std::printf("edición -> resultado, incremental:  %8.3f ms (%zu funciones)\n", incrementalMs, rechecked);
+    std::printf("(checksum %ld)\n", sum);
+    return 0;
+}
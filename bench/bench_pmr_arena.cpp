@@ -0,0 +1,133 @@
+// Benchmark: sesiones de compilación completas (tabla de tipos, global y ámbitos de
+// funciones) con el heap por defecto contra una arena monotónica por sesión que se
+// libera de una vez. También cuenta las reservas que siguen yendo al heap global con
+// cada recurso (los bloques que pide el propio recurso y los temporales de cada llamada).
+#include "../src/SymbolTableStack.hpp"
+#include "../src/TypeTable.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+// Reservas con el operator new global (un solo hilo: basta un contador simple)
+static size_t globalNews = 0;
+
+void *operator new(size_t size)
+{
+    ++globalNews;
+    if (void *p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+// new_delete_resource (el recurso por omisión) reserva con la versión alineada
+void *operator new(size_t size, std::align_val_t align)
+{
+    ++globalNews;
+    size_t alignment = static_cast<size_t>(align);
+    if (void *p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace
+{
+    const int SESSIONS = 50;
+    const int GLOBALS = 5000;
+    const int FUNCTIONS = 300;
+    const int LOCALS = 30;
+
+    std::vector<std::string> globalNames, localNames;
+
+    // Una sesión: todo se crea y se destruye dentro
+    long runSession(std::pmr::memory_resource *resource)
+    {
+        long sum = 0;
+        TypeTable tt(resource);
+        int tInt = tt.addBasicType("int", 4);
+        tt.addBasicType("float", 4);
+        for (int i = 1; i <= 500; ++i)
+            tt.addArrayType(tInt, i);
+
+        SymbolTableStack stack(resource);
+        stack.pushScope();
+        for (int g = 0; g < GLOBALS; ++g)
+            stack.insertBase({globalNames[g], tInt, Category::VAR, g * 4, {}});
+        for (int f = 0; f < FUNCTIONS; ++f)
+        {
+            ScopeGuard scope(stack);
+            for (int l = 0; l < LOCALS; ++l)
+                stack.insertTop({localNames[l], tInt, Category::VAR, l * 4, {}});
+            sum += stack.find(globalNames[(f * 13) % GLOBALS])->address;
+        }
+        return sum + tt.count();
+    }
+
+    double msSince(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main()
+{
+    for (int g = 0; g < GLOBALS; ++g)
+        globalNames.push_back("g" + std::to_string(g));
+    for (int l = 0; l < LOCALS; ++l)
+        localNames.push_back("l" + std::to_string(l));
+
+    long sum = 0;
+    runSession(std::pmr::get_default_resource()); // calentamiento
+
+    size_t news = globalNews;
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < SESSIONS; ++s)
+        sum += runSession(std::pmr::get_default_resource());
+    double heapMs = msSince(start);
+    size_t heapNews = globalNews - news;
+
+    // Un búfer inicial que se reutiliza entre sesiones: release() lo deja listo otra vez
+    // Las reservas que el recurso pide al heap (bloques de la arena o del pool) también
+    // pasan por el operator new global; son pocas y grandes
+    std::vector<char> initial(1 << 20);
+    news = globalNews;
+    start = std::chrono::steady_clock::now();
+    for (int s = 0; s < SESSIONS; ++s)
+    {
+        std::pmr::monotonic_buffer_resource arena(initial.data(), initial.size());
+        sum += runSession(&arena);
+    }
+    double arenaMs = msSince(start);
+    size_t arenaNews = globalNews - news;
+
+    news = globalNews;
+    start = std::chrono::steady_clock::now();
+    for (int s = 0; s < SESSIONS; ++s)
+    {
+        std::pmr::unsynchronized_pool_resource pool;
+        sum += runSession(&pool);
+    }
+    double poolMs = msSince(start);
+    size_t poolNews = globalNews - news;
+
+    std::printf("%d sesiones (%d globales, %d funciones x %d locales)\n", SESSIONS, GLOBALS, FUNCTIONS, LOCALS);
+    std::printf("heap por defecto:           %8.1f ms (%.3f ms/sesión)  %8zu new globales/sesión\n",
+                heapMs, heapMs / SESSIONS, heapNews / SESSIONS);
+    std::printf("monotonic_buffer_resource:  %8.1f ms (%.3f ms/sesión)  %8zu new globales/sesión\n",
+                arenaMs, arenaMs / SESSIONS, arenaNews / SESSIONS);
+    std::printf("unsynchronized_pool:        %8.1f ms (%.3f ms/sesión)  %8zu new globales/sesión\n",
+                poolMs, poolMs / SESSIONS, poolNews / SESSIONS);
+    std::printf("(con recurso, las reservas globales que quedan son los bloques que pide el propio\n"
+                " recurso y temporales que se liberan en la misma llamada, como las entradas que se\n"
+                " pasan a insert)\n");
+    std::printf("(checksum %ld)\n", sum);
+    return 0;
+}
@@ -0,0 +1,77 @@
+// Benchmark: acceso a la tabla de tipos desde rutas calientes. Getters con validación
+// (getName copia el nombre) contra getNameView, los accesores sin validación y TypeRef;
+// y TypeManager::max + isValidConversion, que leen los tipos por TypeRef.
+#include "../src/TypeManager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    const int N = 2000000;
+    const int RUNS = 5;
+
+    // Mejor de RUNS corridas, en ns por iteración
+    template <typename Fn>
+    double bestNs(Fn fn, long &sum)
+    {
+        double best = 1e18;
+        for (int r = 0; r < RUNS; ++r)
+        {
+            auto start = std::chrono::steady_clock::now();
+            sum += fn();
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = std::min(best, ns / N);
+        }
+        return best;
+    }
+}
+
+int main()
+{
+    TypeTable tt;
+    tt.addBasicType("void", 0);
+    tt.addBasicType("bool", 1);
+    std::vector<int> ids = {tt.addBasicType("char", 1), tt.addBasicType("int", 4), tt.addBasicType("float", 4),
+                            tt.addBasicType("double", 8)};
+    ids.push_back(tt.addArrayType(ids[3], 100)); // "double[100]": no cabe en SSO
+    ids.push_back(tt.addArrayType(ids[4], 16));
+    size_t mask = 7;
+    while (ids.size() <= mask)
+        ids.push_back(ids[ids.size() % 6]);
+
+    std::vector<TypeRef> refs;
+    for (int id : ids)
+        refs.push_back(tt.ref(id));
+
+    long sum = 0;
+    double checked = bestNs([&]
+                            { long s = 0; for (int k = 0; k < N; ++k) s += tt.getName(ids[k & mask]).size() + tt.getSize(ids[k & mask]); return s; }, sum);
+    double view = bestNs([&]
+                         { long s = 0; for (int k = 0; k < N; ++k) s += tt.getNameView(ids[k & mask]).size() + tt.getSize(ids[k & mask]); return s; }, sum);
+    double unchecked = bestNs([&]
+                              { long s = 0; for (int k = 0; k < N; ++k) s += tt.nameUnchecked(ids[k & mask]).size() + tt.sizeUnchecked(ids[k & mask]); return s; }, sum);
+    double ref = bestNs([&]
+                        { long s = 0; for (int k = 0; k < N; ++k) s += refs[k & mask].name().size() + refs[k & mask].size(); return s; }, sum);
+
+    TypeManager manager(tt);
+    double scalar = bestNs([&]
+                           {
+                               long s = 0;
+                               for (int k = 0; k < N; ++k)
+                               {
+                                   int t1 = ids[k & 3], t2 = ids[(k >> 2) & 3];
+                                   s += manager.max(t1, t2) + manager.isValidConversion(t1, t2, true);
+                               }
+                               return s; }, sum);
+
+    std::printf("nombre + tamaño por tipo (%d accesos, mejor de %d)\n", N, RUNS);
+    std::printf("getName + getSize:             %6.1f ns\n", checked);
+    std::printf("getNameView + getSize:         %6.1f ns\n", view);
+    std::printf("nameUnchecked + sizeUnchecked: %6.1f ns\n", unchecked);
+    std::printf("TypeRef name + size:           %6.1f ns\n", ref);
+    std::printf("TypeManager max + isValidConversion: %6.1f ns\n", scalar);
+    std::printf("(checksum %ld)\n", sum);
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Benchmark: memoria y velocidad de consulta de la TypeTable compacta con 1M de tipos,
+// comparada con el arreglo de entradas completas que se usaba antes (nombre std::string
+// y campos de arreglo/estructura en cada entrada).
+#include "../src/TypeTable.hpp"
+#include <chrono>
+#include <cstdio>
+#include <malloc.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Entrada con el layout anterior
+    struct LegacyTypeEntry
+    {
+        int id;
+        TypeKind kind;
+        std::string name;
+        int size;
+        int elements;
+        int baseTypeId;
+        SymbolTable *structFields;
+    };
+
+    // Bytes reservados en el heap, incluidos los bloques grandes que malloc pide con mmap
+    size_t heapInUse()
+    {
+        struct mallinfo2 info = mallinfo2();
+        return info.uordblks + info.hblkhd;
+    }
+
+    const int TYPES = 1000000;
+
+    // Así eran los getters anteriores: fuera de línea, pasando por get() con validación
+    __attribute__((noinline)) const LegacyTypeEntry &legacyGet(const std::vector<LegacyTypeEntry> &types, int id)
+    {
+        if (id < 0 || id >= static_cast<int>(types.size()))
+            throw std::out_of_range("ID de tipo fuera de rango");
+        return types[id];
+    }
+}
+
+int main()
+{
+    // Mezcla realista: unos cuantos básicos, muchos arreglos (que repiten tamaños, como
+    // int[16] declarado en muchos lugares) y algunas estructuras
+    size_t before = heapInUse();
+    std::vector<LegacyTypeEntry> legacy;
+    for (int i = 0; i < TYPES; ++i)
+    {
+        if (i < 6)
+            legacy.push_back({i, TypeKind::BASIC, "basic" + std::to_string(i), 4, 0, -1, nullptr});
+        else if (i % 10 == 0)
+            legacy.push_back({i, TypeKind::STRUCT, "Estructura" + std::to_string(i), 16, 0, -1, nullptr});
+        else
+            legacy.push_back({i, TypeKind::ARRAY, legacy[i % 6].name + "[" + std::to_string(1 + i % 1000) + "]",
+                              4 * (1 + i % 1000), 1 + i % 1000, i % 6, nullptr});
+    }
+    size_t legacyBytes = heapInUse() - before;
+
+    before = heapInUse();
+    TypeTable table;
+    for (int i = 0; i < TYPES; ++i)
+    {
+        if (i < 6)
+            table.addBasicType("basic" + std::to_string(i), 4);
+        else if (i % 10 == 0)
+            table.addStructType("Estructura" + std::to_string(i), 16, nullptr);
+        else
+            table.addArrayType(i % 6, 1 + i % 1000);
+    }
+    size_t compactBytes = heapInUse() - before;
+
+    // Consultas aleatorias de tamaño y tipo base, como las de TypeManager/FrameAllocator
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(0, TYPES - 1);
+    std::vector<int> ids(4000000);
+    for (int &id : ids)
+        id = dist(rng);
+
+    long long checksum = 0;
+    auto time = [&](auto query)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int id : ids)
+            checksum += query(id);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    double legacySize = time([&](int id) { return legacyGet(legacy, id).size; });
+    double compactSize = time([&](int id) { return table.getSize(id); });
+    double legacyBase = time([&](int id) { return legacyGet(legacy, id).baseTypeId; });
+    double compactBase = time([&](int id) { return table.getBaseType(id); });
+
+    std::printf("%d tipos (nota: la tabla compacta incluye además los IDs canónicos)\n", TYPES);
+    std::printf("%-10s %12s %16s %18s\n", "layout", "memoria (MB)", "4M getSize (ms)", "4M getBaseType (ms)");
+    std::printf("%-10s %12.1f %16.2f %18.2f\n", "anterior", legacyBytes / 1048576.0, legacySize, legacyBase);
+    std::printf("%-10s %12.1f %16.2f %18.2f\n", "compacto", compactBytes / 1048576.0, compactSize, compactBase);
+    std::printf("checksum %lld\n", checksum);
+    return 0;
+}
@@ -0,0 +1,510 @@
+#pragma once
+#include "../src/ConcurrentSymbolTable.hpp"
+#include "../src/SymbolTable.hpp"
+#include "../src/SymbolTableStack.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Pruebas diferenciales de las tablas de símbolos.
+ *
+ * Una secuencia de operaciones (decodificada de bytes arbitrarios, como los que da
+ * libFuzzer) se ejecuta en una implementación de referencia, deliberadamente simple
+ * (std::map por ámbito), y en cada backend optimizado. Cualquier diferencia en el
+ * resultado de una operación es un error del backend. Cada backend se ejecuta completo y se
+ * cronometra, para comparar tiempos contra la referencia.
+ *
+ * La referencia fija la semántica de hoy:
+ * - insert de un id repetido regresa false y no cambia la entrada
+ * - insertTop/insertBase con la pila vacía fallan; insertBase también con la base congelada
+ * - lookupTop sin ámbitos locales ve el global congelado; popScope nunca lo saca
+ */
+namespace differential
+{
+    enum class Op : uint8_t
+    {
+        PUSH,
+        POP,
+        INSERT_TOP,
+        INSERT_BASE,
+        LOOKUP_TOP,
+        LOOKUP_BASE,
+        LOOKUP,
+        VISIBLE,     // Huella de las vinculaciones visibles
+        FREEZE_BASE, // Solo pila
+        BLOOM,       // Activa/desactiva filtros de Bloom (no cambia resultados)
+        CLEAR,       // Solo tablas sueltas
+        FREEZE,      // Solo tablas sueltas: compara la copia congelada
+        COUNT
+    };
+
+    struct Step
+    {
+        Op op;
+        uint8_t name;  // Índice en el repertorio de ids
+        uint8_t value; // Tipo, dirección y categoría de la entrada
+    };
+
+    // Pocos ids, para que repeticiones y ocultamientos sean frecuentes; algunos largos para
+    // salir del SSO de std::string
+    inline const std::vector<std::string> &names()
+    {
+        static const std::vector<std::string> pool = []
+        {
+            std::vector<std::string> ids;
+            for (int i = 0; i < 40; ++i)
+                ids.push_back((i % 5 == 4 ? "identificador_largo_numero_" : "v") + std::to_string(i));
+            return ids;
+        }();
+        return pool;
+    }
+
+    inline SymbolEntry entryOf(const Step &step)
+    {
+        return {names()[step.name], step.value % 7, static_cast<Category>(step.value % 5), step.value * 4,
+                step.value % 3 == 0 ? std::vector<int>{step.value % 4} : std::vector<int>{}};
+    }
+
+    // 3 bytes por operación; lo que sobre al final se ignora
+    inline std::vector<Step> decode(const uint8_t *data, size_t size)
+    {
+        std::vector<Step> steps;
+        for (size_t i = 0; i + 3 <= size; i += 3)
+        {
+            steps.push_back({static_cast<Op>(data[i] % static_cast<uint8_t>(Op::COUNT)),
+                             static_cast<uint8_t>(data[i + 1] % names().size()), data[i + 2]});
+        }
+        return steps;
+    }
+
+    // Resultado observable de una operación
+    struct Outcome
+    {
+        bool ok = false;   // insert: insertado; lookup: encontrado
+        SymbolEntry entry{}; // Lo encontrado
+        Fingerprint print; // VISIBLE y FREEZE
+        size_t size = 0;   // Niveles de la pila o tamaño de la tabla
+
+        bool operator==(const Outcome &other) const
+        {
+            return ok == other.ok && size == other.size && print == other.print && entry.id == other.entry.id &&
+                   entry.typeId == other.entry.typeId && entry.category == other.entry.category &&
+                   entry.address == other.entry.address && entry.params == other.entry.params;
+        }
+        bool operator!=(const Outcome &other) const { return !(*this == other); }
+    };
+
+    inline Outcome found(const SymbolEntry *entry, size_t size)
+    {
+        Outcome outcome;
+        outcome.size = size;
+        if (entry)
+        {
+            outcome.ok = true;
+            outcome.entry = *entry;
+        }
+        return outcome;
+    }
+
+    inline Fingerprint bindingPrint(const SymbolEntry &entry, size_t depth)
+    {
+        return FingerprintBuilder().add(entryFingerprint(entry)).add(static_cast<uint64_t>(depth)).result();
+    }
+
+    // -----------------------------------------
+    // Backends
+    // -----------------------------------------
+    // Una implementación a comparar: ejecuta un paso y regresa lo observable
+    class Backend
+    {
+    public:
+        virtual ~Backend() = default;
+        virtual const char *name() const = 0;
+        virtual Outcome apply(const Step &step) = 0;
+    };
+
+    // Referencia de la pila: un std::map por ámbito, la base en scopes[0]
+    class ReferenceStack : public Backend
+    {
+    private:
+        std::vector<std::map<std::string, SymbolEntry>> scopes;
+        bool frozen = false;
+
+        size_t locals() const { return scopes.size() - (frozen ? 1 : 0); }
+
+    public:
+        const char *name() const override { return "referencia"; }
+
+        Outcome apply(const Step &step) override
+        {
+            const std::string &id = names()[step.name];
+            Outcome outcome;
+            switch (step.op)
+            {
+            case Op::PUSH:
+                scopes.emplace_back();
+                break;
+            case Op::POP:
+                if (locals() > 0)
+                    scopes.pop_back();
+                break;
+            case Op::INSERT_TOP:
+                outcome.ok = locals() > 0 && scopes.back().emplace(id, entryOf(step)).second;
+                break;
+            case Op::INSERT_BASE:
+                outcome.ok = !scopes.empty() && !frozen && scopes.front().emplace(id, entryOf(step)).second;
+                break;
+            case Op::LOOKUP_TOP:
+            case Op::LOOKUP_BASE:
+            {
+                if (scopes.empty())
+                    break;
+                auto &scope = step.op == Op::LOOKUP_TOP ? scopes.back() : scopes.front();
+                auto it = scope.find(id);
+                outcome = found(it == scope.end() ? nullptr : &it->second, 0);
+                break;
+            }
+            case Op::LOOKUP:
+                for (auto scope = scopes.rbegin(); scope != scopes.rend(); ++scope)
+                {
+                    auto it = scope->find(id);
+                    if (it != scope->end())
+                    {
+                        outcome = found(&it->second, 0);
+                        break;
+                    }
+                }
+                break;
+            case Op::VISIBLE:
+            {
+                std::map<std::string, bool> seen;
+                for (size_t depth = 0; depth < scopes.size(); ++depth)
+                {
+                    for (const auto &pair : scopes[scopes.size() - 1 - depth])
+                    {
+                        if (seen.emplace(pair.first, true).second)
+                            outcome.print += bindingPrint(pair.second, depth);
+                    }
+                }
+                break;
+            }
+            case Op::FREEZE_BASE:
+                frozen = frozen || !scopes.empty();
+                break;
+            default:
+                break;
+            }
+            outcome.size += scopes.size();
+            return outcome;
+        }
+    };
+
+    // Una variante de SymbolTableStack
+    class StackBackend : public Backend
+    {
+    private:
+        const char *label;
+        std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+        SymbolTableStack stack;
+        bool bloomToggle;
+
+    public:
+        // arena: tablas en un monotonic_buffer_resource; bloom: filtros activos desde el
+        // inicio; reserve: tablas recicladas listas; toggles: BLOOM alterna los filtros;
+        // hotSlots: ranuras de la caché de símbolos calientes (0 = sin caché)
+        StackBackend(const char *name, bool useArena, bool bloom, size_t reserve, bool toggles, size_t hotSlots = 0)
+            : label(name), arena(useArena ? std::make_unique<std::pmr::monotonic_buffer_resource>() : nullptr),
+              stack(arena ? static_cast<std::pmr::memory_resource *>(arena.get()) : std::pmr::get_default_resource()),
+              bloomToggle(toggles)
+        {
+            stack.setBloomFilters(bloom);
+            stack.reserveScopes(reserve);
+            stack.setHotCache(hotSlots);
+        }
+
+        const char *name() const override { return label; }
+
+        Outcome apply(const Step &step) override
+        {
+            const std::string &id = names()[step.name];
+            Outcome outcome;
+            switch (step.op)
+            {
+            case Op::PUSH:
+                stack.pushScope();
+                break;
+            case Op::POP:
+                stack.popScope();
+                break;
+            case Op::INSERT_TOP:
+                outcome.ok = stack.insertTop(entryOf(step));
+                break;
+            case Op::INSERT_BASE:
+                outcome.ok = stack.insertBase(entryOf(step));
+                break;
+            case Op::LOOKUP_TOP:
+                outcome = found(stack.findTop(id), 0);
+                break;
+            case Op::LOOKUP_BASE:
+                outcome = found(stack.findBase(id), 0);
+                break;
+            case Op::LOOKUP:
+                outcome = found(stack.find(id), 0);
+                break;
+            case Op::VISIBLE:
+            {
+                VisibleSymbols view = stack.visible();
+                for (auto it = view.begin(); it != view.end(); ++it)
+                    outcome.print += bindingPrint(*it, it.depth());
+                break;
+            }
+            case Op::FREEZE_BASE:
+                stack.freezeBase();
+                break;
+            case Op::BLOOM:
+                if (bloomToggle)
+                    stack.setBloomFilters(!stack.bloomFiltersEnabled());
+                break;
+            default:
+                break;
+            }
+            outcome.size += stack.levels();
+            return outcome;
+        }
+    };
+
+    // Referencia de una tabla suelta
+    class ReferenceTable : public Backend
+    {
+    private:
+        std::map<std::string, SymbolEntry> entries;
+
+    public:
+        const char *name() const override { return "referencia"; }
+
+        Outcome apply(const Step &step) override
+        {
+            const std::string &id = names()[step.name];
+            Outcome outcome;
+            switch (step.op)
+            {
+            case Op::INSERT_TOP:
+            case Op::INSERT_BASE:
+                outcome.ok = entries.emplace(id, entryOf(step)).second;
+                break;
+            case Op::LOOKUP_TOP:
+            case Op::LOOKUP_BASE:
+            case Op::LOOKUP:
+            {
+                auto it = entries.find(id);
+                outcome = found(it == entries.end() ? nullptr : &it->second, 0);
+                break;
+            }
+            case Op::VISIBLE:
+            case Op::FREEZE:
+                // Las huellas no dependen del almacenamiento: la referencia usa la de SymbolTable
+                for (const auto &pair : entries)
+                    outcome.print += bindingPrint(pair.second, 0);
+                break;
+            case Op::CLEAR:
+                entries.clear();
+                break;
+            default:
+                break;
+            }
+            outcome.size = entries.size();
+            return outcome;
+        }
+    };
+
+    // Una combinación de BasicSymbolTable (o cualquier tabla con la misma interfaz)
+    template <typename Table>
+    class TableBackend : public Backend
+    {
+    private:
+        const char *label;
+        std::unique_ptr<Table> table = std::make_unique<Table>();
+        bool bloomToggle;
+
+        // VISIBLE y FREEZE comparan todas las entradas; FREEZE lo hace sobre la copia
+        // congelada (hash perfecto), que además debe conservar la huella de la tabla
+        template <typename Source>
+        static Fingerprint allBindings(const Source &source)
+        {
+            Fingerprint print;
+            for (const std::string &id : names())
+            {
+                if (const SymbolEntry *entry = source.lookup(id))
+                    print += bindingPrint(*entry, 0);
+            }
+            return print;
+        }
+
+    public:
+        TableBackend(const char *name, bool toggles) : label(name), bloomToggle(toggles) {}
+
+        const char *name() const override { return label; }
+
+        Outcome apply(const Step &step) override
+        {
+            const std::string &id = names()[step.name];
+            Outcome outcome;
+            switch (step.op)
+            {
+            case Op::INSERT_TOP:
+            case Op::INSERT_BASE:
+                outcome.ok = table->insert(entryOf(step));
+                break;
+            case Op::LOOKUP_TOP:
+            case Op::LOOKUP_BASE:
+            case Op::LOOKUP:
+                outcome = found(table->lookup(id), 0);
+                break;
+            case Op::VISIBLE:
+                outcome.print = allBindings(*table);
+                break;
+            case Op::FREEZE:
+                if constexpr (!std::is_same_v<Table, ConcurrentSymbolTable>)
+                {
+                    auto frozen = table->freeze();
+                    outcome.print = allBindings(frozen);
+                    if (frozen.fingerprint() != table->fingerprint() || frozen.size() != table->size())
+                        outcome.print = Fingerprint(); // Obliga a reportar la diferencia
+                }
+                else
+                {
+                    outcome.print = allBindings(*table->freeze());
+                }
+                break;
+            case Op::CLEAR:
+                if constexpr (std::is_same_v<Table, ConcurrentSymbolTable>)
+                    table = std::make_unique<Table>();
+                else
+                    table->clear();
+                break;
+            case Op::BLOOM:
+                if constexpr (!std::is_same_v<Table, ConcurrentSymbolTable>)
+                {
+                    if (bloomToggle)
+                        table->enableBloomFilter(!table->hasBloomFilter());
+                }
+                break;
+            default:
+                break;
+            }
+            outcome.size = table->size();
+            return outcome;
+        }
+    };
+
+    // -----------------------------------------
+    // Ejecución
+    // -----------------------------------------
+    struct Timing
+    {
+        std::string backend;
+        double ns;
+    };
+
+    struct Report
+    {
+        std::string mismatch; // Vacío si todos coinciden con la referencia
+        std::vector<Timing> timings; // El primero es la referencia
+    };
+
+    inline std::string describe(const Step &step, size_t index)
+    {
+        static const char *ops[] = {"PUSH", "POP", "INSERT_TOP", "INSERT_BASE", "LOOKUP_TOP", "LOOKUP_BASE",
+                                    "LOOKUP", "VISIBLE", "FREEZE_BASE", "BLOOM", "CLEAR", "FREEZE"};
+        return "paso " + std::to_string(index) + " (" + ops[static_cast<int>(step.op)] + " " + names()[step.name] +
+               ", valor " + std::to_string(step.value) + ")";
+    }
+
+    inline std::vector<Outcome> replay(Backend &backend, const std::vector<Step> &steps, double &ns)
+    {
+        std::vector<Outcome> outcomes;
+        outcomes.reserve(steps.size());
+        auto start = std::chrono::steady_clock::now();
+        for (const Step &step : steps)
+            outcomes.push_back(backend.apply(step));
+        ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        return outcomes;
+    }
+
+    // Ejecuta los pasos en la referencia y en cada backend; reporta la primera diferencia
+    inline Report compare(Backend &reference, const std::vector<std::unique_ptr<Backend>> &backends,
+                          const std::vector<Step> &steps)
+    {
+        Report report;
+        double ns = 0;
+        std::vector<Outcome> expected = replay(reference, steps, ns);
+        report.timings.push_back({reference.name(), ns});
+
+        for (const auto &backend : backends)
+        {
+            std::vector<Outcome> actual = replay(*backend, steps, ns);
+            report.timings.push_back({backend->name(), ns});
+            for (size_t i = 0; i < steps.size() && report.mismatch.empty(); ++i)
+            {
+                if (actual[i] != expected[i])
+                {
+                    report.mismatch = std::string(backend->name()) + " difiere de la referencia en " + describe(steps[i], i) +
+                                      ": ok " + std::to_string(actual[i].ok) + " vs " + std::to_string(expected[i].ok) +
+                                      ", niveles/tamaño " + std::to_string(actual[i].size) + " vs " +
+                                      std::to_string(expected[i].size);
+                }
+            }
+        }
+        return report;
+    }
+
+    // Las variantes de SymbolTableStack que se comparan
+    inline std::vector<std::unique_ptr<Backend>> stackBackends()
+    {
+        std::vector<std::unique_ptr<Backend>> backends;
+        backends.push_back(std::make_unique<StackBackend>("pila", false, false, 0, false));
+        backends.push_back(std::make_unique<StackBackend>("pila+bloom", false, true, 0, true));
+        backends.push_back(std::make_unique<StackBackend>("pila+arena", true, false, 4, false));
+        // Pocas ranuras para forzar desalojos entre los 40 ids
+        backends.push_back(std::make_unique<StackBackend>("pila+caché", false, true, 2, true, 8));
+        return backends;
+    }
+
+    // Las combinaciones de tabla que se comparan
+    inline std::vector<std::unique_ptr<Backend>> tableBackends()
+    {
+        std::vector<std::unique_ptr<Backend>> backends;
+        backends.push_back(std::make_unique<TableBackend<SymbolTable>>("chunked/wyhash", true));
+        backends.push_back(std::make_unique<TableBackend<BasicSymbolTable<std::string, SymbolEntry, StdHash, NodeMapStorage>>>(
+            "nodemap/std", false));
+        backends.push_back(std::make_unique<TableBackend<BasicSymbolTable<std::string, SymbolEntry, FnvHash, FlatMapStorage>>>(
+            "flatmap/fnv", true));
+        backends.push_back(
+            std::make_unique<TableBackend<BasicSymbolTable<std::string, SymbolEntry, WyHash, SortedVectorStorage>>>(
+                "sorted/wyhash", false));
+        backends.push_back(std::make_unique<TableBackend<ConcurrentSymbolTable>>("concurrente", false));
+        return backends;
+    }
+
+    // Un caso completo: los mismos pasos en las pilas y en las tablas sueltas
+    inline Report run(const std::vector<Step> &steps)
+    {
+        ReferenceStack stackReference;
+        Report report = compare(stackReference, stackBackends(), steps);
+        if (!report.mismatch.empty())
+            return report;
+
+        ReferenceTable tableReference;
+        Report tables = compare(tableReference, tableBackends(), steps);
+        report.mismatch = tables.mismatch;
+        report.timings.insert(report.timings.end(), tables.timings.begin(), tables.timings.end());
+        return report;
+    }
+}
@@ -0,0 +1,115 @@
+// Pruebas diferenciales de SymbolTable/SymbolTableStack contra la implementación de
+// referencia (ver SymbolTableDifferential.hpp).
+//
+// Independiente (make fuzz, con AddressSanitizer y UBSan):
+//     build/fuzz/fuzz_symbol_tables [iteraciones] [semilla]
+//     build/fuzz/fuzz_symbol_tables caso.bin ...   # reproduce casos guardados
+// Con libFuzzer (clang):
+//     clang++ -std=c++17 -DUSE_LIBFUZZER -g -O1 -fsanitize=fuzzer,address,undefined -Isrc
+//         fuzz/fuzz_symbol_tables.cpp src/*.cpp -pthread -o fuzz_symbol_tables
+#include "SymbolTableDifferential.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef USE_LIBFUZZER
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    differential::Report report = differential::run(differential::decode(data, size));
+    if (!report.mismatch.empty())
+    {
+        std::fprintf(stderr, "%s\n", report.mismatch.c_str());
+        std::abort();
+    }
+    return 0;
+}
+
+#else
+
+namespace
+{
+    std::vector<double> totals;
+    std::vector<std::string> labels;
+    size_t totalSteps = 0;
+
+    // Regresa false (y lo reporta) si algún backend difiere
+    bool check(const std::vector<uint8_t> &bytes, const std::string &origin)
+    {
+        std::vector<differential::Step> steps = differential::decode(bytes.data(), bytes.size());
+        differential::Report report = differential::run(steps);
+        if (!report.mismatch.empty())
+        {
+            std::printf("DIFERENCIA (%s): %s\n", origin.c_str(), report.mismatch.c_str());
+            return false;
+        }
+        totals.resize(report.timings.size());
+        labels.resize(report.timings.size());
+        for (size_t i = 0; i < report.timings.size(); ++i)
+        {
+            labels[i] = report.timings[i].backend;
+            totals[i] += report.timings[i].ns;
+        }
+        totalSteps += steps.size();
+        return true;
+    }
+
+    void printTimings()
+    {
+        std::printf("%zu pasos por backend\n", totalSteps);
+        for (size_t i = 0; i < totals.size(); ++i)
+        {
+            // La referencia de cada grupo (pilas, tablas) es la que se ejecutó justo antes
+            bool reference = labels[i] == "referencia";
+            size_t base = i;
+            while (labels[base] != "referencia")
+                --base;
+            std::printf("  %-16s %8.1f ns/paso%s\n", labels[i].c_str(), totals[i] / totalSteps,
+                        reference ? "" : (" (" + std::to_string(totals[i] / totals[base]).substr(0, 4) + "x)").c_str());
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // Archivos: reproducir casos
+    if (argc > 1 && std::ifstream(argv[1]).good())
+    {
+        bool ok = true;
+        for (int i = 1; i < argc; ++i)
+        {
+            std::ifstream file(argv[i], std::ios::binary);
+            std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            ok = check(bytes, argv[i]) && ok;
+        }
+        return ok ? 0 : 1;
+    }
+
+    long iterations = argc > 1 ? std::atol(argv[1]) : 2000;
+    uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 12345;
+    std::mt19937_64 random(seed);
+
+    for (long i = 0; i < iterations; ++i)
+    {
+        std::vector<uint8_t> bytes(3 * (random() % 400));
+        for (uint8_t &byte : bytes)
+            byte = static_cast<uint8_t>(random());
+
+        if (!check(bytes, "iteración " + std::to_string(i)))
+        {
+            std::string path = "diferencia-" + std::to_string(seed) + "-" + std::to_string(i) + ".bin";
+            std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+            std::printf("Caso guardado en %s\n", path.c_str());
+            return 1;
+        }
+    }
+    std::printf("%ld secuencias sin diferencias (semilla %llu)\n", iterations, static_cast<unsigned long long>(seed));
+    printTimings();
+    return 0;
+}
+
+#endif
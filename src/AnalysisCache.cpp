@@ -0,0 +1,98 @@
+#include "AnalysisCache.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace
+{
+    const char MAGIC[8] = {'S', 'E', 'M', 'C', 'A', 'C', 'H', 'E'};
+    const uint64_t VERSION = 1;
+
+    void putU64(std::string &out, uint64_t value)
+    {
+        for (int i = 0; i < 8; ++i)
+            out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+
+    // Lee un entero en `pos`; false si el búfer se acaba
+    bool getU64(const std::string &in, size_t &pos, uint64_t &value)
+    {
+        if (in.size() - pos < 8)
+            return false;
+        value = 0;
+        for (int i = 0; i < 8; ++i)
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(in[pos + i])) << (8 * i);
+        pos += 8;
+        return true;
+    }
+}
+
+bool AnalysisCache::load(const std::string &path)
+{
+    entries.clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t pos = sizeof(MAGIC);
+    uint64_t version, count;
+    if (data.size() < pos || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0 ||
+        !getU64(data, pos, version) || version != VERSION || !getU64(data, pos, count))
+        return false;
+
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        Fingerprint key;
+        uint64_t length;
+        if (!getU64(data, pos, key.lo) || !getU64(data, pos, key.hi) || !getU64(data, pos, length) ||
+            data.size() - pos < length)
+        {
+            entries.clear();
+            return false;
+        }
+        entries.emplace(key, data.substr(pos, length));
+        pos += length;
+    }
+    if (pos != data.size())
+    {
+        entries.clear();
+        return false;
+    }
+    return true;
+}
+
+void AnalysisCache::save(const std::string &path) const
+{
+    size_t bytes = sizeof(MAGIC) + 16;
+    for (const auto &entry : entries)
+        bytes += 24 + entry.second.size();
+
+    std::string data;
+    data.reserve(bytes);
+    data.append(MAGIC, sizeof(MAGIC));
+    putU64(data, VERSION);
+    putU64(data, entries.size());
+    for (const auto &entry : entries)
+    {
+        putU64(data, entry.first.lo);
+        putU64(data, entry.first.hi);
+        putU64(data, entry.second.size());
+        data.append(entry.second);
+    }
+
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file.flush())
+            throw std::runtime_error("No se pudo escribir la caché: " + temporary);
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("No se pudo reemplazar la caché: " + path);
+    }
+}
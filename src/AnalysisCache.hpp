@@ -0,0 +1,68 @@
+#pragma once
+#include "Fingerprint.hpp"
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/*
+ * Caché en disco de resultados del análisis semántico, indexada por huella.
+ *
+ * La llave es la huella de todo lo que lee el análisis de una unidad (preludio, texto
+ * fuente, opciones...); el valor es el resultado ya serializado. Si la huella no cambió
+ * entre compilaciones el resultado se toma de la caché y la unidad no se vuelve a analizar.
+ *
+ * Formato del archivo (enteros de 64 bits little-endian):
+ *   "SEMCACHE" | versión | número de entradas | por entrada: lo, hi, longitud, bytes
+ */
+class AnalysisCache
+{
+private:
+    std::unordered_map<Fingerprint, std::string, FingerprintHash> entries;
+    size_t hitCount = 0;
+    size_t missCount = 0;
+
+public:
+    // Carga el archivo y reemplaza el contenido. Si no existe, es de otra versión o está
+    // dañado regresa false y la caché queda vacía (se recompila todo).
+    bool load(const std::string &path);
+
+    // Escribe a un archivo temporal y lo renombra, así una escritura interrumpida nunca
+    // deja un archivo a medias. Lanza std::runtime_error si no puede escribir.
+    void save(const std::string &path) const;
+
+    // Resultado guardado para la huella; nullptr si no hay
+    const std::string *find(const Fingerprint &key) const
+    {
+        auto it = entries.find(key);
+        return it == entries.end() ? nullptr : &it->second;
+    }
+
+    void store(const Fingerprint &key, std::string result) { entries[key] = std::move(result); }
+
+    /**
+     * Resultado para la huella; si no está lo calcula con compute() y lo guarda.
+     *
+     * @param key Huella de las entradas del análisis
+     * @param compute Callable () -> std::string, solo se llama en un fallo
+     */
+    template <typename Compute>
+    const std::string &getOrCompute(const Fingerprint &key, Compute compute)
+    {
+        auto it = entries.find(key);
+        if (it != entries.end())
+        {
+            ++hitCount;
+            return it->second;
+        }
+        ++missCount;
+        return entries.emplace(key, compute()).first->second;
+    }
+
+    size_t size() const { return entries.size(); }
+    void clear() { entries.clear(); }
+
+    // Aciertos y fallos de getOrCompute desde la construcción
+    size_t hits() const { return hitCount; }
+    size_t misses() const { return missCount; }
+};
@@ -0,0 +1,50 @@
+#pragma once
+#include "BasicSymbolTable.hpp"
+#include <string>
+
+/*
+ * Otras tablas del compilador sobre BasicSymbolTable, cada una con el hash y el
+ * almacenamiento que mejor le quedan.
+ */
+
+// Etiquetas de código intermedio: ids cortos, muchas inserciones, se consultan al
+// resolver saltos. Tabla plana con FNV.
+struct LabelEntry
+{
+    std::string id;
+    int position; // Índice del cuádruplo al que apunta
+};
+inline Fingerprint entryFingerprint(const LabelEntry &entry)
+{
+    return FingerprintBuilder().add(entry.id).add(entry.position).result();
+}
+using LabelTable = BasicSymbolTable<std::string, LabelEntry, FnvHash, FlatMapStorage>;
+
+// Macros: cuerpo grande por entrada, se consultan mucho más de lo que se insertan.
+struct MacroEntry
+{
+    std::string id;
+    std::string body;
+    std::vector<std::string> params;
+};
+inline Fingerprint entryFingerprint(const MacroEntry &entry)
+{
+    FingerprintBuilder builder;
+    builder.add(entry.id).add(entry.body).add(static_cast<uint64_t>(entry.params.size()));
+    for (const std::string &param : entry.params)
+        builder.add(param);
+    return builder.result();
+}
+using MacroTable = BasicSymbolTable<std::string, MacroEntry, WyHash, FlatMapStorage>;
+
+// Palabras clave: conjunto fijo que se llena una vez; hash perfecto, una sola prueba.
+struct KeywordEntry
+{
+    std::string id;
+    int token;
+};
+inline Fingerprint entryFingerprint(const KeywordEntry &entry)
+{
+    return FingerprintBuilder().add(entry.id).add(entry.token).result();
+}
+using KeywordTable = BasicSymbolTable<std::string, KeywordEntry, FnvHash, PerfectHashStorage>;
@@ -0,0 +1,341 @@
+#pragma once
+#include "Fingerprint.hpp"
+#include "HashPolicies.hpp"
+#include "SymbolStorage.hpp"
+#include "SymbolTableFwd.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ * Definición de una expeción personalizada para un mejor manejo de errores
+ */
+class SymbolNotFoundError : public std::runtime_error
+{
+public:
+    explicit SymbolNotFoundError(const std::string &id)
+        : std::runtime_error("Symbol not found: " + id) {}
+};
+
+// Huella del contenido de una entrada. Las entradas con más datos que su llave
+// (SymbolEntry, etiquetas, macros...) sobrecargan esta función; se encuentra por ADL.
+template <typename Entry>
+Fingerprint entryFingerprint(const Entry &entry)
+{
+    return FingerprintBuilder().add(EntryKey<Entry>::of(entry)).result();
+}
+
+template <typename Key, typename Entry, typename HashPolicy>
+class BasicFrozenTable;
+
+/*
+ * Tabla de símbolos genérica.
+ *
+ * - Key: tipo de la llave (el id de la entrada, ver EntryKey).
+ * - Entry: lo que se guarda por llave (SymbolEntry, etiquetas, campos, macros...).
+ * - HashPolicy: función de hash elegida en compilación (StdHash, FnvHash, WyHash).
+ * - Storage: organización en memoria (ChunkedStorage, NodeMapStorage, FlatMapStorage,
+ *   SortedVectorStorage, PerfectHashStorage).
+ * No hay despacho virtual: cada combinación es un tipo distinto.
+ * Las consultas reciben la llave como std::string_view (sirven std::string, std::pmr::string
+ * y literales sin copiarlos).
+ *
+ * SymbolTable es un alias de esta plantilla (ver SymbolTable.hpp).
+ */
+template <typename Key, typename Entry, typename HashPolicy, template <class, class, class> class Storage>
+class BasicSymbolTable
+{
+public:
+    using key_type = Key;
+    using entry_type = Entry;
+    using hash_policy = HashPolicy;
+    using storage_type = Storage<Key, Entry, HashPolicy>;
+
+private:
+    storage_type table;
+
+    // Filtro de Bloom opcional (vacío = desactivado). Descarta rápidamente los ids que
+    // seguro no están en la tabla: 3 bits por id, crece al duplicarse la carga.
+    BucketVector<uint64_t> bloom;
+
+    // Suma de las huellas de las entradas (sin orden): se actualiza en O(1) en insert
+    Fingerprint contents;
+
+    // Marca los 3 bits del hash (doble hashing: h + i * paso)
+    void bloomAdd(size_t hash)
+    {
+        size_t mask = bloom.size() * 64 - 1;
+        size_t step = (hash >> 32) | 1;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            size_t bit = (hash + i * step) & mask;
+            bloom[bit >> 6] |= uint64_t(1) << (bit & 63);
+        }
+    }
+
+    // Reconstruye el filtro con `bits` bits (potencia de 2) a partir de los ids actuales
+    void bloomRebuild(size_t bits)
+    {
+        bloom.assign(bits / 64, 0);
+        table.forEach([this](const Entry &entry)
+                      { bloomAdd(hashId(EntryKey<Entry>::of(entry))); });
+    }
+
+    // Obtiene referencia al símbolo o lanza error
+    const Entry &getSymbol(std::string_view id) const
+    {
+        const Entry *entry = lookup(id);
+        if (!entry)
+        {
+            // Si no lo encuentra lanza una excepción personalizada
+            throw SymbolNotFoundError(std::string(id));
+        }
+        return *entry;
+    }
+
+    // freeze() construye una tabla con otro almacenamiento directamente
+    template <typename, typename, typename, template <class, class, class> class>
+    friend class BasicSymbolTable;
+
+    BasicSymbolTable(storage_type storage, std::pmr::memory_resource *resource, const Fingerprint &sum)
+        : table(std::move(storage)), bloom(resource), contents(sum) {}
+
+public:
+    // Tabla congelada: hash perfecto mínimo con las entradas en un solo arreglo contiguo,
+    // sin insert ni clear (ver BasicFrozenTable)
+    using frozen_type = BasicFrozenTable<Key, Entry, HashPolicy>;
+
+    BasicSymbolTable() : BasicSymbolTable(std::pmr::get_default_resource()) {}
+
+    // Toda la memoria interna (entradas, índice, filtro) sale de `resource`, incluidas las
+    // cadenas y listas std::pmr de cada entrada (ver entryCopy).
+    explicit BasicSymbolTable(std::pmr::memory_resource *resource) : table(resource), bloom(resource) {}
+
+    // Recurso del que reserva la tabla
+    std::pmr::memory_resource *resource() const { return bloom.get_allocator().resource(); }
+
+    // Hash de un id, el mismo que usa el filtro de Bloom. SymbolTableStack lo calcula una
+    // sola vez y lo reutiliza en todos los niveles.
+    static size_t hashId(std::string_view id) { return HashPolicy::hash(id, 0); }
+
+    // insert va a regresar regresa false si ya existía el id, true si se insertó correctamente
+    bool insert(const Entry &entry)
+    {
+        return insert(entry, hashId(EntryKey<Entry>::of(entry)));
+    }
+
+    // Igual que insert, pero con el hash del id ya calculado (debe ser hashId del id)
+    bool insert(const Entry &entry, size_t hash)
+    {
+        bool inserted = table.insert(entry, hash).second;
+        if (inserted)
+            contents += entryFingerprint(entry);
+        if (inserted && !bloom.empty())
+        {
+            // Con más de un id por cada 8 bits los falsos positivos se disparan: se duplica
+            if (table.size() * 8 > bloom.size() * 64)
+                bloomRebuild(bloom.size() * 64 * 2);
+            else
+                bloomAdd(hash);
+        }
+        return inserted;
+    }
+
+    // -----------------------------------------
+    // Consultas individuales simples (entradas con los campos de SymbolEntry)
+    // -----------------------------------------
+    // Devuelve el tipo asociado al id
+    int getType(std::string_view id) const { return getSymbol(id).typeId; }
+
+    // Devuelve la dirección asociada al id
+    int getAddress(std::string_view id) const { return getSymbol(id).address; }
+
+    // Devuelve la categoría asociada al id
+    Category getCategory(std::string_view id) const { return getSymbol(id).category; }
+
+    // Devuelve una copia de la lista de parámetros asociada al id (la de la entrada
+    // reserva en el recurso de la tabla)
+    std::vector<int> getParams(std::string_view id) const
+    {
+        const auto &params = getSymbol(id).params;
+        return std::vector<int>(params.begin(), params.end());
+    }
+
+    // -----------------------------------------
+    // Consulta completa (si necesitas todos los datos)
+    // -----------------------------------------
+    const Entry *lookup(std::string_view id) const
+    {
+        return table.find(id, hashId(id));
+    }
+
+    // Igual que lookup, pero con el hash ya calculado; si el filtro de Bloom descarta el
+    // id no se toca la tabla hash
+    const Entry *lookup(std::string_view id, size_t hash) const
+    {
+        if (!mayContain(hash))
+            return nullptr;
+        return table.find(id, hash);
+    }
+
+    // -----------------------------------------
+    // Filtro de Bloom
+    // -----------------------------------------
+    // Activa o desactiva el filtro; al activarlo se construye con los ids actuales
+    void enableBloomFilter(bool enabled)
+    {
+        if (!enabled)
+        {
+            bloom.clear();
+            bloom.shrink_to_fit();
+            return;
+        }
+        if (!bloom.empty())
+            return;
+
+        // 512 bits de inicio (8 palabras) o más si la tabla ya tiene muchos ids
+        size_t bits = 512;
+        while (table.size() * 8 > bits)
+            bits *= 2;
+        bloomRebuild(bits);
+    }
+
+    bool hasBloomFilter() const { return !bloom.empty(); }
+
+    // false solo si el id seguro no está en la tabla (siempre true sin filtro)
+    bool mayContain(size_t hash) const
+    {
+        if (bloom.empty())
+            return true;
+        size_t mask = bloom.size() * 64 - 1;
+        size_t step = (hash >> 32) | 1;
+        for (size_t i = 0; i < 3; ++i)
+        {
+            size_t bit = (hash + i * step) & mask;
+            if (!(bloom[bit >> 6] & (uint64_t(1) << (bit & 63))))
+                return false;
+        }
+        return true;
+    }
+
+    // Vacía la tabla conservando su memoria, para reutilizarla en otro ámbito.
+    // El filtro de Bloom (si lo hay) también se vacía.
+    void clear()
+    {
+        table.clear();
+        std::fill(bloom.begin(), bloom.end(), 0);
+        contents = Fingerprint();
+    }
+
+    size_t size() const { return table.size(); }
+
+    // Huella del contenido, independiente del orden de inserción, del almacenamiento y de
+    // la política de hash: dos tablas con las mismas entradas dan la misma huella (también
+    // la copia congelada). Sirve de llave para una caché en disco (ver AnalysisCache).
+    Fingerprint fingerprint() const
+    {
+        return FingerprintBuilder().add(contents).add(static_cast<uint64_t>(table.size())).result();
+    }
+
+    // Bytes de esta tabla por categoría; el filtro de Bloom cuenta como cubetas
+    MemoryUsage memoryUsage() const
+    {
+        MemoryUsage usage = table.memoryUsage();
+        usage.buckets += vectorBytes(bloom);
+        return usage;
+    }
+
+    // Copia de solo lectura para un ámbito que ya se cerró (p. ej. los campos de una
+    // estructura): cada búsqueda es una sola prueba sin colisiones y no queda memoria por
+    // nodo ni cubetas vacías. La copia es de solo lectura. No lleva filtro de Bloom: con
+    // una sola prueba no ahorraría nada.
+    // La copia reserva en `target` (por omisión, el mismo recurso que esta tabla).
+    frozen_type freeze(std::pmr::memory_resource *target = nullptr) const
+    {
+        if (!target)
+            target = resource();
+        std::vector<Entry> entries;
+        std::vector<uint64_t> hashes;
+        entries.reserve(table.size());
+        hashes.reserve(table.size());
+        table.forEach([&](const Entry &entry)
+                      {
+                          entries.push_back(entryCopy(entry, target));
+                          hashes.push_back(hashId(EntryKey<Entry>::of(entry))); });
+        using Frozen = BasicSymbolTable<Key, Entry, HashPolicy, PerfectHashStorage>;
+        return frozen_type(Frozen(PerfectHashStorage<Key, Entry, HashPolicy>(std::move(entries), std::move(hashes), target),
+                                  target, contents));
+    }
+
+    // Iteración sin copias: `for (const Entry &e : table)`. El orden depende del
+    // almacenamiento (ChunkedStorage: orden de inserción). insert invalida los
+    // iteradores.
+    using const_iterator = typename storage_type::const_iterator;
+    const_iterator begin() const { return table.begin(); }
+    const_iterator end() const { return table.end(); }
+
+    // Recorre todas las entradas (el orden depende del almacenamiento)
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        table.forEach(fn);
+    }
+
+    // Para imprimir/depurar: una línea por entrada con printEntry(std::ostream&, const Entry&)
+    void print() const
+    {
+        std::cout << "Symbol Table:\n";
+        table.forEach([](const Entry &entry)
+                      {
+                          printEntry(std::cout, entry);
+                          std::cout << "\n"; });
+    }
+};
+
+/*
+ * Resultado de BasicSymbolTable::freeze(): la misma tabla sobre PerfectHashStorage, pero
+ * sin insert ni clear. PerfectHashStorage reconstruye todo su índice en cada inserción,
+ * así que llenar una tabla congelada de a una entrada costaría O(n²); aquí solo quedan
+ * las consultas.
+ */
+template <typename Key, typename Entry, typename HashPolicy>
+class BasicFrozenTable : private BasicSymbolTable<Key, Entry, HashPolicy, PerfectHashStorage>
+{
+private:
+    using Table = BasicSymbolTable<Key, Entry, HashPolicy, PerfectHashStorage>;
+
+    // Solo freeze() la construye con contenido
+    template <typename, typename, typename, template <class, class, class> class>
+    friend class BasicSymbolTable;
+
+    explicit BasicFrozenTable(Table table) : Table(std::move(table)) {}
+
+public:
+    using typename Table::entry_type;
+    using typename Table::hash_policy;
+    using typename Table::key_type;
+
+    // Tabla congelada vacía
+    BasicFrozenTable() = default;
+
+    using Table::fingerprint;
+    using Table::getAddress;
+    using Table::getCategory;
+    using Table::getParams;
+    using Table::getType;
+    using Table::hashId;
+    using Table::lookup;
+    using Table::memoryUsage;
+    using Table::print;
+    using Table::resource;
+    using Table::size;
+
+    using const_iterator = typename Table::const_iterator;
+    using Table::begin;
+    using Table::end;
+    using Table::forEach;
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+/*
+ * Cola FIFO de capacidad fija entre un productor y un consumidor en hilos distintos.
+ *
+ * push bloquea mientras la cola está llena y pop mientras está vacía, así un productor
+ * rápido nunca acumula más de `capacity` elementos. close() despierta a todos: después
+ * push falla y pop entrega lo que quede y luego falla. Lo usa una etapa que termina (o
+ * que falló) para que la de al lado no se quede esperando.
+ */
+template <typename T>
+class BoundedQueue
+{
+private:
+    std::deque<T> items;
+    size_t capacity;
+    bool closed = false;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+
+public:
+    explicit BoundedQueue(size_t maxItems) : capacity(maxItems ? maxItems : 1) {}
+
+    BoundedQueue(const BoundedQueue &) = delete;
+    BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+    // false si la cola se cerró (el elemento no se encola)
+    bool push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this]
+                     { return closed || items.size() < capacity; });
+        if (closed)
+            return false;
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // false si la cola está cerrada y vacía
+    bool pop(T &item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this]
+                      { return closed || !items.empty(); });
+        if (items.empty())
+            return false;
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+};
@@ -1,13 +1,50 @@
 #include "CodeGenerator.hpp"
+#include <stdexcept>
 #include <string>
 
+// Obtiene n de "tn" si es un nombre que newTemp ya entregó, o -1 en otro caso. Un nombre
+// como "t07" o "t99" (sin haber creado 100 temporales) es de una variable del usuario.
+int CodeGenerator::tempNumber(const std::string &temp) const {
+    if (temp.size() < 2 || temp[0] != 't' || (temp[1] == '0' && temp.size() > 2)) {
+        return -1;
+    }
+    long long n = 0;
+    for (size_t i = 1; i < temp.size(); ++i) {
+        if (temp[i] < '0' || temp[i] > '9') {
+            return -1;
+        }
+        n = n * 10 + (temp[i] - '0');
+        if (n >= nextTemp) {
+            return -1;
+        }
+    }
+    return static_cast<int>(n);
+}
+
 // Se inicializan los contadores
 CodeGenerator::CodeGenerator()
     : nextTemp(0), nextLabel(0) {}
 
 // Genera temporales
 std::string CodeGenerator::newTemp() {
-    return "t" + std::to_string(nextTemp++);
+    int n;
+    if (reuse != TempReuse::NEVER && !freeTemps.empty()) {
+        n = freeTemps.back();
+        freeTemps.pop_back();
+    } else {
+        n = nextTemp++;
+        live.push_back(false);
+    }
+
+    live[n] = true;
+    // Sin marcas abiertas nadie consulta el registro; así no crece sin límite
+    if (openMarks > 0) {
+        allocationLog.push_back(n);
+    }
+    if (++liveCount > peakLive) {
+        peakLive = liveCount;
+    }
+    return "t" + std::to_string(n);
 }
 
 // Genera etiquetas
@@ -19,4 +56,146 @@ std::string CodeGenerator::newLabel() {
 void CodeGenerator::reset() {
     nextTemp = 0;
     nextLabel = 0;
+    freeTemps.clear();
+    live.clear();
+    allocationLog.clear();
+    openMarks = 0;
+    liveCount = 0;
+    peakLive = 0;
+    currentFunction.clear();
+    peakByFunction.clear();
+    code.clear();
+    endBlock();
+    conversionHits = 0;
+}
+
+// Agrega un cuádruplo al final del código
+void CodeGenerator::emit(const std::string &op, const std::string &arg1, const std::string &arg2, const std::string &result) {
+    // Si se escribe en una dirección convertida (o en el temporal de una conversión),
+    // esa conversión ya no es válida
+    forgetConversionsOf(result);
+    code.push_back({op, arg1, arg2, result});
+}
+
+const std::string *CodeGenerator::findConversion(const std::string &addr, int fromType, int toType) {
+    auto it = conversions.find({addr, fromType, toType});
+    if (it == conversions.end()) {
+        return nullptr;
+    }
+    ++conversionHits;
+    return &it->second;
+}
+
+void CodeGenerator::recordConversion(const std::string &addr, int fromType, int toType, const std::string &temp) {
+    ConversionKey key{addr, fromType, toType};
+    forgetConversion(key); // Una conversión registrada de nuevo reemplaza su par anterior
+    conversions.emplace(key, temp);
+    conversionsByAddress.emplace(addr, key);
+    conversionsByAddress.emplace(temp, key);
+}
+
+// Quita una conversión y sus dos entradas en el índice (origen y temporal)
+void CodeGenerator::forgetConversion(const ConversionKey &key) {
+    auto it = conversions.find(key);
+    if (it == conversions.end()) {
+        return;
+    }
+    const std::string *addresses[] = {&key.addr, &it->second};
+    for (const std::string *addr : addresses) {
+        auto range = conversionsByAddress.equal_range(*addr);
+        for (auto entry = range.first; entry != range.second; ++entry) {
+            if (entry->second == key) {
+                conversionsByAddress.erase(entry);
+                break;
+            }
+        }
+    }
+    conversions.erase(it);
+}
+
+// Quita todas las conversiones cuyo origen o temporal es addr
+void CodeGenerator::forgetConversionsOf(const std::string &addr) {
+    if (conversionsByAddress.empty()) {
+        return;
+    }
+    auto range = conversionsByAddress.equal_range(addr);
+    if (range.first == range.second) {
+        return;
+    }
+    std::vector<ConversionKey> keys;
+    for (auto it = range.first; it != range.second; ++it) {
+        keys.push_back(it->second);
+    }
+    for (const ConversionKey &key : keys) {
+        forgetConversion(key);
+    }
+}
+
+void CodeGenerator::endBlock() {
+    conversions.clear();
+    conversionsByAddress.clear();
+}
+
+// Libera el temporal n si está vivo. n < 0 es un nombre que newTemp no entregó (una
+// variable del usuario) y se ignora también en CHECKED.
+void CodeGenerator::release(int n) {
+    if (n < 0) {
+        return;
+    }
+    if (!live[n]) {
+        if (reuse == TempReuse::CHECKED) {
+            throw std::logic_error("Se liberó un temporal que no está vivo: t" + std::to_string(n));
+        }
+        return;
+    }
+
+    live[n] = false;
+    --liveCount;
+    // Un temporal muerto ya no guarda ninguna conversión
+    if (!conversionsByAddress.empty()) {
+        forgetConversionsOf("t" + std::to_string(n));
+    }
+    if (reuse != TempReuse::NEVER) {
+        freeTemps.push_back(n);
+    }
+}
+
+void CodeGenerator::releaseTemp(const std::string &temp) {
+    release(tempNumber(temp));
+}
+
+void CodeGenerator::releaseTemps(size_t mark, const std::string &keep) {
+    int kept = tempNumber(keep);
+    for (size_t i = mark; i < allocationLog.size(); ++i) {
+        int n = allocationLog[i];
+        // Los temporales ya liberados a mano se saltan, incluso en CHECKED
+        if (n != kept && live[n]) {
+            release(n);
+        }
+    }
+    allocationLog.resize(mark < allocationLog.size() ? mark : allocationLog.size());
+    if (openMarks > 0) {
+        --openMarks;
+    }
+    if (openMarks > 0 && kept >= 0 && live[kept]) {
+        allocationLog.push_back(kept); // El resultado pertenece a la expresión que lo contiene
+    }
+}
+
+void CodeGenerator::beginFunction(const std::string &name) {
+    currentFunction = name;
+    peakLive = liveCount;
+}
+
+int CodeGenerator::endFunction() {
+    int peak = peakLive;
+    peakByFunction[currentFunction] = peak;
+    currentFunction.clear();
+    peakLive = liveCount;
+    return peak;
+}
+
+int CodeGenerator::peakLiveTempsOf(const std::string &function) const {
+    auto it = peakByFunction.find(function);
+    return it != peakByFunction.end() ? it->second : -1;
 }
@@ -1,5 +1,47 @@
 #pragma once
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+// Política de reutilización de temporales
+enum class TempReuse
+{
+    NEVER,   // Cada newTemp da un nombre nuevo (comportamiento original)
+    RECYCLE, // Los temporales liberados se reutilizan, el último liberado primero
+    CHECKED  // Como RECYCLE, pero liberar un temporal que no está vivo lanza std::logic_error,
+             // así un temporal nunca se reutiliza mientras su valor sigue vivo
+};
+
+// Cuádruplo de código de tres direcciones: result = arg1 op arg2
+struct Quad
+{
+    std::string op;
+    std::string arg1;
+    std::string arg2;
+    std::string result;
+};
+
+// Llave de una conversión implícita ya emitida: (dirección, tipo origen, tipo destino)
+struct ConversionKey
+{
+    std::string addr;
+    int fromType;
+    int toType;
+
+    bool operator==(const ConversionKey &other) const
+    {
+        return fromType == other.fromType && toType == other.toType && addr == other.addr;
+    }
+};
+
+struct ConversionKeyHash
+{
+    size_t operator()(const ConversionKey &key) const
+    {
+        size_t h = std::hash<std::string>{}(key.addr);
+        return h ^ (static_cast<size_t>(key.fromType) * 0x9E3779B97F4A7C15ULL) ^ (static_cast<size_t>(key.toType) << 32);
+    }
+};
 
 // Clase encargada de generar temporales y etiquetas para la construcción de código intermedio de tres direcciones
 class CodeGenerator {
@@ -7,6 +49,30 @@ private:
     int nextTemp = 0; // Garantiza que el primer temporal es t0
     int nextLabel = 0; // Garantiza que el primer label sea L0
 
+    TempReuse reuse = TempReuse::NEVER;
+    std::vector<int> freeTemps;     // Pila de temporales muertos (el tope es el último liberado)
+    std::vector<bool> live;         // live[n] indica si tn está vivo
+    std::vector<int> allocationLog; // Temporales en orden de entrega, solo con marcas abiertas
+    int openMarks = 0;              // markTemps aún sin su releaseTemps
+
+    int liveCount = 0;
+    int peakLive = 0;
+    std::string currentFunction;
+    std::unordered_map<std::string, int> peakByFunction;
+
+    std::vector<Quad> code; // Código emitido, en orden
+
+    // Conversiones ya emitidas en el bloque básico actual
+    std::unordered_map<ConversionKey, std::string, ConversionKeyHash> conversions;
+    // Dirección origen o temporal de resultado -> conversiones que dejan de valer si se escribe en él
+    std::unordered_multimap<std::string, ConversionKey> conversionsByAddress;
+    int conversionHits = 0;
+
+    void release(int n);
+    void forgetConversion(const ConversionKey &key);
+    void forgetConversionsOf(const std::string &addr);
+    int tempNumber(const std::string &temp) const;
+
 public:
     // Inicializa los contadores de temporales y etiquetas.
     CodeGenerator();           
@@ -15,5 +81,71 @@ public:
 
     std::string newLabel() ; // Devuelve L0, L1, L2...
 
-    void reset() ; // Reinicia ambos contadores
+    void reset() ; // Reinicia ambos contadores (y descarta el código emitido)
+
+    // -----------------------------------------
+    // Emisión de cuádruplos
+    // -----------------------------------------
+    void emit(const std::string &op, const std::string &arg1, const std::string &arg2, const std::string &result);
+
+    const std::vector<Quad> &getCode() const { return code; }
+
+    // -----------------------------------------
+    // Memoria de conversiones por bloque básico
+    // -----------------------------------------
+    // Temporal que ya contiene la conversión de addr de fromType a toType en este
+    // bloque, o nullptr. Escribir en addr o en el temporal invalida la entrada.
+    const std::string *findConversion(const std::string &addr, int fromType, int toType);
+
+    // Registra que temp contiene addr convertido de fromType a toType
+    void recordConversion(const std::string &addr, int fromType, int toType, const std::string &temp);
+
+    // Fin de bloque básico: se olvidan las conversiones emitidas
+    void endBlock();
+
+    // Conversiones recordadas en el bloque actual
+    size_t rememberedConversions() const { return conversions.size(); }
+
+    // Veces que findConversion encontró una conversión reutilizable
+    int conversionCacheHits() const { return conversionHits; }
+
+    // -----------------------------------------
+    // Reutilización de temporales
+    // -----------------------------------------
+    void setTempReuse(TempReuse mode) { reuse = mode; }
+    TempReuse tempReuse() const { return reuse; }
+
+    // Marca un temporal como muerto; en RECYCLE/CHECKED el siguiente newTemp lo reutiliza.
+    // Solo cuentan los nombres que newTemp entregó; otros (p. ej. "t07") se tratan como
+    // variables del usuario
+    void releaseTemp(const std::string &temp);
+
+    // Marca de expresión: al cerrar la expresión, releaseTemps(marca) libera todos los
+    // temporales entregados desde la marca que sigan vivos, excepto `keep` (el resultado),
+    // que pasa a la marca exterior si hay una abierta. Las marcas se cierran en orden
+    // inverso al que se abren; fuera de ellas los temporales no se registran.
+    size_t markTemps()
+    {
+        ++openMarks;
+        return allocationLog.size();
+    }
+    void releaseTemps(size_t mark, const std::string &keep = "");
+
+    // -----------------------------------------
+    // Métricas por función
+    // -----------------------------------------
+    // Reinicia el conteo de temporales vivos para una nueva función
+    void beginFunction(const std::string &name);
+
+    // Termina la función y regresa el máximo de temporales vivos a la vez
+    int endFunction();
+
+    int liveTemps() const { return liveCount; }
+    int peakLiveTemps() const { return peakLive; }
+
+    // Máximo de temporales vivos reportado por endFunction, o -1 si la función no existe
+    int peakLiveTempsOf(const std::string &function) const;
+
+    // Cantidad de nombres de temporal distintos creados
+    int tempsCreated() const { return nextTemp; }
 };
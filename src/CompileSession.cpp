@@ -0,0 +1,48 @@
+#include "CompileSession.hpp"
+
+namespace
+{
+    // Las estructuras (perezosas incluidas) se construyen y congelan antes de compartir la
+    // tabla: después nadie la escribe
+    std::shared_ptr<const TypeTable> sealTypes(TypeTable types)
+    {
+        auto table = std::make_shared<TypeTable>(std::move(types));
+        table->freezeStructFields();
+        return table;
+    }
+}
+
+Prelude::Prelude(TypeTable types, SymbolTable symbols)
+    : typeTable(sealTypes(std::move(types))), manager(*typeTable),
+      globals(std::make_shared<const SymbolTable>(std::move(symbols)))
+{
+    // Todo lo que se calcula de forma perezosa se calcula ahora: después nadie escribe
+    manager.prepareBatch();
+    print = FingerprintBuilder().add(typeTable->fingerprint()).add(globals->fingerprint()).result();
+}
+
+std::shared_ptr<const Prelude> Prelude::standard()
+{
+    static const std::shared_ptr<const Prelude> shared = []
+    {
+        TypeTable types;
+        types.addBasicType("void", 0);
+        types.addBasicType("bool", 1);
+        types.addBasicType("char", 1);
+        types.addBasicType("int", 4);
+        types.addBasicType("float", 4);
+        types.addBasicType("double", 8);
+        return std::make_shared<const Prelude>(std::move(types), SymbolTable());
+    }();
+    return shared;
+}
+
+TranslationUnit::TranslationUnit(std::shared_ptr<const Prelude> shared, std::string name,
+                                 std::pmr::memory_resource *resource)
+    : prelude(std::move(shared)), unitName(std::move(name)),
+      typeTable(TypeTable::overlay(prelude->sharedTypes(), resource)),
+      manager(typeTable, prelude->typeManager()),
+      stack(prelude->symbols(), resource)
+{
+    stack.pushScope(); // Global propio de la unidad
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include "AnalysisCache.hpp"
+#include "SymbolTableStack.hpp"
+#include "TypeManager.hpp"
+#include "TypeTable.hpp"
+#include "WorkStealingPool.hpp"
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Preludio compartido: tipos básicos, retícula del TypeManager y símbolos
+ * predeclarados. Es inmutable una vez construido y lo comparten (sin candados) todas las
+ * unidades de compilación del proceso.
+ */
+class Prelude
+{
+private:
+    std::shared_ptr<const TypeTable> typeTable; // Base de la TypeTable de cada unidad
+    TypeManager manager; // Apunta a *typeTable: el preludio no se copia ni se mueve
+    std::shared_ptr<const SymbolTable> globals;
+    Fingerprint print;
+
+public:
+    /**
+     * @param types Tipos del preludio; sus estructuras se construyen y congelan aquí
+     * @param symbols Símbolos predeclarados (funciones de biblioteca, constantes...)
+     */
+    Prelude(TypeTable types, SymbolTable symbols);
+
+    Prelude(const Prelude &) = delete;
+    Prelude &operator=(const Prelude &) = delete;
+
+    // Preludio estándar del proceso (void, bool, char, int, float, double; sin símbolos).
+    // Se construye una sola vez, en la primera llamada.
+    static std::shared_ptr<const Prelude> standard();
+
+    const TypeTable &types() const { return *typeTable; }
+    const std::shared_ptr<const TypeTable> &sharedTypes() const { return typeTable; }
+    const TypeManager &typeManager() const { return manager; }
+    const std::shared_ptr<const SymbolTable> &symbols() const { return globals; }
+
+    // Huella de los tipos y los símbolos del preludio
+    const Fingerprint &fingerprint() const { return print; }
+};
+
+/**
+ * Estado de una unidad de compilación sobre un preludio.
+ *
+ * - Tipos: una capa sobre la TypeTable del preludio (TypeTable::overlay), que no la
+ *   copia; los tipos nuevos reciben IDs a partir de los del preludio.
+ * - TypeManager: arranca con la retícula del preludio ya calculada.
+ * - Símbolos: una SymbolTableStack cuya base es el global congelado del preludio, con un
+ *   primer ámbito abierto que es el global propio de la unidad (se llena con insertTop y
+ *   puede ocultar símbolos del preludio).
+ */
+class TranslationUnit
+{
+private:
+    std::shared_ptr<const Prelude> prelude;
+    std::string unitName;
+    TypeTable typeTable;
+    TypeManager manager; // Apunta a typeTable: la unidad no se copia ni se mueve
+    SymbolTableStack stack;
+
+public:
+    TranslationUnit(std::shared_ptr<const Prelude> shared, std::string name,
+                    std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    TranslationUnit(const TranslationUnit &) = delete;
+    TranslationUnit &operator=(const TranslationUnit &) = delete;
+
+    const std::string &name() const { return unitName; }
+    const Prelude &getPrelude() const { return *prelude; }
+
+    TypeTable &types() { return typeTable; }
+    const TypeManager &typeManager() const { return manager; }
+    SymbolTableStack &symbols() { return stack; }
+};
+
+/**
+ * Conductor de varias unidades de compilación en el mismo proceso, en secuencia o en
+ * una WorkStealingPool, todas sobre el mismo preludio.
+ *
+ * Igual que ParallelChecker, los resultados salen en el orden de las unidades y si alguna
+ * compilación lanza se relanza la excepción de la primera unidad (en orden) que falló.
+ */
+class CompileSession
+{
+private:
+    std::shared_ptr<const Prelude> prelude;
+
+public:
+    explicit CompileSession(std::shared_ptr<const Prelude> shared = Prelude::standard())
+        : prelude(std::move(shared)) {}
+
+    const Prelude &getPrelude() const { return *prelude; }
+
+    // Abre una unidad nueva (arranque: capas vacías sobre los tipos y símbolos del preludio)
+    std::unique_ptr<TranslationUnit> openUnit(const std::string &name,
+                                              std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const
+    {
+        return std::make_unique<TranslationUnit>(prelude, name, resource);
+    }
+
+    /**
+     * Compila las unidades una tras otra.
+     *
+     * @param names Nombres de las unidades
+     * @param compile Callable (TranslationUnit&) -> Result
+     * @param resource Recurso del que sale lo que reserva cada unidad (ver TranslationUnit)
+     */
+    template <typename Compile>
+    auto compileAll(const std::vector<std::string> &names, Compile compile,
+                    std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        -> std::vector<std::invoke_result_t<Compile &, TranslationUnit &>>
+    {
+        using Result = std::invoke_result_t<Compile &, TranslationUnit &>;
+
+        std::vector<Result> results;
+        results.reserve(names.size());
+        for (const auto &name : names)
+        {
+            TranslationUnit unit(prelude, name, resource);
+            results.push_back(compile(unit));
+        }
+        return results;
+    }
+
+    /**
+     * Compila las unidades en paralelo; mismos resultados que compileAll (ver
+     * collectInOrder: Result puede ser bool o no tener constructor por omisión, y se
+     * relanza el error de la primera unidad que falló). Espera solo a sus propias
+     * unidades; desde una tarea de `pool` lanza std::logic_error. Las unidades corren a
+     * la vez sobre `resource`, así que debe ser seguro entre hilos (p. ej.
+     * synchronized_pool_resource).
+     */
+    template <typename Compile>
+    auto compileParallel(const std::vector<std::string> &names, WorkStealingPool &pool, Compile compile,
+                         std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        -> std::vector<std::invoke_result_t<Compile &, TranslationUnit &>>
+    {
+        return collectInOrder(pool, names.size(), [this, &names, &compile, resource](size_t i)
+                              {
+                                  TranslationUnit unit(prelude, names[i], resource);
+                                  return compile(unit); });
+    }
+
+    // Llave de caché de una unidad: el preludio más la huella de sus propias entradas
+    Fingerprint unitKey(const std::string &name, const Fingerprint &inputs) const
+    {
+        return FingerprintBuilder().add(prelude->fingerprint()).add(name).add(inputs).result();
+    }
+
+    /**
+     * Como compileAll, pero solo abre y compila las unidades cuya llave no está en la
+     * caché; las demás toman el resultado guardado.
+     *
+     * @param names Nombres de las unidades
+     * @param cache Caché de resultados (se cargó y se guarda por fuera)
+     * @param inputsOf Callable (const std::string &name) -> Fingerprint de las entradas
+     *                 de la unidad (p. ej. FingerprintBuilder().add(texto fuente))
+     * @param compile Callable (TranslationUnit&) -> std::string, el resultado serializado
+     * @param resource Recurso de las unidades que se compilan (como en compileAll)
+     */
+    template <typename Inputs, typename Compile>
+    std::vector<std::string> compileCached(const std::vector<std::string> &names, AnalysisCache &cache,
+                                           Inputs inputsOf, Compile compile,
+                                           std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+    {
+        std::vector<std::string> results;
+        results.reserve(names.size());
+        for (const auto &name : names)
+        {
+            results.push_back(cache.getOrCompute(unitKey(name, inputsOf(name)), [&]
+                                                 {
+                                                     TranslationUnit unit(prelude, name, resource);
+                                                     return compile(unit); }));
+        }
+        return results;
+    }
+};
@@ -0,0 +1,4 @@
+#include "ConcurrentSymbolTable.hpp"
+
+// La instancia de ConcurrentSymbolTable se compila una sola vez aquí
+template class BasicConcurrentSymbolTable<WyHash>;
@@ -0,0 +1,321 @@
+#pragma once
+#include "SymbolTable.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+
+/*
+ * Tabla de símbolos global concurrente para la recolección paralela de declaraciones.
+ *
+ * Es una lista ordenada por división (split-ordered list): todas las entradas están en
+ * una sola lista ligada, ordenada por el hash con los bits invertidos, y cada cubeta es
+ * un nodo centinela dentro de esa lista. Duplicar las cubetas no mueve ningún nodo: una
+ * cubeta nueva se enlaza la primera vez que alguien inserta en ella, después del
+ * centinela de su cubeta padre (la misma sin el bit más alto). Así la tabla crece con la
+ * carga sin pausas ni candados.
+ *
+ * - Los centinelas viven dentro de los segmentos de cubetas (una búsqueda cuesta la
+ *   cubeta y los nodos de su cadena, igual que una tabla con cubetas fijas). Los
+ *   segmentos se reservan al crecer: el primero tiene las cubetas iniciales y cada uno
+ *   siguiente el doble; la tabla deja de crecer en 2^40 cubetas.
+ * - insert usa compare-and-swap sobre el `next` de un nodo; los nodos nunca se modifican
+ *   ni se liberan mientras viva la tabla.
+ * - lookup no escribe nada: empieza en la cubeta enlazada más cercana y recorre una
+ *   lista que solo crece, sin candados ni reintentos.
+ *
+ * insert conserva la semántica de SymbolTable: regresa false si el id ya existía,
+ * incluso cuando dos hilos compiten por el mismo id (solo uno gana).
+ *
+ * HashPolicy es la misma que usa BasicSymbolTable (ver HashPolicies.hpp); con WyHash el
+ * hash coincide con SymbolTable::hashId, y SymbolTableStack lo calcula una sola vez.
+ */
+template <typename HashPolicy>
+class BasicConcurrentSymbolTable
+{
+private:
+    // Entradas y centinelas comparten el eslabón; el bit bajo de `order` dice cuál es cuál
+    struct Link
+    {
+        uint64_t order = 0; // Hash con los bits invertidos (ver regularOrder/sentinelOrder)
+        std::atomic<Link *> next{nullptr};
+
+        bool sentinel() const { return (order & 1) == 0; }
+    };
+
+    struct Node : Link
+    {
+        SymbolEntry entry;
+
+        Node(uint64_t order, const SymbolEntry &e) : entry(e) { this->order = order; }
+    };
+
+    // Estado de una cubeta. Un solo hilo enlaza su centinela (el que pasa de FREE a
+    // LINKING); los demás usan mientras tanto a su padre. Los estados van aparte, al final
+    // del segmento, para que el centinela ocupe lo mismo que un eslabón.
+    enum : uint8_t { FREE, LINKING, READY };
+
+    struct Bucket
+    {
+        Link *sentinel;
+        std::atomic<uint8_t> *state;
+    };
+
+    static constexpr size_t MAX_BUCKETS = size_t(1) << (sizeof(size_t) >= 8 ? 40 : 30);
+    static constexpr size_t MAX_SEGMENTS = (sizeof(size_t) >= 8 ? 40 : 30) + 1;
+    static constexpr size_t MAX_LOAD = 2; // Entradas por cubeta antes de duplicarlas
+
+    size_t firstSegment; // Cubetas del segmento 0 (potencia de 2)
+    std::atomic<Link *> segments[MAX_SEGMENTS]; // Centinelas seguidos de sus estados
+    std::atomic<size_t> buckets;
+    std::atomic<size_t> count{0};
+    Link *head; // Centinela de la cubeta 0: inicio de la lista
+
+    static uint64_t reverseBits(uint64_t x)
+    {
+        x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+        x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+        x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        x = ((x >> 8) & 0x00FF00FF00FF00FFULL) | ((x & 0x00FF00FF00FF00FFULL) << 8);
+        x = ((x >> 16) & 0x0000FFFF0000FFFFULL) | ((x & 0x0000FFFF0000FFFFULL) << 16);
+        return (x >> 32) | (x << 32);
+    }
+
+    static size_t highestBit(size_t x)
+    {
+        size_t bit = 0;
+        while (x >>= 1)
+            ++bit;
+        return bit;
+    }
+
+    // Las entradas llevan el bit bajo en 1 y los centinelas en 0: un centinela queda antes
+    // de todas las entradas de su cubeta
+    static uint64_t regularOrder(uint64_t hash) { return reverseBits(hash | (uint64_t(1) << 63)); }
+    static uint64_t sentinelOrder(size_t bucket) { return reverseBits(bucket); }
+
+    // Cubeta padre: la misma sin su bit más alto (su centinela va antes en la lista)
+    static size_t parentOf(size_t bucket) { return bucket & ~(size_t(1) << highestBit(bucket)); }
+
+    size_t segmentLength(size_t segment) const { return segment == 0 ? firstSegment : firstSegment << (segment - 1); }
+
+    static size_t segmentBytes(size_t length) { return length * (sizeof(Link) + sizeof(std::atomic<uint8_t>)); }
+
+    // Cubeta del índice dado; reserva su segmento si `reserve` (si no, sentinel es nullptr
+    // cuando el segmento no existe)
+    Bucket bucketAt(size_t bucket, bool reserve)
+    {
+        size_t segment = 0;
+        size_t offset = bucket;
+        if (bucket >= firstSegment)
+        {
+            segment = highestBit(bucket / firstSegment) + 1;
+            offset = bucket - segmentLength(segment);
+        }
+        size_t length = segmentLength(segment);
+        Link *links = segments[segment].load(std::memory_order_acquire);
+        if (!links && reserve)
+        {
+            void *block = ::operator new(segmentBytes(length));
+            Link *fresh = static_cast<Link *>(block);
+            auto *states = reinterpret_cast<std::atomic<uint8_t> *>(fresh + length);
+            for (size_t i = 0; i < length; ++i)
+            {
+                new (&fresh[i]) Link();
+                new (&states[i]) std::atomic<uint8_t>(FREE);
+            }
+            if (segments[segment].compare_exchange_strong(links, fresh, std::memory_order_acq_rel))
+                links = fresh;
+            else
+                ::operator delete(block); // Otro hilo lo reservó primero; `links` trae el suyo
+        }
+        if (!links)
+            return {nullptr, nullptr};
+        return {&links[offset], reinterpret_cast<std::atomic<uint8_t> *>(links + length) + offset};
+    }
+
+    Bucket bucketAt(size_t bucket) const
+    {
+        return const_cast<BasicConcurrentSymbolTable *>(this)->bucketAt(bucket, false);
+    }
+
+    // Enlaza `node` en su lugar a partir de `start`. Si `id` no es nullptr y ya hay una
+    // entrada con ese id regresa false sin enlazar.
+    static bool link(Link *start, Link *node, const SymbolEntry::id_type *id)
+    {
+        Link *prev = start;
+        while (true)
+        {
+            Link *cur = prev->next.load(std::memory_order_acquire);
+            while (cur && cur->order <= node->order)
+            {
+                if (id && cur->order == node->order && static_cast<Node *>(cur)->entry.id == *id)
+                    return false;
+                prev = cur;
+                cur = prev->next.load(std::memory_order_acquire);
+            }
+            node->next.store(cur, std::memory_order_relaxed);
+            // Si el CAS falla, alguien enlazó un nodo después de `prev`: se revisa desde ahí
+            if (prev->next.compare_exchange_weak(cur, node, std::memory_order_release, std::memory_order_relaxed))
+                return true;
+        }
+    }
+
+    // Centinela enlazado más cercano a la cubeta, sin escribir nada
+    const Link *nearestSentinel(size_t bucket) const
+    {
+        while (true)
+        {
+            Bucket slot = bucketAt(bucket);
+            if (slot.sentinel && slot.state->load(std::memory_order_acquire) == READY)
+                return slot.sentinel;
+            bucket = parentOf(bucket); // La cubeta 0 siempre está enlazada
+        }
+    }
+
+    // Punto de partida para insertar en la cubeta: su centinela, enlazándolo si nadie lo
+    // ha hecho. Si otro hilo lo está enlazando, sirve el de su padre.
+    Link *startOf(size_t bucket)
+    {
+        Bucket slot = bucketAt(bucket, true);
+        uint8_t state = slot.state->load(std::memory_order_acquire);
+        if (state == READY)
+            return slot.sentinel;
+
+        Link *parent = startOf(parentOf(bucket));
+        if (state == FREE && slot.state->compare_exchange_strong(state, LINKING, std::memory_order_acq_rel))
+        {
+            slot.sentinel->order = sentinelOrder(bucket);
+            link(parent, slot.sentinel, nullptr);
+            slot.state->store(READY, std::memory_order_release);
+            return slot.sentinel;
+        }
+        return parent;
+    }
+
+public:
+    // bucketCount: cubetas iniciales (se redondea a potencia de 2); la tabla duplica sus
+    // cubetas cuando pasa de dos entradas por cubeta
+    explicit BasicConcurrentSymbolTable(size_t bucketCount = 64)
+    {
+        firstSegment = 1;
+        while (firstSegment < bucketCount && firstSegment < MAX_BUCKETS)
+            firstSegment <<= 1;
+        for (auto &segment : segments)
+            segment.store(nullptr, std::memory_order_relaxed);
+        buckets.store(firstSegment, std::memory_order_relaxed);
+        Bucket first = bucketAt(0, true);
+        head = first.sentinel;
+        head->order = sentinelOrder(0);
+        first.state->store(READY, std::memory_order_release);
+    }
+
+    // Libera todos los nodos; no debe haber otros hilos usando la tabla
+    ~BasicConcurrentSymbolTable()
+    {
+        Link *node = head->next.load(std::memory_order_relaxed);
+        while (node)
+        {
+            Link *next = node->next.load(std::memory_order_relaxed);
+            if (!node->sentinel())
+                delete static_cast<Node *>(node);
+            node = next;
+        }
+        for (auto &segment : segments)
+            ::operator delete(segment.load(std::memory_order_relaxed));
+    }
+
+    BasicConcurrentSymbolTable(const BasicConcurrentSymbolTable &) = delete;
+    BasicConcurrentSymbolTable &operator=(const BasicConcurrentSymbolTable &) = delete;
+
+    static uint64_t hashId(std::string_view id) { return HashPolicy::hash(id, 0); }
+
+    // Inserta si no existe; regresa false si el id ya existía. Seguro entre hilos.
+    bool insert(const SymbolEntry &entry) { return insert(entry, hashId(entry.id)); }
+
+    // Igual que insert, con el hash del id ya calculado (debe ser hashId del id)
+    bool insert(const SymbolEntry &entry, uint64_t hash)
+    {
+        size_t size = buckets.load(std::memory_order_acquire);
+        Link *start = startOf(hash & (size - 1));
+        // Un duplicado común se descarta sin reservar el nodo
+        if (lookup(entry.id, hash))
+            return false;
+        Node *node = new Node(regularOrder(hash), entry);
+        if (!link(start, node, &entry.id))
+        {
+            delete node;
+            return false;
+        }
+
+        size_t entries = count.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (entries > size * MAX_LOAD && size < MAX_BUCKETS)
+            buckets.compare_exchange_strong(size, size * 2, std::memory_order_acq_rel);
+        return true;
+    }
+
+    // Búsqueda sin candados; el puntero es válido mientras viva la tabla
+    const SymbolEntry *lookup(std::string_view id) const { return lookup(id, hashId(id)); }
+
+    const SymbolEntry *lookup(std::string_view id, uint64_t hash) const
+    {
+        uint64_t order = regularOrder(hash);
+        const Link *node = nearestSentinel(hash & (buckets.load(std::memory_order_acquire) - 1));
+        for (node = node->next.load(std::memory_order_acquire); node && node->order <= order;
+             node = node->next.load(std::memory_order_acquire))
+        {
+            if (node->order == order && static_cast<const Node *>(node)->entry.id == id)
+                return &static_cast<const Node *>(node)->entry;
+        }
+        return nullptr;
+    }
+
+    size_t size() const { return count.load(std::memory_order_relaxed); }
+
+    // Cubetas actuales (crece con la carga)
+    size_t bucketCount() const { return buckets.load(std::memory_order_relaxed); }
+
+    // Recorre todas las entradas (sin orden definido)
+    void forEach(const std::function<void(const SymbolEntry &)> &fn) const
+    {
+        for (const Link *node = head; node; node = node->next.load(std::memory_order_acquire))
+        {
+            if (!node->sentinel())
+                fn(static_cast<const Node *>(node)->entry);
+        }
+    }
+
+    // Bytes de nodos, segmentos de cubetas y el texto/params de cada entrada
+    MemoryUsage memoryUsage() const
+    {
+        MemoryUsage usage;
+        forEach([&](const SymbolEntry &entry)
+                {
+                    usage.entries += sizeof(Node);
+                    addEntryHeapUsage(entry, usage); });
+        for (size_t segment = 0; segment < MAX_SEGMENTS; ++segment)
+        {
+            if (segments[segment].load(std::memory_order_acquire))
+                usage.buckets += segmentBytes(segmentLength(segment));
+        }
+        return usage;
+    }
+
+    // Copia el contenido a una SymbolTable de solo lectura, lista para usarse como
+    // base congelada de SymbolTableStack. Debe llamarse cuando ya no haya inserciones.
+    // La copia (con su bloque de control) reserva en `resource`.
+    std::shared_ptr<const SymbolTable> freeze(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const
+    {
+        auto table = std::allocate_shared<SymbolTable>(std::pmr::polymorphic_allocator<SymbolTable>(resource), resource);
+        forEach([&](const SymbolEntry &entry)
+                { table->insert(entry); });
+        return table;
+    }
+};
+
+// ConcurrentSymbolTable (alias en SymbolTableFwd.hpp) se compila una sola vez en el .cpp
+extern template class BasicConcurrentSymbolTable<WyHash>;
@@ -0,0 +1,209 @@
+#include "DependencyTracker.hpp"
+#include <algorithm>
+
+namespace
+{
+    // Quita `region` de la lista de lectores (el orden no importa)
+    void removeReader(std::vector<int> &readers, int region)
+    {
+        auto it = std::find(readers.begin(), readers.end(), region);
+        if (it != readers.end())
+        {
+            *it = readers.back();
+            readers.pop_back();
+        }
+    }
+}
+
+void DependencyTracker::forget(int region)
+{
+    Region &r = regions[region];
+    for (int symbol : r.symbols)
+    {
+        removeReader(symbolReaders[symbol], region);
+    }
+    for (int typeId : r.types)
+    {
+        removeReader(typeReaders[typeId], region);
+    }
+    r.symbols.clear();
+    r.types.clear();
+}
+
+void DependencyTracker::beginRegion(const std::string &name)
+{
+    ++epoch;
+    auto it = regionIndex.find(name);
+    if (it == regionIndex.end())
+    {
+        current = static_cast<int>(regions.size());
+        regions.push_back({name, {}, {}, true});
+        regionIndex.emplace(name, current);
+    }
+    else
+    {
+        current = it->second;
+        forget(current);
+    }
+}
+
+void DependencyTracker::endRegion()
+{
+    if (current >= 0)
+    {
+        regions[current].dirty = false;
+        current = -1;
+    }
+}
+
+int DependencyTracker::intern(std::string_view id)
+{
+    auto it = symbolIndex.find(id);
+    if (it != symbolIndex.end())
+    {
+        return it->second;
+    }
+    int symbol = static_cast<int>(symbolNames.size());
+    symbolNames.emplace_back(id);
+    symbolIndex.emplace(symbolNames.back(), symbol);
+    symbolReaders.emplace_back();
+    symbolSeen.push_back(0);
+    return symbol;
+}
+
+void DependencyTracker::recordSymbol(std::string_view id)
+{
+    if (current < 0)
+    {
+        return;
+    }
+    int symbol = intern(id);
+    if (symbolSeen[symbol] == epoch)
+    {
+        return;
+    }
+    symbolSeen[symbol] = epoch;
+    if (regions[current].symbols.insert(symbol).second)
+    {
+        symbolReaders[symbol].push_back(current);
+    }
+}
+
+void DependencyTracker::recordType(int typeId)
+{
+    if (current < 0 || typeId < 0)
+    {
+        return;
+    }
+    if (static_cast<size_t>(typeId) >= typeSeen.size())
+    {
+        typeSeen.resize(typeId + 1, 0);
+    }
+    if (typeSeen[typeId] == epoch)
+    {
+        return;
+    }
+    typeSeen[typeId] = epoch;
+    if (regions[current].types.insert(typeId).second)
+    {
+        typeReaders[typeId].push_back(current);
+    }
+}
+
+size_t DependencyTracker::invalidateSymbol(const std::string &id)
+{
+    size_t changed = 0;
+    auto it = symbolIndex.find(id);
+    if (it != symbolIndex.end())
+    {
+        for (int region : symbolReaders[it->second])
+        {
+            changed += !regions[region].dirty;
+            regions[region].dirty = true;
+        }
+    }
+    return changed;
+}
+
+size_t DependencyTracker::invalidateType(int typeId)
+{
+    size_t changed = 0;
+    auto it = typeReaders.find(typeId);
+    if (it != typeReaders.end())
+    {
+        for (int region : it->second)
+        {
+            changed += !regions[region].dirty;
+            regions[region].dirty = true;
+        }
+    }
+    return changed;
+}
+
+size_t DependencyTracker::invalidate(const std::vector<std::string> &symbols, const std::vector<int> &types)
+{
+    size_t changed = 0;
+    for (const std::string &id : symbols)
+    {
+        changed += invalidateSymbol(id);
+    }
+    for (int typeId : types)
+    {
+        changed += invalidateType(typeId);
+    }
+    return changed;
+}
+
+void DependencyTracker::invalidateRegion(const std::string &name)
+{
+    auto it = regionIndex.find(name);
+    if (it != regionIndex.end())
+    {
+        regions[it->second].dirty = true;
+    }
+}
+
+std::vector<std::string> DependencyTracker::dirtyRegions() const
+{
+    std::vector<std::string> result;
+    for (const Region &r : regions)
+    {
+        if (r.dirty)
+        {
+            result.push_back(r.name);
+        }
+    }
+    return result;
+}
+
+bool DependencyTracker::isDirty(const std::string &name) const
+{
+    auto it = regionIndex.find(name);
+    return it != regionIndex.end() && regions[it->second].dirty;
+}
+
+std::vector<std::string> DependencyTracker::symbolsReadBy(const std::string &name) const
+{
+    auto it = regionIndex.find(name);
+    if (it == regionIndex.end())
+    {
+        return {};
+    }
+    std::vector<std::string> result;
+    for (int symbol : regions[it->second].symbols)
+    {
+        result.push_back(symbolNames[symbol]);
+    }
+    return result;
+}
+
+std::vector<int> DependencyTracker::typesReadBy(const std::string &name) const
+{
+    auto it = regionIndex.find(name);
+    if (it == regionIndex.end())
+    {
+        return {};
+    }
+    const auto &types = regions[it->second].types;
+    return std::vector<int>(types.begin(), types.end());
+}
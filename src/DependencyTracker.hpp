@@ -0,0 +1,101 @@
+#pragma once
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/*
+ * Registro de dependencias para la re-comprobación incremental (modo watch).
+ *
+ * Una región es lo que se comprueba de una vez (normalmente una función). Mientras una
+ * región está abierta, SymbolTableStack anota cada id que se busca en el ámbito global
+ * (aunque no exista: si después se declara, la región debe revisarse) y TypeTable anota
+ * cada ID de tipo que se consulta. Tras editar unas cuantas declaraciones, invalidar esos
+ * ids marca como sucias solo las regiones que los leyeron.
+ *
+ * No es seguro entre hilos: una región se comprueba en un solo hilo.
+ */
+class DependencyTracker
+{
+private:
+    struct Region
+    {
+        std::string name;
+        std::unordered_set<int> symbols; // Ids globales leídos (índices en symbolNames)
+        std::unordered_set<int> types;   // IDs de tipo leídos
+        bool dirty = true;                        // Sin comprobar todavía, o invalidada
+    };
+
+    std::vector<Region> regions;
+    std::unordered_map<std::string, int> regionIndex;
+
+    // Ids globales internados: cada texto se copia una sola vez y las llaves de symbolIndex
+    // apuntan a symbolNames (el deque no mueve sus elementos). Así anotar un id ya visto
+    // no reserva memoria.
+    std::deque<std::string> symbolNames;
+    std::unordered_map<std::string_view, int> symbolIndex;
+    int intern(std::string_view id);
+
+    // Índices inversos: quién leyó cada id (symbolReaders por índice interno)
+    std::vector<std::vector<int>> symbolReaders;
+    std::unordered_map<int, std::vector<int>> typeReaders;
+
+    int current = -1; // Región abierta, -1 si no hay
+
+    // Los tipos y los ids se consultan en cada expresión: typeSeen[id] == epoch (o
+    // symbolSeen[índice]) indica que la región abierta ya lo anotó, sin tocar el conjunto
+    std::vector<unsigned> typeSeen;
+    std::vector<unsigned> symbolSeen;
+    unsigned epoch = 0;
+
+    // Borra las dependencias anotadas por una región (antes de volver a comprobarla)
+    void forget(int region);
+
+public:
+    // Abre una región (la crea si es nueva). Si ya existía, se olvida lo que había leído:
+    // la comprobación que empieza vuelve a anotarlo.
+    void beginRegion(const std::string &name);
+
+    // Cierra la región abierta y la marca como limpia
+    void endRegion();
+
+    // Anotaciones (no hacen nada si no hay región abierta)
+    void recordSymbol(std::string_view id);
+    void recordType(int typeId);
+
+    // Marca como sucias las regiones que leyeron estos ids; regresa cuántas cambiaron
+    size_t invalidateSymbol(const std::string &id);
+    size_t invalidateType(int typeId);
+    size_t invalidate(const std::vector<std::string> &symbols, const std::vector<int> &types);
+
+    // Marca como sucia una región (p. ej. porque se editó su propio cuerpo)
+    void invalidateRegion(const std::string &name);
+
+    // Regiones sucias en el orden en que se registraron
+    std::vector<std::string> dirtyRegions() const;
+
+    bool isDirty(const std::string &name) const;
+
+    // Vuelve a comprobar solo las regiones sucias: check(nombre) corre entre
+    // beginRegion y endRegion. Regresa cuántas regiones se comprobaron.
+    template <typename Fn>
+    size_t recheck(Fn check)
+    {
+        std::vector<std::string> pending = dirtyRegions();
+        for (const std::string &name : pending)
+        {
+            beginRegion(name);
+            check(name);
+            endRegion();
+        }
+        return pending.size();
+    }
+
+    size_t regionCount() const { return regions.size(); }
+
+    // Dependencias anotadas de una región (vacías si no existe)
+    std::vector<std::string> symbolsReadBy(const std::string &name) const;
+    std::vector<int> typesReadBy(const std::string &name) const;
+};
@@ -0,0 +1,136 @@
+#pragma once
+#include "HashPolicies.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/*
+ * Huellas de contenido de 128 bits para cachés entre ejecuciones.
+ *
+ * Solo dependen del contenido (nunca de direcciones, del orden de las cubetas ni de la
+ * política de hash de la tabla), así que la misma tabla da la misma huella en otra
+ * ejecución u otra máquina. No son criptográficas: sirven para detectar cambios, no para
+ * resistir entradas maliciosas.
+ *
+ * Dos formas de combinar:
+ * - FingerprintBuilder: secuencia, sensible al orden (una entrada, un tipo).
+ * - Fingerprint::operator+=: conjunto, sin orden y actualizable en O(1); cada mitad se suma
+ *   módulo 2^64, así que quitar un elemento es restar su huella.
+ */
+struct Fingerprint
+{
+    uint64_t lo = 0;
+    uint64_t hi = 0;
+
+    // Versión de 64 bits (cada mitad por sí sola ya es uniforme)
+    uint64_t value64() const { return lo; }
+
+    Fingerprint &operator+=(const Fingerprint &other)
+    {
+        lo += other.lo;
+        hi += other.hi;
+        return *this;
+    }
+    Fingerprint &operator-=(const Fingerprint &other)
+    {
+        lo -= other.lo;
+        hi -= other.hi;
+        return *this;
+    }
+
+    bool operator==(const Fingerprint &other) const { return lo == other.lo && hi == other.hi; }
+    bool operator!=(const Fingerprint &other) const { return !(*this == other); }
+    bool operator<(const Fingerprint &other) const { return hi != other.hi ? hi < other.hi : lo < other.lo; }
+
+    // 32 dígitos hexadecimales (hi y luego lo)
+    std::string toHex() const
+    {
+        static const char digits[] = "0123456789abcdef";
+        std::string text(32, '0');
+        for (int i = 0; i < 16; ++i)
+        {
+            text[15 - i] = digits[(hi >> (4 * i)) & 0xF];
+            text[31 - i] = digits[(lo >> (4 * i)) & 0xF];
+        }
+        return text;
+    }
+};
+
+// Para usar huellas como llave de unordered_map
+struct FingerprintHash
+{
+    size_t operator()(const Fingerprint &print) const { return static_cast<size_t>(print.lo); }
+};
+
+// Huella de una secuencia de valores: cada mitad es un carril independiente (semilla y
+// rotación distintas) que pasa por el mezclador biyectivo de MurmurHash3
+class FingerprintBuilder
+{
+private:
+    uint64_t lo = 0x243f6a8885a308d3ULL;
+    uint64_t hi = 0x13198a2e03707344ULL;
+
+    // Hasta 8 bytes leídos siempre como little-endian, para que la huella de una cadena no
+    // dependa del orden de bytes de la máquina (en x86/ARM el compilador lo reduce a una
+    // sola carga)
+    static uint64_t loadLittle(const char *data, size_t len)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < len; ++i)
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+        return value;
+    }
+
+public:
+    FingerprintBuilder &add(uint64_t value)
+    {
+        lo = mixHash(lo ^ value);
+        hi = mixHash(((hi << 29) | (hi >> 35)) ^ value ^ 0x9e3779b97f4a7c15ULL);
+        return *this;
+    }
+
+    FingerprintBuilder &add(int value) { return add(static_cast<uint64_t>(static_cast<int64_t>(value))); }
+
+    // Dos enteros de 32 bits en un solo paso
+    FingerprintBuilder &add(int first, int second)
+    {
+        return add((static_cast<uint64_t>(static_cast<uint32_t>(first)) << 32) | static_cast<uint32_t>(second));
+    }
+
+    // Las cadenas pasan una sola vez por los dos carriles (los bytes se leen una vez y las
+    // multiplicaciones de cada carril son independientes). La longitud entra al final, así
+    // que "ab","c" y "a","bc" difieren.
+    FingerprintBuilder &add(std::string_view text)
+    {
+        const uint64_t p0 = 0xa0761d6478bd642fULL;
+        const uint64_t p1 = 0xe7037ed1a0b428dbULL;
+        const char *data = text.data();
+        size_t len = text.size();
+        uint64_t a = lo ^ p0;
+        uint64_t b = hi ^ p1;
+
+        while (len >= 8)
+        {
+            uint64_t chunk = loadLittle(data, 8);
+            a = WyHash::mum(a ^ chunk, p1);
+            b = WyHash::mum(b ^ chunk, p0);
+            data += 8;
+            len -= 8;
+        }
+        uint64_t tail = loadLittle(data, len);
+        tail ^= static_cast<uint64_t>(text.size()) << 56;
+        lo = WyHash::mum(a ^ tail, p1 ^ text.size());
+        hi = WyHash::mum(b ^ tail, p0 ^ text.size());
+        return *this;
+    }
+
+    FingerprintBuilder &add(const Fingerprint &print)
+    {
+        lo = mixHash(lo ^ print.lo);
+        hi = mixHash(((hi << 29) | (hi >> 35)) ^ print.hi);
+        return *this;
+    }
+
+    Fingerprint result() const { return {lo, hi}; }
+};
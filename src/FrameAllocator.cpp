@@ -0,0 +1,75 @@
+#include "FrameAllocator.hpp"
+
+namespace
+{
+    // Redondea `value` hacia arriba al múltiplo de `align` (potencia de 2)
+    int alignUp(int value, int align)
+    {
+        return (value + align - 1) & ~(align - 1);
+    }
+}
+
+void FrameAllocator::beginFunction(const std::string &name)
+{
+    currentFunction = name;
+    scopeStarts.clear();
+    offset = 0;
+    peak = 0;
+    maxAlign = 1;
+}
+
+int FrameAllocator::endFunction()
+{
+    int size = frameSize();
+    frameSizes[currentFunction] = size;
+    currentFunction.clear();
+    scopeStarts.clear();
+    offset = 0;
+    peak = 0;
+    maxAlign = 1;
+    return size;
+}
+
+void FrameAllocator::enterScope()
+{
+    scopeStarts.push_back(offset);
+}
+
+// Regresa el desplazamiento al inicio del ámbito: sus bytes quedan libres para el siguiente
+void FrameAllocator::exitScope()
+{
+    if (scopeStarts.empty())
+        return;
+    offset = scopeStarts.back();
+    scopeStarts.pop_back();
+}
+
+int FrameAllocator::allocate(int typeId)
+{
+    int align = alignmentOf(typeId);
+    int address = alignUp(offset, align);
+
+    offset = address + typeTable->getSize(typeId);
+    if (offset > peak)
+        peak = offset;
+    if (align > maxAlign)
+        maxAlign = align;
+    return address;
+}
+
+// La regla vive en TypeTable para que los campos de estructura se acomoden igual
+int FrameAllocator::alignmentOf(int typeId) const
+{
+    return typeTable->alignmentOf(typeId);
+}
+
+int FrameAllocator::frameSize() const
+{
+    return alignUp(peak, maxAlign);
+}
+
+int FrameAllocator::frameSizeOf(const std::string &function) const
+{
+    auto it = frameSizes.find(function);
+    return it != frameSizes.end() ? it->second : -1;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include "TypeTable.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Asignador de direcciones del marco (frame) de cada función.
+ *
+ * Da a cada VAR/PARAM un desplazamiento alineado según el tamaño de su tipo en la
+ * TypeTable. Al cerrar un ámbito, su espacio se libera y lo reutilizan los ámbitos
+ * hermanos que vengan después (sus vidas no se traslapan), así que el marco mide lo
+ * que mide la rama más profunda de ámbitos y no la suma de todos.
+ *
+ * Se conecta a una SymbolTableStack con attachAllocator: pushScope/popScope abren y
+ * cierran ámbitos aquí, e insertTop asigna la dirección de las VAR/PARAM.
+ */
+class FrameAllocator
+{
+private:
+    const TypeTable *typeTable;
+
+    std::string currentFunction;
+    std::vector<int> scopeStarts; // Desplazamiento al abrir cada ámbito
+    int offset = 0;               // Siguiente byte libre
+    int peak = 0;                 // Máximo desplazamiento alcanzado en la función
+    int maxAlign = 1;             // Mayor alineación usada en la función
+
+    std::unordered_map<std::string, int> frameSizes;
+
+public:
+    explicit FrameAllocator(const TypeTable &tt) : typeTable(&tt) {}
+
+    // Empieza el marco de una función (desplazamiento 0)
+    void beginFunction(const std::string &name);
+
+    // Termina la función actual; regresa el tamaño del marco (múltiplo de la mayor alineación)
+    int endFunction();
+
+    // Ámbitos anidados dentro de la función
+    void enterScope();
+    void exitScope();
+
+    // Reserva espacio para un valor del tipo dado y regresa su desplazamiento alineado
+    int allocate(int typeId);
+
+    // Alineación de un tipo (ver TypeTable::alignmentOf)
+    int alignmentOf(int typeId) const;
+
+    // Tamaño del marco de la función actual hasta ahora
+    int frameSize() const;
+
+    // Tamaño de marco reportado por endFunction, o -1 si la función no existe
+    int frameSizeOf(const std::string &function) const;
+};
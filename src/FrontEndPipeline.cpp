@@ -0,0 +1,288 @@
+#include "FrontEndPipeline.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+FrontEndPipeline::FrontEndPipeline(SymbolTableStack& symbolStack, const TypeManager& typeManager,
+                                   CodeGenerator& generator, PipelineOptions pipelineOptions)
+    : symbols(symbolStack), manager(typeManager), gen(generator), options(pipelineOptions) {
+    if (options.batchEvents == 0) {
+        options.batchEvents = 1;
+    }
+}
+
+FrontEndPipeline::~FrontEndPipeline() {
+    abort();
+}
+
+// --- Etapa 1: declaraciones y resolución de nombres ---
+void FrontEndPipeline::declare(FrontEndEvent& event) {
+    switch (event.kind) {
+    case FrontEndEventKind::BEGIN_FUNCTION:
+    case FrontEndEventKind::DECLARE: {
+        if (symbols.levels() == 0) {
+            throw std::runtime_error("Declaración fuera de todo ámbito: " + event.text);
+        }
+        Category category = event.kind == FrontEndEventKind::DECLARE ? event.category : Category::FUNCTION;
+        if (!symbols.insertTop({event.text, event.typeId, category, 0, {}})) {
+            throw std::runtime_error("Redeclaración de " + event.text);
+        }
+        if (event.kind == FrontEndEventKind::BEGIN_FUNCTION) {
+            symbols.pushScope();
+        }
+        break;
+    }
+    case FrontEndEventKind::OPEN_SCOPE:
+        symbols.pushScope();
+        break;
+    case FrontEndEventKind::END_FUNCTION:
+    case FrontEndEventKind::CLOSE_SCOPE:
+        if (symbols.levels() <= baseLevels) {
+            throw std::runtime_error("Se cerró un ámbito que no estaba abierto");
+        }
+        symbols.popScope();
+        break;
+    case FrontEndEventKind::LOAD:
+    case FrontEndEventKind::ASSIGN: {
+        const SymbolEntry* entry = symbols.find(event.text);
+        if (!entry) {
+            throw SymbolNotFoundError(event.text);
+        }
+        event.typeId = entry->typeId;
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// --- Etapa 2: comprobación de tipos ---
+void FrontEndPipeline::check(FrontEndEvent& event) {
+    switch (event.kind) {
+    case FrontEndEventKind::LOAD:
+    case FrontEndEventKind::CONSTANT:
+        typeStack.push_back(event.typeId);
+        break;
+    case FrontEndEventKind::BINARY: {
+        if (typeStack.size() < 2) {
+            throw std::runtime_error("Faltan operandos para " + event.text);
+        }
+        event.rightType = typeStack.back();
+        typeStack.pop_back();
+        event.leftType = typeStack.back();
+        event.typeId = manager.max(event.leftType, event.rightType);
+        typeStack.back() = event.typeId;
+        break;
+    }
+    case FrontEndEventKind::ASSIGN:
+        if (typeStack.empty()) {
+            throw std::runtime_error("Falta el valor asignado a " + event.text);
+        }
+        event.leftType = typeStack.back();
+        typeStack.pop_back();
+        if (!manager.isValidConversion(event.leftType, event.typeId, true)) {
+            throw std::runtime_error("Asignación inválida a " + event.text);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// --- Etapa 3: código intermedio ---
+void FrontEndPipeline::lower(FrontEndEvent& event) {
+    switch (event.kind) {
+    case FrontEndEventKind::BEGIN_FUNCTION:
+        gen.endBlock();
+        gen.beginFunction(event.text);
+        break;
+    case FrontEndEventKind::END_FUNCTION:
+        gen.endFunction();
+        gen.endBlock();
+        break;
+    case FrontEndEventKind::END_BLOCK:
+        gen.endBlock();
+        break;
+    case FrontEndEventKind::LOAD:
+    case FrontEndEventKind::CONSTANT:
+        valueStack.push_back(std::move(event.text));
+        break;
+    case FrontEndEventKind::BINARY: {
+        std::string right = manager.ampliar(valueStack.back(), event.rightType, event.typeId, gen);
+        valueStack.pop_back();
+        std::string left = manager.ampliar(valueStack.back(), event.leftType, event.typeId, gen);
+        std::string temp = gen.newTemp();
+        gen.emit(event.text, left, right, temp);
+        valueStack.back() = std::move(temp);
+        break;
+    }
+    case FrontEndEventKind::ASSIGN: {
+        std::string value = manager.ampliar(valueStack.back(), event.leftType, event.typeId, gen);
+        valueStack.pop_back();
+        gen.emit("=", value, "", event.text);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+FrontEndPipeline::Batch FrontEndPipeline::takeBatch() {
+    std::lock_guard<std::mutex> lock(spareMutex);
+    if (spare.empty()) {
+        Batch batch;
+        batch.reserve(std::min<size_t>(options.batchEvents, 4096)); // Lotes enormes crecen solos
+        return batch;
+    }
+    Batch batch = std::move(spare.back());
+    spare.pop_back();
+    return batch;
+}
+
+void FrontEndPipeline::recycle(Batch batch) {
+    batch.clear();
+    std::lock_guard<std::mutex> lock(spareMutex);
+    spare.push_back(std::move(batch));
+}
+
+void FrontEndPipeline::stageLoop(int stage, BoundedQueue<Batch>& in, BoundedQueue<Batch>* out,
+                                 void (FrontEndPipeline::*step)(FrontEndEvent&)) {
+    Batch batch;
+    size_t index = 0; // Cada etapa ve los eventos en el orden del flujo
+    try {
+        while (in.pop(batch)) {
+            for (FrontEndEvent& event : batch) {
+                (this->*step)(event);
+                ++index;
+            }
+            if (out) {
+                if (!out->push(std::move(batch))) {
+                    break; // La etapa siguiente falló
+                }
+            } else {
+                completed(batch.size());
+                recycle(std::move(batch));
+            }
+        }
+    } catch (...) {
+        errors[stage] = std::current_exception();
+        errorEvents[stage] = index;
+    }
+    // Al terminar (o fallar) se avisa a ambos lados: la etapa anterior deja de empujar y
+    // la siguiente vacía lo que tenga y termina
+    in.close();
+    if (out) {
+        out->close();
+    }
+}
+
+void FrontEndPipeline::begin() {
+    // Con hilos, tipos y código consultan la TypeTable a la vez y cada consulta se anota en
+    // el registro de dependencias, que no es seguro entre hilos
+    if (options.threaded && manager.getTypeTable().dependencyTracker()) {
+        throw std::logic_error("FrontEndPipeline con hilos no admite una TypeTable con DependencyTracker");
+    }
+    abort(); // Por si una corrida anterior quedó a medias
+    running = true;
+    baseLevels = symbols.levels();
+    typeStack.clear();
+    valueStack.clear();
+    stats = PipelineStats();
+    inFlight = 0;
+    peak = 0;
+    for (auto& error : errors) {
+        error = nullptr;
+    }
+    if (!options.threaded) {
+        return;
+    }
+
+    toDeclare = std::make_unique<BoundedQueue<Batch>>(options.queueBatches);
+    toCheck = std::make_unique<BoundedQueue<Batch>>(options.queueBatches);
+    toLower = std::make_unique<BoundedQueue<Batch>>(options.queueBatches);
+    workers.emplace_back([this] { stageLoop(0, *toDeclare, toCheck.get(), &FrontEndPipeline::declare); });
+    workers.emplace_back([this] { stageLoop(1, *toCheck, toLower.get(), &FrontEndPipeline::check); });
+    workers.emplace_back([this] { stageLoop(2, *toLower, nullptr, &FrontEndPipeline::lower); });
+}
+
+bool FrontEndPipeline::submit(Batch batch) {
+    size_t count = batch.size();
+    stats.events += count;
+    ++stats.batches;
+    size_t now = inFlight += count;
+    size_t seen = peak.load();
+    while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+    }
+
+    if (options.threaded) {
+        return toDeclare->push(std::move(batch));
+    }
+    for (FrontEndEvent& event : batch) {
+        declare(event);
+    }
+    for (FrontEndEvent& event : batch) {
+        check(event);
+    }
+    for (FrontEndEvent& event : batch) {
+        lower(event);
+    }
+    completed(count);
+    recycle(std::move(batch));
+    return true;
+}
+
+PipelineStats FrontEndPipeline::finish() {
+    if (toDeclare) {
+        toDeclare->close();
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    toDeclare.reset();
+    toCheck.reset();
+    toLower.reset();
+
+    // Sin hilos el primer evento que falla detiene todo; con hilos una etapa posterior
+    // pudo fallar antes en el tiempo pero más tarde en el flujo
+    int first = -1;
+    for (int stage = 0; stage < 3; ++stage) {
+        if (errors[stage] && (first < 0 || errorEvents[stage] < errorEvents[first])) {
+            first = stage;
+        }
+    }
+    if (first >= 0) {
+        std::exception_ptr error = errors[first];
+        abort();
+        std::rethrow_exception(error);
+    }
+    if (symbols.levels() != baseLevels) {
+        abort();
+        throw std::runtime_error("Quedaron ámbitos sin cerrar al terminar el flujo");
+    }
+    running = false;
+    stats.peakBufferedEvents = peak;
+    return stats;
+}
+
+// Detiene las etapas y deja la pila de símbolos como estaba al empezar
+void FrontEndPipeline::abort() {
+    for (auto* queue : {toDeclare.get(), toCheck.get(), toLower.get()}) {
+        if (queue) {
+            queue->close();
+        }
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    toDeclare.reset();
+    toCheck.reset();
+    toLower.reset();
+    for (auto& error : errors) {
+        error = nullptr;
+    }
+    while (running && symbols.levels() > baseLevels) {
+        symbols.popScope();
+    }
+    running = false;
+}
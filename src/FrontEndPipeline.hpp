@@ -0,0 +1,165 @@
+#pragma once
+#include "BoundedQueue.hpp"
+#include "CodeGenerator.hpp"
+#include "SymbolTableStack.hpp"
+#include "TypeManager.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Eventos que produce el analizador sintáctico, en el orden del programa. Las
+ * expresiones llegan en postfijo: `x = a + b * c` es LOAD a, LOAD b, LOAD c, BINARY *,
+ * BINARY +, ASSIGN x.
+ */
+enum class FrontEndEventKind : uint8_t {
+    BEGIN_FUNCTION, // text: nombre, typeId: tipo de retorno; abre el ámbito de la función
+    END_FUNCTION,
+    OPEN_SCOPE,
+    CLOSE_SCOPE,
+    DECLARE,        // text: nombre, typeId, category
+    LOAD,           // Apila el valor de la variable `text`
+    CONSTANT,       // Apila el literal `text` de tipo typeId
+    BINARY,         // Desapila dos operandos y apila `left text right`
+    ASSIGN,         // Desapila un valor y lo guarda en la variable `text`
+    END_BLOCK       // Fin de bloque básico (ver CodeGenerator::endBlock)
+};
+
+struct FrontEndEvent {
+    FrontEndEventKind kind;
+    std::string text;                  // Nombre, operador o literal según kind
+    int typeId = -1;                   // DECLARE/CONSTANT/BEGIN_FUNCTION: tipo dado. Tras las
+                                       // declaraciones, LOAD/ASSIGN llevan el de la variable;
+                                       // tras la comprobación, BINARY lleva el del resultado
+    Category category = Category::VAR; // Solo DECLARE
+    int leftType = -1;                 // BINARY: operando izquierdo; ASSIGN: el valor (los llena la comprobación)
+    int rightType = -1;                // BINARY: operando derecho
+};
+
+struct PipelineOptions {
+    size_t batchEvents = 256; // Eventos por lote: lo que una etapa procesa antes de pasarlo
+    size_t queueBatches = 4;  // Lotes que caben entre dos etapas (solo con hilos)
+    bool threaded = false;    // Un hilo por etapa; si no, las tres etapas en el hilo que llama.
+                              // Las etapas de tipos y código leen la TypeTable a la vez, así
+                              // que no se admite con un DependencyTracker conectado a ella
+};
+
+struct PipelineStats {
+    size_t events = 0;
+    size_t batches = 0;
+    // Máximo de eventos leídos de la fuente y aún no terminados. Sin hilos es batchEvents;
+    // con hilos a lo más batchEvents * (3 * queueBatches + 4)
+    size_t peakBufferedEvents = 0;
+};
+
+/**
+ * Front-end en tres etapas que se traslapan sobre un flujo de eventos, sin guardar el
+ * programa completo en memoria:
+ *
+ * 1. Declaraciones: los eventos de ámbito hacen push/pop en la SymbolTableStack, DECLARE
+ *    inserta en el tope y cada uso se resuelve a su tipo.
+ * 2. Tipos: con el TypeManager calcula el tipo de cada operación (max) y valida las
+ *    asignaciones (conversión implícita).
+ * 3. Código: emite los cuádruplos en el CodeGenerator, con las conversiones implícitas
+ *    de TypeManager::ampliar.
+ *
+ * Los eventos avanzan por lotes de batchEvents. Sin hilos cada lote pasa por las tres
+ * etapas antes de leer el siguiente (sigue caliente en caché). Con hilos cada etapa corre
+ * en el suyo y las une una BoundedQueue de queueBatches lotes. En ambos casos lo que hay en
+ * tránsito está acotado.
+ *
+ * El primer error (SymbolNotFoundError, std::runtime_error del TypeManager...) detiene
+ * todo y se relanza desde run. Con hilos varias etapas pueden fallar; se relanza el del
+ * evento más temprano del flujo, el mismo que sin hilos. La pila de símbolos regresa a
+ * los niveles que tenía al empezar.
+ */
+class FrontEndPipeline {
+private:
+    using Batch = std::vector<FrontEndEvent>;
+
+    SymbolTableStack& symbols;
+    const TypeManager& manager;
+    CodeGenerator& gen;
+    PipelineOptions options;
+
+    // Estado de cada etapa (con hilos, cada uno solo lo toca su etapa)
+    bool running = false;
+    size_t baseLevels = 0;
+    std::vector<int> typeStack;          // Tipos de la expresión en curso
+    std::vector<std::string> valueStack; // Direcciones de la expresión en curso
+
+    void declare(FrontEndEvent& event);
+    void check(FrontEndEvent& event);
+    void lower(FrontEndEvent& event);
+
+    // Lotes vacíos que se reutilizan (conservan su capacidad)
+    std::mutex spareMutex;
+    std::vector<Batch> spare;
+    Batch takeBatch();
+    void recycle(Batch batch);
+
+    // Conteo de eventos en tránsito
+    PipelineStats stats;
+    std::atomic<size_t> inFlight{0};
+    std::atomic<size_t> peak{0};
+    void completed(size_t count) { inFlight -= count; }
+
+    // Modo con hilos: fuente -> declaraciones -> tipos -> código
+    std::unique_ptr<BoundedQueue<Batch>> toDeclare, toCheck, toLower;
+    std::vector<std::thread> workers;
+    std::exception_ptr errors[3];
+    size_t errorEvents[3] = {}; // Índice en el flujo del evento que falló en cada etapa
+    void stageLoop(int stage, BoundedQueue<Batch>& in, BoundedQueue<Batch>* out,
+                   void (FrontEndPipeline::*step)(FrontEndEvent&));
+
+    void begin();
+    bool submit(Batch batch); // false si el pipeline ya falló
+    PipelineStats finish();
+    void abort();
+
+public:
+    FrontEndPipeline(SymbolTableStack& symbolStack, const TypeManager& typeManager, CodeGenerator& generator,
+                     PipelineOptions pipelineOptions = {});
+    ~FrontEndPipeline();
+
+    FrontEndPipeline(const FrontEndPipeline&) = delete;
+    FrontEndPipeline& operator=(const FrontEndPipeline&) = delete;
+
+    /**
+     * Procesa todo el flujo.
+     *
+     * @param next Callable (FrontEndEvent&) -> bool que llena el siguiente evento y
+     *             regresa false al terminar (p. ej. el analizador sintáctico)
+     * @return Eventos, lotes y máximo de eventos en tránsito
+     * @throws El primer error de cualquier etapa, o std::runtime_error si al final quedan
+     *         ámbitos sin cerrar, o std::logic_error si threaded y la TypeTable tiene un
+     *         DependencyTracker (no es seguro anotar desde dos hilos)
+     */
+    template <typename Source>
+    PipelineStats run(Source next) {
+        begin();
+        try {
+            bool more = true;
+            while (more) {
+                Batch batch = takeBatch();
+                FrontEndEvent event;
+                while (batch.size() < options.batchEvents && (more = next(event))) {
+                    batch.push_back(std::move(event));
+                }
+                if (batch.empty() || !submit(std::move(batch))) {
+                    break;
+                }
+            }
+        } catch (...) {
+            abort();
+            throw;
+        }
+        return finish();
+    }
+};
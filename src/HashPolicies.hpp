@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/*
+ * Políticas de hash para BasicSymbolTable.
+ *
+ * Cada política es un tipo sin estado con
+ *     static uint64_t hash(std::string_view key, uint64_t seed);
+ * La semilla 0 es la que usan las tablas normales; PerfectHashStorage y el filtro de
+ * Bloom derivan todo lo demás de ese mismo hash, así que cada id se hashea una vez.
+ */
+
+// Mezclador final de 64 bits (fmix64 de MurmurHash3)
+inline uint64_t mixHash(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// std::hash de la biblioteca estándar
+struct StdHash
+{
+    static uint64_t hash(std::string_view key, uint64_t seed)
+    {
+        uint64_t h = std::hash<std::string_view>{}(key);
+        return seed ? mixHash(h ^ seed) : h;
+    }
+};
+
+// FNV-1a de 64 bits: muy simple, bueno para ids cortos (etiquetas, palabras clave)
+struct FnvHash
+{
+    static uint64_t hash(std::string_view key, uint64_t seed)
+    {
+        uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+        for (unsigned char c : key)
+        {
+            h ^= c;
+            h *= 0x100000001b3ULL;
+        }
+        return h;
+    }
+};
+
+// Hash al estilo wyhash: procesa 8 bytes por paso con multiplicación de 128 bits
+struct WyHash
+{
+    // Mitad baja XOR mitad alta del producto de 128 bits armado con productos parciales
+    // de 32 bits; para compiladores sin __int128 (MSVC, 32 bits)
+    static uint64_t mumPortable(uint64_t a, uint64_t b)
+    {
+        uint64_t aLo = a & 0xFFFFFFFFULL, aHi = a >> 32;
+        uint64_t bLo = b & 0xFFFFFFFFULL, bHi = b >> 32;
+        uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+        uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFULL) + (hl & 0xFFFFFFFFULL);
+        uint64_t low = (mid << 32) | (ll & 0xFFFFFFFFULL);
+        uint64_t high = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+        return low ^ high;
+    }
+
+    static uint64_t mum(uint64_t a, uint64_t b)
+    {
+#ifdef __SIZEOF_INT128__
+        __uint128_t r = static_cast<__uint128_t>(a) * b;
+        return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+        return mumPortable(a, b);
+#endif
+    }
+
+    static uint64_t hash(std::string_view key, uint64_t seed)
+    {
+        const uint64_t p0 = 0xa0761d6478bd642fULL;
+        const uint64_t p1 = 0xe7037ed1a0b428dbULL;
+        const uint64_t p2 = 0x8ebc6af09c88c6e3ULL;
+
+        const char *data = key.data();
+        size_t len = key.size();
+        uint64_t h = seed ^ p0;
+
+        while (len >= 8)
+        {
+            uint64_t chunk;
+            std::memcpy(&chunk, data, 8);
+            h = mum(h ^ chunk, p1);
+            data += 8;
+            len -= 8;
+        }
+
+        // Últimos 0..7 bytes
+        uint64_t tail = 0;
+        std::memcpy(&tail, data, len);
+        h = mum(h ^ tail ^ (static_cast<uint64_t>(len) << 56), p2);
+        return mum(h ^ key.size(), p0);
+    }
+};
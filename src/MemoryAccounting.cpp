@@ -0,0 +1,47 @@
+#include "MemoryAccounting.hpp"
+#include <atomic>
+
+namespace
+{
+    std::atomic<size_t> live[static_cast<int>(MemoryCategory::COUNT)];
+    std::atomic<size_t> liveTotal{0};
+    std::atomic<size_t> peak{0};
+}
+
+void countAllocation(MemoryCategory category, size_t bytes)
+{
+    live[static_cast<int>(category)].fetch_add(bytes, std::memory_order_relaxed);
+    size_t now = liveTotal.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t seen = peak.load(std::memory_order_relaxed);
+    while (now > seen && !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed))
+    {
+    }
+}
+
+void countDeallocation(MemoryCategory category, size_t bytes)
+{
+    live[static_cast<int>(category)].fetch_sub(bytes, std::memory_order_relaxed);
+    liveTotal.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+MemoryUsage trackedMemory()
+{
+    MemoryUsage usage;
+    usage.keys = live[static_cast<int>(MemoryCategory::KEYS)].load(std::memory_order_relaxed);
+    usage.entries = live[static_cast<int>(MemoryCategory::ENTRIES)].load(std::memory_order_relaxed);
+    usage.buckets = live[static_cast<int>(MemoryCategory::BUCKETS)].load(std::memory_order_relaxed);
+    usage.params = live[static_cast<int>(MemoryCategory::PARAMS)].load(std::memory_order_relaxed);
+    usage.names = live[static_cast<int>(MemoryCategory::NAMES)].load(std::memory_order_relaxed);
+    return usage;
+}
+
+size_t memoryHighWaterMark()
+{
+    return peak.load(std::memory_order_relaxed);
+}
+
+// El máximo vuelve a empezar desde lo que está vivo ahora
+void resetMemoryHighWaterMark()
+{
+    peak.store(liveTotal.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
@@ -0,0 +1,198 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * Contabilidad de memoria de las estructuras auxiliares del compilador.
+ *
+ * - memoryUsage() de cada estructura regresa un MemoryUsage con los bytes que ocupa esa
+ *   instancia, por categoría (calculado con las capacidades de sus contenedores).
+ * - CountingAllocator se conecta a los contenedores internos (bloques de entradas,
+ *   índices, filtros, tablas de tipos) y lleva un contador global por categoría con
+ *   su marca de máximo (high-water mark). El texto de los ids y los params de cada
+ *   SymbolEntry y los nombres de tipos son CountedString/CountedVector: también pasan por
+ *   CountingAllocator (KEYS, PARAMS, NAMES) y reservan en el recurso de su tabla.
+ * - CountingAllocator pide la memoria a un std::pmr::memory_resource (por omisión el
+ *   recurso por defecto del proceso). SymbolTable, SymbolTableStack y TypeTable aceptan
+ *   un recurso en su constructor y lo pasan a todos sus contenedores internos y a los
+ *   objetos que crean (makeInResource), así una sesión de compilación puede vivir en un
+ *   monotonic_buffer_resource y liberarse de una vez.
+ */
+
+enum class MemoryCategory
+{
+    KEYS,    // Texto de los ids que no cabe en la cadena (fuera de SSO)
+    ENTRIES, // Arreglos de entradas
+    BUCKETS, // Índices hash, hashes guardados, filtros de Bloom
+    PARAMS,  // Listas de parámetros de SymbolEntry
+    NAMES,   // Nombres internados de tipos
+    COUNT
+};
+
+struct MemoryUsage
+{
+    size_t keys = 0;
+    size_t entries = 0;
+    size_t buckets = 0;
+    size_t params = 0;
+    size_t names = 0;
+    size_t recycled = 0; // Tablas de ámbitos cerrados que SymbolTableStack conserva
+
+    size_t total() const { return keys + entries + buckets + params + names + recycled; }
+
+    MemoryUsage &operator+=(const MemoryUsage &other)
+    {
+        keys += other.keys;
+        entries += other.entries;
+        buckets += other.buckets;
+        params += other.params;
+        names += other.names;
+        recycled += other.recycled;
+        return *this;
+    }
+};
+
+// Contadores globales (seguros entre hilos)
+void countAllocation(MemoryCategory category, size_t bytes);
+void countDeallocation(MemoryCategory category, size_t bytes);
+
+// Bytes vivos reservados por CountingAllocator, por categoría
+MemoryUsage trackedMemory();
+
+// Máximo de bytes vivos (todas las categorías) desde el inicio o el último reset
+size_t memoryHighWaterMark();
+void resetMemoryHighWaterMark();
+
+// Asignador que cuenta en la categoría C y reserva en un memory_resource
+template <typename T, MemoryCategory C>
+class CountingAllocator
+{
+private:
+    std::pmr::memory_resource *source;
+
+    template <typename U, MemoryCategory D>
+    friend class CountingAllocator;
+
+public:
+    using value_type = T;
+    // El recurso viaja con el contenido al mover o intercambiar contenedores
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = CountingAllocator<U, C>;
+    };
+
+    CountingAllocator() noexcept : source(std::pmr::get_default_resource()) {}
+    CountingAllocator(std::pmr::memory_resource *resource) noexcept : source(resource) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U, C> &other) noexcept : source(other.source) {}
+
+    // Igual que polymorphic_allocator: la copia de un contenedor no hereda el recurso (una
+    // entrada copiada fuera de su tabla no depende de la arena de la tabla)
+    CountingAllocator select_on_container_copy_construction() const { return CountingAllocator(); }
+
+    std::pmr::memory_resource *resource() const { return source; }
+
+    T *allocate(size_t n)
+    {
+        T *p = static_cast<T *>(source->allocate(n * sizeof(T), alignof(T)));
+        countAllocation(C, n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T *p, size_t n)
+    {
+        countDeallocation(C, n * sizeof(T));
+        source->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U, C> &other) const { return source == other.source || source->is_equal(*other.source); }
+    template <typename U>
+    bool operator!=(const CountingAllocator<U, C> &other) const { return !(*this == other); }
+};
+
+// Cadena y arreglo contados en la categoría C, en el recurso de su asignador
+template <MemoryCategory C>
+using CountedString = std::basic_string<char, std::char_traits<char>, CountingAllocator<char, C>>;
+template <typename T, MemoryCategory C>
+using CountedVector = std::vector<T, CountingAllocator<T, C>>;
+
+// Destruye un objeto creado con makeInResource y devuelve su memoria al mismo recurso
+template <typename T>
+struct ResourceDeleter
+{
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource();
+
+    void operator()(T *object) const
+    {
+        if (resource == std::pmr::new_delete_resource())
+        {
+            delete object;
+            return;
+        }
+        object->~T();
+        resource->deallocate(object, sizeof(T), alignof(T));
+    }
+};
+
+// Dueño de un objeto que vive en un memory_resource (como unique_ptr, sin el heap global)
+template <typename T>
+using ResourcePtr = std::unique_ptr<T, ResourceDeleter<T>>;
+
+// Con new_delete_resource el objeto se crea con new: un puntero cedido con release() se
+// puede liberar con delete
+template <typename T, typename... Args>
+ResourcePtr<T> makeInResource(std::pmr::memory_resource *resource, Args &&...args)
+{
+    if (resource == std::pmr::new_delete_resource())
+    {
+        return ResourcePtr<T>(new T(std::forward<Args>(args)...), ResourceDeleter<T>{resource});
+    }
+    void *memory = resource->allocate(sizeof(T), alignof(T));
+    try
+    {
+        return ResourcePtr<T>(new (memory) T(std::forward<Args>(args)...), ResourceDeleter<T>{resource});
+    }
+    catch (...)
+    {
+        resource->deallocate(memory, sizeof(T), alignof(T));
+        throw;
+    }
+}
+
+// -----------------------------------------
+// Estimaciones de bytes por contenedor
+// -----------------------------------------
+
+// Parte de la cadena que vive en el heap (0 si cabe en el búfer interno, SSO). El tamaño
+// del búfer interno es la capacidad de una cadena vacía.
+template <typename Char, typename Traits, typename Alloc>
+size_t stringHeapBytes(const std::basic_string<Char, Traits, Alloc> &text)
+{
+    static const size_t inlineCapacity = std::basic_string<Char, Traits, Alloc>().capacity();
+    return text.capacity() > inlineCapacity ? (text.capacity() + 1) * sizeof(Char) : 0;
+}
+
+template <typename T, typename A>
+size_t vectorBytes(const std::vector<T, A> &v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+// Cubetas más nodos de un unordered_map/unordered_set (nodo: siguiente, valor, hash)
+template <typename Map>
+size_t hashMapBytes(const Map &map)
+{
+    return map.bucket_count() * sizeof(void *) +
+           map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void *));
+}
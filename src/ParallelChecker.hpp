@@ -0,0 +1,69 @@
+#pragma once
+#include "SymbolTableStack.hpp"
+#include "WorkStealingPool.hpp"
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Comprobación semántica en paralelo de cuerpos de función independientes.
+ *
+ * Una vez completo el ámbito global, se congela (SymbolTableStack::freezeBase) y cada
+ * cuerpo de función se revisa con su propia pila local montada sobre ese global de
+ * solo lectura. Los cuerpos se reparten en una WorkStealingPool.
+ *
+ * Los resultados se regresan en el mismo orden que los cuerpos de entrada, y si alguna
+ * comprobación lanza, se relanza la excepción del primer cuerpo (en orden) que falló,
+ * igual que lo haría la comprobación secuencial.
+ */
+class ParallelChecker
+{
+private:
+    std::shared_ptr<const SymbolTable> global;
+    WorkStealingPool &pool;
+
+public:
+    /**
+     * @param frozenGlobal Ámbito global congelado, compartido por todos los hilos
+     * @param workers Alberca de hilos donde se ejecutan las comprobaciones
+     */
+    ParallelChecker(std::shared_ptr<const SymbolTable> frozenGlobal, WorkStealingPool &workers)
+        : global(std::move(frozenGlobal)), pool(workers) {}
+
+    /**
+     * Revisa todos los cuerpos en paralelo.
+     *
+     * @param bodies Cuerpos de función a revisar
+     * @param check Callable (const Body&, SymbolTableStack&) -> Result. Recibe una pila
+     *              nueva cuyo único nivel es el global congelado.
+     * @return Resultados en el orden de `bodies`
+     */
+    template <typename Body, typename Check>
+    auto checkAll(const std::vector<Body> &bodies, Check check)
+        -> std::vector<std::invoke_result_t<Check &, const Body &, SymbolTableStack &>>
+    {
+        return collectInOrder(pool, bodies.size(), [this, &bodies, &check](size_t i)
+                              {
+                                  SymbolTableStack local(global);
+                                  return check(bodies[i], local); });
+    }
+
+    /**
+     * Versión secuencial de referencia: mismos resultados que checkAll.
+     */
+    template <typename Body, typename Check>
+    auto checkSequential(const std::vector<Body> &bodies, Check check)
+        -> std::vector<std::invoke_result_t<Check &, const Body &, SymbolTableStack &>>
+    {
+        using Result = std::invoke_result_t<Check &, const Body &, SymbolTableStack &>;
+
+        std::vector<Result> results;
+        results.reserve(bodies.size());
+        for (const auto &body : bodies)
+        {
+            SymbolTableStack local(global);
+            results.push_back(check(body, local));
+        }
+        return results;
+    }
+};
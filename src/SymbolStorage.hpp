@@ -0,0 +1,636 @@
+#pragma once
+#include "HashPolicies.hpp"
+#include "MemoryAccounting.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * Políticas de almacenamiento para BasicSymbolTable.
+ *
+ * Cada almacenamiento es una plantilla <Key, Entry, HashPolicy> con:
+ *     std::pair<const Entry *, bool> insert(const Entry &, uint64_t hash);
+ *     const Entry *find(std::string_view key, uint64_t hash) const;
+ *     void clear();            // conserva la memoria reservada
+ *     size_t size() const;
+ *     void forEach(Fn) const;
+ *     const_iterator begin() const, end() const; // recorre las entradas sin copiarlas
+ *     MemoryUsage memoryUsage() const;
+ *     explicit Storage(std::pmr::memory_resource *); // de ahí sale toda su memoria
+ *     static constexpr bool stablePointers; // ¿los punteros sobreviven a insert?
+ * `hash` es HashPolicy::hash(key, 0), calculado una sola vez por BasicSymbolTable.
+ * insert guarda entryCopy(entry, recurso): las entradas con cadenas o listas std::pmr
+ * quedan completas en el recurso del almacenamiento.
+ */
+
+// Llave de una entrada: por defecto su campo id. Se especializa para otras entradas.
+template <typename Entry>
+struct EntryKey
+{
+    static const auto &of(const Entry &entry) { return entry.id; }
+};
+
+// Memoria de una entrada fuera de su arreglo (cadenas, listas). Las entradas con heap
+// propio (SymbolEntry) sobrecargan esta función; se encuentra por ADL.
+template <typename Entry>
+void addEntryHeapUsage(const Entry &, MemoryUsage &)
+{
+}
+
+// Copia de una entrada para guardarla en un almacenamiento que reserva en `resource`.
+// Las entradas con contenedores std::pmr (SymbolEntry) sobrecargan esta función para
+// construirlos en ese recurso; se encuentra por ADL.
+template <typename Entry>
+Entry entryCopy(const Entry &entry, std::pmr::memory_resource *)
+{
+    return entry;
+}
+
+// Contenedores internos contados por CountingAllocator
+template <typename Entry>
+using EntryVector = std::vector<Entry, CountingAllocator<Entry, MemoryCategory::ENTRIES>>;
+template <typename T>
+using BucketVector = std::vector<T, CountingAllocator<T, MemoryCategory::BUCKETS>>;
+
+// Adaptador de una política de hash al Hash de la biblioteca estándar
+template <typename HashPolicy>
+struct StdHashAdapter
+{
+    template <typename Key>
+    size_t operator()(const Key &key) const { return HashPolicy::hash(key, 0); }
+};
+
+// -----------------------------------------
+// Tabla de nodos (std::unordered_map)
+// -----------------------------------------
+// Punteros estables: lo que necesita SymbolTableStack, que regresa SymbolEntry*.
+template <typename Key, typename Entry, typename HashPolicy>
+class NodeMapStorage
+{
+private:
+    using Map = std::unordered_map<Key, Entry, StdHashAdapter<HashPolicy>, std::equal_to<Key>,
+                                   CountingAllocator<std::pair<const Key, Entry>, MemoryCategory::ENTRIES>>;
+    Map table;
+
+public:
+    static constexpr bool stablePointers = true;
+
+    explicit NodeMapStorage(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : table(typename Map::allocator_type(resource)) {}
+
+    // Iterador sobre los valores del mapa (sin la llave)
+    class const_iterator
+    {
+    private:
+        typename Map::const_iterator it;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry *;
+        using reference = const Entry &;
+
+        const_iterator() = default;
+        explicit const_iterator(decltype(it) i) : it(i) {}
+
+        reference operator*() const { return it->second; }
+        pointer operator->() const { return &it->second; }
+        const_iterator &operator++()
+        {
+            ++it;
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++it;
+            return old;
+        }
+        bool operator==(const const_iterator &other) const { return it == other.it; }
+        bool operator!=(const const_iterator &other) const { return it != other.it; }
+    };
+
+    const_iterator begin() const { return const_iterator(table.begin()); }
+    const_iterator end() const { return const_iterator(table.end()); }
+
+    std::pair<const Entry *, bool> insert(const Entry &entry, uint64_t)
+    {
+        auto [it, inserted] = table.emplace(EntryKey<Entry>::of(entry), entryCopy(entry, table.get_allocator().resource()));
+        return {&it->second, inserted};
+    }
+
+    const Entry *find(std::string_view key, uint64_t) const
+    {
+        auto it = table.find(Key(key));
+        return (it != table.end()) ? &it->second : nullptr;
+    }
+
+    void clear() { table.clear(); }
+    size_t size() const { return table.size(); }
+
+    MemoryUsage memoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.entries = table.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void *));
+        usage.buckets = table.bucket_count() * sizeof(void *);
+        for (const auto &pair : table)
+        {
+            usage.keys += stringHeapBytes(pair.first); // La llave es una copia del id
+            addEntryHeapUsage(pair.second, usage);
+        }
+        return usage;
+    }
+
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (const auto &pair : table)
+            fn(pair.second);
+    }
+};
+
+// -----------------------------------------
+// Bloques en orden de inserción
+// -----------------------------------------
+// Las entradas van en bloques contiguos que nunca se realojan (16, 32, 64... entradas),
+// así los punteros sobreviven a inserciones posteriores, y un índice con sondeo lineal
+// como el de FlatMapStorage. Se recorre en orden de inserción, bloque por bloque.
+// clear() conserva los bloques para reutilizarlos.
+template <typename Key, typename Entry, typename HashPolicy>
+class ChunkedStorage
+{
+private:
+    static constexpr size_t FIRST_CHUNK = 16;
+
+    using ChunkList = std::vector<EntryVector<Entry>, CountingAllocator<EntryVector<Entry>, MemoryCategory::ENTRIES>>;
+    ChunkList chunks;              // El bloque k tiene capacidad FIRST_CHUNK << k
+    BucketVector<uint64_t> hashes; // hash de cada entrada, por posición
+    BucketVector<uint32_t> index;  // posición + 1 (0 = vacío); tamaño potencia de 2
+    size_t count = 0;
+
+    // Bloque y desplazamiento de la posición global `position`
+    static std::pair<size_t, size_t> locate(size_t position)
+    {
+        size_t k = 63 - __builtin_clzll(position / FIRST_CHUNK + 1);
+        return {k, position - FIRST_CHUNK * ((size_t(1) << k) - 1)};
+    }
+
+    const Entry &at(size_t position) const
+    {
+        auto [k, offset] = locate(position);
+        return chunks[k][offset];
+    }
+
+    void place(uint32_t position)
+    {
+        size_t mask = index.size() - 1;
+        size_t i = hashes[position] & mask;
+        while (index[i] != 0)
+            i = (i + 1) & mask;
+        index[i] = position + 1;
+    }
+
+    void grow()
+    {
+        index.assign(index.empty() ? 16 : index.size() * 2, 0);
+        for (uint32_t p = 0; p < count; ++p)
+            place(p);
+    }
+
+public:
+    static constexpr bool stablePointers = true;
+
+    explicit ChunkedStorage(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : chunks(resource), hashes(resource), index(resource) {}
+
+    class const_iterator
+    {
+    private:
+        const ChunkList *chunks = nullptr;
+        size_t k = 0;
+        size_t offset = 0;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Entry *;
+        using reference = const Entry &;
+
+        const_iterator() = default;
+        const_iterator(const ChunkList *c, std::pair<size_t, size_t> at)
+            : chunks(c), k(at.first), offset(at.second) {}
+
+        reference operator*() const { return (*chunks)[k][offset]; }
+        pointer operator->() const { return &(*chunks)[k][offset]; }
+        const_iterator &operator++()
+        {
+            if (++offset == FIRST_CHUNK << k)
+            {
+                ++k;
+                offset = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const const_iterator &other) const { return k == other.k && offset == other.offset; }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
+    const_iterator begin() const { return const_iterator(&chunks, {0, 0}); }
+    const_iterator end() const { return const_iterator(&chunks, locate(count)); }
+
+    std::pair<const Entry *, bool> insert(const Entry &entry, uint64_t hash)
+    {
+        if (const Entry *found = find(EntryKey<Entry>::of(entry), hash))
+            return {found, false};
+
+        size_t k = locate(count).first;
+        if (k == chunks.size())
+        {
+            chunks.emplace_back(chunks.get_allocator()); // El bloque usa el mismo recurso
+            chunks.back().reserve(FIRST_CHUNK << k);
+        }
+        chunks[k].push_back(entryCopy(entry, chunks.get_allocator().resource())); // Nunca pasa de la capacidad: no se realoja
+        hashes.push_back(hash);
+        ++count;
+        // Carga máxima de 3/4
+        if (count * 4 > index.size() * 3)
+            grow();
+        else
+            place(static_cast<uint32_t>(count - 1));
+        return {&chunks[k].back(), true};
+    }
+
+    const Entry *find(std::string_view key, uint64_t hash) const
+    {
+        if (index.empty())
+            return nullptr;
+        size_t mask = index.size() - 1;
+        for (size_t i = hash & mask; index[i] != 0; i = (i + 1) & mask)
+        {
+            uint32_t p = index[i] - 1;
+            if (hashes[p] == hash)
+            {
+                const Entry &entry = at(p);
+                if (EntryKey<Entry>::of(entry) == key)
+                    return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    void clear()
+    {
+        for (auto &chunk : chunks)
+            chunk.clear();
+        hashes.clear();
+        count = 0;
+        std::fill(index.begin(), index.end(), 0);
+    }
+
+    size_t size() const { return count; }
+
+    MemoryUsage memoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.entries = vectorBytes(chunks);
+        for (const auto &chunk : chunks)
+            usage.entries += vectorBytes(chunk);
+        usage.buckets = vectorBytes(hashes) + vectorBytes(index);
+        forEach([&](const Entry &entry)
+                { addEntryHeapUsage(entry, usage); });
+        return usage;
+    }
+
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (const auto &chunk : chunks)
+            for (const auto &entry : chunk)
+                fn(entry);
+    }
+};
+
+// -----------------------------------------
+// Tabla plana (direccionamiento abierto)
+// -----------------------------------------
+// Entradas contiguas en orden de inserción y un índice con sondeo lineal. Sin un nodo
+// por entrada; los punteros se invalidan al insertar.
+template <typename Key, typename Entry, typename HashPolicy>
+class FlatMapStorage
+{
+private:
+    EntryVector<Entry> entries;
+    BucketVector<uint64_t> hashes; // hash de cada entrada, para comparar y crecer sin rehashear
+    BucketVector<uint32_t> index;  // posición de entrada + 1 (0 = vacío); tamaño potencia de 2
+
+    void place(uint32_t position)
+    {
+        size_t mask = index.size() - 1;
+        size_t i = hashes[position] & mask;
+        while (index[i] != 0)
+            i = (i + 1) & mask;
+        index[i] = position + 1;
+    }
+
+    void grow()
+    {
+        index.assign(index.empty() ? 16 : index.size() * 2, 0);
+        for (uint32_t p = 0; p < entries.size(); ++p)
+            place(p);
+    }
+
+public:
+    static constexpr bool stablePointers = false;
+
+    explicit FlatMapStorage(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : entries(resource), hashes(resource), index(resource) {}
+
+    using const_iterator = typename EntryVector<Entry>::const_iterator;
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+
+    std::pair<const Entry *, bool> insert(const Entry &entry, uint64_t hash)
+    {
+        if (const Entry *found = find(EntryKey<Entry>::of(entry), hash))
+            return {found, false};
+
+        entries.push_back(entryCopy(entry, entries.get_allocator().resource()));
+        hashes.push_back(hash);
+        // Carga máxima de 3/4
+        if (entries.size() * 4 > index.size() * 3)
+            grow();
+        else
+            place(static_cast<uint32_t>(entries.size() - 1));
+        return {&entries.back(), true};
+    }
+
+    const Entry *find(std::string_view key, uint64_t hash) const
+    {
+        if (index.empty())
+            return nullptr;
+        size_t mask = index.size() - 1;
+        for (size_t i = hash & mask; index[i] != 0; i = (i + 1) & mask)
+        {
+            uint32_t p = index[i] - 1;
+            if (hashes[p] == hash && EntryKey<Entry>::of(entries[p]) == key)
+                return &entries[p];
+        }
+        return nullptr;
+    }
+
+    void clear()
+    {
+        entries.clear();
+        hashes.clear();
+        std::fill(index.begin(), index.end(), 0);
+    }
+
+    size_t size() const { return entries.size(); }
+
+    MemoryUsage memoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.entries = vectorBytes(entries);
+        usage.buckets = vectorBytes(hashes) + vectorBytes(index);
+        for (const auto &entry : entries)
+            addEntryHeapUsage(entry, usage);
+        return usage;
+    }
+
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (const auto &entry : entries)
+            fn(entry);
+    }
+};
+
+// -----------------------------------------
+// Vector ordenado
+// -----------------------------------------
+// Búsqueda binaria sin índice extra: la opción más compacta para tablas pequeñas que se
+// llenan una vez (campos de estructuras). Insertar es O(n); se recorre en orden de llave.
+template <typename Key, typename Entry, typename HashPolicy>
+class SortedVectorStorage
+{
+private:
+    EntryVector<Entry> entries;
+
+    static bool less(const Entry &entry, std::string_view key) { return EntryKey<Entry>::of(entry) < key; }
+
+public:
+    static constexpr bool stablePointers = false;
+
+    explicit SortedVectorStorage(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : entries(resource) {}
+
+    using const_iterator = typename EntryVector<Entry>::const_iterator;
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+
+    std::pair<const Entry *, bool> insert(const Entry &entry, uint64_t)
+    {
+        std::string_view key = EntryKey<Entry>::of(entry);
+        auto it = std::lower_bound(entries.begin(), entries.end(), key, less);
+        if (it != entries.end() && EntryKey<Entry>::of(*it) == key)
+            return {&*it, false};
+        it = entries.insert(it, entryCopy(entry, entries.get_allocator().resource()));
+        return {&*it, true};
+    }
+
+    const Entry *find(std::string_view key, uint64_t) const
+    {
+        auto it = std::lower_bound(entries.begin(), entries.end(), key, less);
+        if (it != entries.end() && EntryKey<Entry>::of(*it) == key)
+            return &*it;
+        return nullptr;
+    }
+
+    void clear() { entries.clear(); }
+    size_t size() const { return entries.size(); }
+
+    MemoryUsage memoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.entries = vectorBytes(entries);
+        for (const auto &entry : entries)
+            addEntryHeapUsage(entry, usage);
+        return usage;
+    }
+
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (const auto &entry : entries)
+            fn(entry);
+    }
+};
+
+// -----------------------------------------
+// Hash perfecto mínimo (palabras clave y tablas congeladas)
+// -----------------------------------------
+// Hash-and-displace: las llaves se reparten en cubetas y cada cubeta guarda un
+// desplazamiento que manda todas sus llaves a ranuras libres. Una búsqueda lee el
+// desplazamiento de su cubeta y prueba una sola ranura; no hay colisiones. Cada inserción
+// reconstruye la tabla, así que es para conjuntos que se llenan una vez (palabras clave,
+// ámbitos ya cerrados).
+template <typename Key, typename Entry, typename HashPolicy>
+class PerfectHashStorage
+{
+private:
+    EntryVector<Entry> entries;     // Contiguas, en orden de inserción
+    BucketVector<uint64_t> hashes; // Solo para reconstruir
+    // Índice en un solo bloque: [0, cubetas) desplazamientos, luego n ranuras con la
+    // posición de su entrada. Una búsqueda toca este bloque y el arreglo de entradas.
+    BucketVector<uint32_t> index;
+    size_t buckets = 0;
+
+    // Reduce un valor de 64 bits a [0, n) con una multiplicación en lugar de un módulo
+    static size_t reduce(uint64_t x, size_t n)
+    {
+        return static_cast<size_t>((static_cast<__uint128_t>(x) * n) >> 64);
+    }
+
+    // Ranura de un hash con un desplazamiento dado; solo mezcla el hash ya calculado
+    static size_t slotOf(uint64_t hash, uint32_t d, size_t n)
+    {
+        return reduce(mixHash(hash ^ (static_cast<uint64_t>(d) * 0x9E3779B97F4A7C15ULL)), n);
+    }
+
+    static size_t bucketOf(uint64_t hash, size_t buckets) { return reduce(hash, buckets); }
+
+    void rebuild()
+    {
+        size_t n = entries.size();
+        buckets = (n + 3) / 4;
+        index.assign(buckets + n, UINT32_MAX);
+        uint32_t *displacement = index.data();
+        uint32_t *slots = index.data() + buckets;
+
+        // Cubetas de mayor a menor tamaño: las grandes son las difíciles de acomodar
+        std::vector<std::vector<uint32_t>> members(buckets);
+        for (uint32_t p = 0; p < n; ++p)
+            members[bucketOf(hashes[p], buckets)].push_back(p);
+        std::vector<size_t> order(buckets);
+        for (size_t b = 0; b < buckets; ++b)
+        {
+            order[b] = b;
+            displacement[b] = 0;
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                  { return members[a].size() > members[b].size(); });
+
+        std::vector<size_t> taken;
+        for (size_t b : order)
+        {
+            if (members[b].empty())
+                break;
+            for (uint32_t d = 0;; ++d)
+            {
+                // Solo falla si dos llaves distintas tienen el mismo hash de 64 bits
+                if (d == (1u << 24))
+                    throw std::runtime_error("No se pudo construir el hash perfecto (hashes repetidos)");
+                taken.clear();
+                bool fits = true;
+                for (uint32_t p : members[b])
+                {
+                    size_t s = slotOf(hashes[p], d, n);
+                    if (slots[s] != UINT32_MAX || std::find(taken.begin(), taken.end(), s) != taken.end())
+                    {
+                        fits = false;
+                        break;
+                    }
+                    taken.push_back(s);
+                }
+                if (fits)
+                {
+                    displacement[b] = d;
+                    for (size_t k = 0; k < taken.size(); ++k)
+                        slots[taken[k]] = members[b][k];
+                    break;
+                }
+            }
+        }
+    }
+
+public:
+    static constexpr bool stablePointers = false;
+
+    using const_iterator = typename EntryVector<Entry>::const_iterator;
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+
+    explicit PerfectHashStorage(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : entries(resource), hashes(resource), index(resource) {}
+
+    // Construye de una vez a partir de entradas sin repetir (ver BasicSymbolTable::freeze).
+    // Las entradas se mueven tal cual: deben venir ya construidas en `resource` (entryCopy).
+    PerfectHashStorage(std::vector<Entry> all, std::vector<uint64_t> allHashes,
+                       std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : entries(std::make_move_iterator(all.begin()), std::make_move_iterator(all.end()), resource),
+          hashes(allHashes.begin(), allHashes.end(), resource), index(resource)
+    {
+        rebuild();
+    }
+
+    std::pair<const Entry *, bool> insert(const Entry &entry, uint64_t hash)
+    {
+        if (const Entry *found = find(EntryKey<Entry>::of(entry), hash))
+            return {found, false};
+        entries.push_back(entryCopy(entry, entries.get_allocator().resource()));
+        hashes.push_back(hash);
+        rebuild();
+        return {&entries.back(), true};
+    }
+
+    // Una sola prueba: no hace falta comparar hashes, la ranura solo puede ser esta llave
+    const Entry *find(std::string_view key, uint64_t hash) const
+    {
+        if (entries.empty())
+            return nullptr;
+        uint32_t d = index[bucketOf(hash, buckets)];
+        const Entry &entry = entries[index[buckets + slotOf(hash, d, entries.size())]];
+        return EntryKey<Entry>::of(entry) == key ? &entry : nullptr;
+    }
+
+    void clear()
+    {
+        entries.clear();
+        hashes.clear();
+        index.clear();
+        buckets = 0;
+    }
+
+    size_t size() const { return entries.size(); }
+
+    MemoryUsage memoryUsage() const
+    {
+        MemoryUsage usage;
+        usage.entries = vectorBytes(entries);
+        usage.buckets = vectorBytes(hashes) + vectorBytes(index);
+        for (const auto &entry : entries)
+            addEntryHeapUsage(entry, usage);
+        return usage;
+    }
+
+    template <typename Fn>
+    void forEach(Fn fn) const
+    {
+        for (const auto &entry : entries)
+            fn(entry);
+    }
+};
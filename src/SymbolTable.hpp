@@ -1,9 +1,16 @@
 #pragma once
 #include <unordered_map>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <optional>
 #include <stdexcept>
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include "BasicSymbolTable.hpp"
+#include "SymbolTableFwd.hpp"
 
 enum class Category
 {
@@ -14,60 +21,75 @@ enum class Category
     PARAM
 };
 
-/*
- * Definición de una expeción personalizada para un mejor manejo de errores
- */
-class SymbolNotFoundError : public std::runtime_error
-{
-public:
-    explicit SymbolNotFoundError(const std::string &id)
-        : std::runtime_error("Symbol not found: " + id) {}
-};
-
 // Recordatorio de cómo se ve la tabla de símbolos:
 // id | tipo | categoría | dirección | lista de parámetros
+// El id y los parámetros reservan en un memory_resource y se cuentan en KEYS y PARAMS
+// (ver MemoryAccounting.hpp): dentro de una tabla viven en el recurso de la tabla (ver
+// entryCopy). Una entrada suelta, como las que se pasan a insert o la copia de una
+// entrada, usa el recurso por defecto del proceso salvo que se construya con otro.
 struct SymbolEntry
 {
-    std::string id;
-    int typeId;
-    Category category;
-    int address;
-    std::vector<int> params;
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+    using id_type = CountedString<MemoryCategory::KEYS>;
+    using params_type = CountedVector<int, MemoryCategory::PARAMS>;
+
+    id_type id;
+    int typeId = 0;
+    Category category = Category::VAR;
+    int address = 0;
+    params_type params;
+
+    SymbolEntry() = default;
+
+    // {id, tipo, categoría, dirección, {params}}: el id puede ser cualquier cadena
+    SymbolEntry(std::string_view id, int typeId, Category category, int address,
+                std::initializer_list<int> params = {}, allocator_type alloc = {})
+        : id(id, alloc.resource()), typeId(typeId), category(category), address(address),
+          params(params, alloc.resource()) {}
+
+    SymbolEntry(std::string_view id, int typeId, Category category, int address,
+                const std::vector<int> &params, allocator_type alloc = {})
+        : id(id, alloc.resource()), typeId(typeId), category(category), address(address),
+          params(params.begin(), params.end(), alloc.resource()) {}
+
+    // Copia con el id y los parámetros en el recurso de `alloc`
+    SymbolEntry(const SymbolEntry &other, allocator_type alloc)
+        : id(other.id, alloc.resource()), typeId(other.typeId), category(other.category), address(other.address),
+          params(other.params, alloc.resource()) {}
+
+    SymbolEntry(const SymbolEntry &) = default;
+    SymbolEntry(SymbolEntry &&) = default;
+    SymbolEntry &operator=(const SymbolEntry &) = default;
+    SymbolEntry &operator=(SymbolEntry &&) = default;
 };
 
-class SymbolTable
+// La llave se compara como vista: el id de la entrada y el de la consulta pueden venir de
+// recursos distintos
+template <>
+struct EntryKey<SymbolEntry>
 {
-private:
-    std::unordered_map<std::string, SymbolEntry> table;
-
-public:
-    // insert va a regresar regresa false si ya existía el id, true si se insertó correctamente
-    bool insert(const SymbolEntry &entry);
+    static std::string_view of(const SymbolEntry &entry) { return entry.id; }
+};
 
-    // -----------------------------------------
-    // Consultas individuales simples
-    // -----------------------------------------
-    // Devuelve el tipo asociado al id
-    int getType(const std::string &id);
+// Memoria fuera del arreglo de entradas: id (si no cabe en SSO) y parámetros
+void addEntryHeapUsage(const SymbolEntry &entry, MemoryUsage &usage);
 
-    // Devuelve la dirección asociada al id
-    int getAddress(const std::string &id);
+// Copia de la entrada con el id y los parámetros en `resource`
+SymbolEntry entryCopy(const SymbolEntry &entry, std::pmr::memory_resource *resource);
 
-    // Devuelve la categoría asociada al id
-    Category getCategory(const std::string &id);
+// Huella de una entrada: id, tipo, categoría, dirección y parámetros
+Fingerprint entryFingerprint(const SymbolEntry &entry);
 
-    // Devuelve la lista de parámetros asociada al id
-    std::vector<int> getParams(const std::string &id);
+// Nombre de una categoría ("VAR", "CONST", ...)
+const char *categoryName(Category category);
 
-    // -----------------------------------------
-    // Consulta completa (si necesitas todos los datos)
-    // -----------------------------------------
-    const SymbolEntry *lookup(const std::string &id) const
-    {
-        auto it = table.find(id);
-        return (it != table.end()) ? &it->second : nullptr;
-    }
+// Imprime una entrada como: id | type | category | address | [params]
+void printEntry(std::ostream &out, const SymbolEntry &entry);
 
-    // Para imprimir/depurar
-    void print() const;
-};
+// La tabla de símbolos del compilador: hash estilo wyhash sobre bloques contiguos en
+// orden de inserción (ChunkedStorage), porque SymbolTableStack entrega punteros a las
+// entradas y estos deben sobrevivir a inserciones posteriores. El alias `SymbolTable` está en
+// SymbolTableFwd.hpp para poder declararlo sin incluir todo esto.
+extern template class BasicSymbolTable<std::string, SymbolEntry, WyHash, ChunkedStorage>;
+extern template class BasicSymbolTable<std::string, SymbolEntry, WyHash, PerfectHashStorage>;
+extern template class BasicFrozenTable<std::string, SymbolEntry, WyHash>;
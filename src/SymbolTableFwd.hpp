@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+
+// Declaraciones adelantadas de SymbolTable (es un alias de plantilla y no puede
+// declararse con `class SymbolTable;`)
+
+enum class Category;
+struct SymbolEntry;
+struct WyHash;
+
+template <typename Key, typename Entry, typename HashPolicy>
+class ChunkedStorage;
+
+template <typename Key, typename Entry, typename HashPolicy>
+class PerfectHashStorage;
+
+template <typename Key, typename Entry, typename HashPolicy, template <class, class, class> class Storage>
+class BasicSymbolTable;
+
+template <typename Key, typename Entry, typename HashPolicy>
+class BasicFrozenTable;
+
+using SymbolTable = BasicSymbolTable<std::string, SymbolEntry, WyHash, ChunkedStorage>;
+
+// Resultado de SymbolTable::freeze(): inmutable, hash perfecto mínimo
+using FrozenSymbolTable = BasicFrozenTable<std::string, SymbolEntry, WyHash>;
+
+template <typename HashPolicy>
+class BasicConcurrentSymbolTable;
+
+// Global concurrente (ver ConcurrentSymbolTable.hpp): mismo hash que SymbolTable
+using ConcurrentSymbolTable = BasicConcurrentSymbolTable<WyHash>;
@@ -1,75 +1,433 @@
 #include "SymbolTableStack.hpp"
+#include "ConcurrentSymbolTable.hpp"
+#include "FrameAllocator.hpp"
+#include "DependencyTracker.hpp"
 #include <iostream>
+#include <stdexcept>
 
-// Crea una nueva tabla de símbolos y la coloca en el tope de la pila.
+// Pila montada sobre un global congelado: la base es compartida y de solo lectura.
+SymbolTableStack::SymbolTableStack(std::shared_ptr<const SymbolTable> global, std::pmr::memory_resource *memoryResource)
+    : stack(memoryResource), recycled(memoryResource), frozenBase(std::move(global)), resource(memoryResource),
+      hotCache(memoryResource), levelGeneration(memoryResource)
+{
+}
+
+// Pila montada sobre un global concurrente: la base es compartida y crece desde varios hilos.
+SymbolTableStack::SymbolTableStack(std::shared_ptr<ConcurrentSymbolTable> global, std::pmr::memory_resource *memoryResource)
+    : stack(memoryResource), recycled(memoryResource), concurrentBase(std::move(global)), resource(memoryResource),
+      hotCache(memoryResource), levelGeneration(memoryResource)
+{
+}
+
+SymbolTableStack::SymbolTableStack(std::pmr::memory_resource *memoryResource)
+    : stack(memoryResource), recycled(memoryResource), resource(memoryResource),
+      hotCache(memoryResource), levelGeneration(memoryResource)
+{
+}
+
+// Coloca una tabla en el tope de la pila: una reciclada si hay, o una nueva.
 void SymbolTableStack::pushScope()
 {
-    SymbolTable *newTable = new SymbolTable();
-    stack.push_back(newTable);
+    if (!recycled.empty())
+    {
+        stack.push_back(std::move(recycled.back()));
+        recycled.pop_back();
+    }
+    else
+    {
+        stack.push_back(makeInResource<SymbolTable>(resource, resource));
+    }
+    stack.back()->enableBloomFilter(bloomFilters);
+    if (allocator)
+    {
+        allocator->enterScope();
+    }
 }
 
-// Elimina la tabla del tope de la pila, pero no libera memoria.
+// Las ranuras de la caché que apuntan al nivel que sale dejan de coincidir con su generación.
+void SymbolTableStack::retireTopLevel()
+{
+    size_t level = levels() - 1;
+    if (level < levelGeneration.size())
+    {
+        ++levelGeneration[level];
+    }
+}
+
+// Elimina la tabla del tope de la pila; se vacía (conservando sus cubetas) y se recicla.
+// El global congelado nunca se saca de la pila.
 void SymbolTableStack::popScope()
 {
     if (!stack.empty())
     {
+        retireTopLevel();
+        if (allocator)
+        {
+            allocator->exitScope();
+        }
+        stack.back()->clear();
+        recycled.push_back(std::move(stack.back()));
         stack.pop_back();
     }
 }
 
-// Quita el tope de la pila y regresa el puntero a la tabla.
-SymbolTable *SymbolTableStack::popSymbolTable()
+// Quita el tope de la pila y cede la tabla al llamador.
+SymbolTableStack::ScopePtr SymbolTableStack::takeScope()
 {
     if (stack.empty())
     {
         return nullptr;
     }
 
-    SymbolTable *top = stack.back();
+    retireTopLevel();
+    if (allocator)
+    {
+        allocator->exitScope();
+    }
+    ScopePtr top = std::move(stack.back());
     stack.pop_back();
     return top;
 }
 
+// Quita el tope de la pila y regresa el puntero a la tabla (el llamador queda como dueño y
+// la libera con delete). Si la tabla no salió de new (pila sobre otro recurso), se entrega
+// una copia creada con new y la original vuelve a las recicladas.
+SymbolTable *SymbolTableStack::popSymbolTable()
+{
+    ScopePtr top = takeScope();
+    if (!top || top.get_deleter().resource == std::pmr::new_delete_resource())
+    {
+        return top.release();
+    }
+
+    auto copy = std::make_unique<SymbolTable>(std::pmr::new_delete_resource());
+    copy->enableBloomFilter(top->hasBloomFilter());
+    top->forEach([&copy](const SymbolEntry &entry)
+                 { copy->insert(entry); });
+    top->clear();
+    recycled.push_back(std::move(top));
+    return copy.release();
+}
+
+// Llena la reserva de tablas recicladas hasta tener n disponibles.
+void SymbolTableStack::reserveScopes(size_t n)
+{
+    while (recycled.size() < n)
+    {
+        recycled.push_back(makeInResource<SymbolTable>(resource, resource));
+    }
+}
+
 // Inserta un símbolo únicamente en el tope, si la pila está vacía, regresa false.
+// Si el tope es el global congelado también regresa false.
 bool SymbolTableStack::insertTop(const SymbolEntry &entry)
 {
     if (stack.empty())
     {
         return false;
     }
-    return stack.back()->insert(entry);
+
+    size_t hash = SymbolTable::hashId(entry.id);
+    bool inserted;
+    if (allocator && (entry.category == Category::VAR || entry.category == Category::PARAM))
+    {
+        // Se revisa el duplicado antes de reservar para no desperdiciar espacio del marco
+        if (stack.back()->lookup(entry.id, hash))
+        {
+            return false;
+        }
+        SymbolEntry placed = entryCopy(entry, resource);
+        placed.address = allocator->allocate(entry.typeId);
+        inserted = stack.back()->insert(placed, hash);
+    }
+    else
+    {
+        inserted = stack.back()->insert(entry, hash);
+    }
+
+    // La nueva entrada oculta a la que la caché tuviera para el mismo id en un nivel inferior
+    if (inserted && !hotCache.empty())
+    {
+        HotSlot &slot = hotCache[hash & (hotCache.size() - 1)];
+        if (slot.entry && slot.hash == hash)
+        {
+            slot.entry = nullptr;
+            ++hotStats.invalidations;
+        }
+    }
+    return inserted;
 }
 
-// Inserta un símbolo únicamente en la base, si la pila está vacía, regresa false.
+// Inserta un símbolo únicamente en la base, si la pila está vacía o la base está congelada, regresa false.
+// No toca la caché: la caché solo guarda ids encontrados, y un id nuevo en la base no oculta
+// nada (o ya existía y la inserción falla, o ningún lookup lo había resuelto).
 bool SymbolTableStack::insertBase(const SymbolEntry &entry)
 {
-    if (stack.empty())
+    if (concurrentBase)
+    {
+        return concurrentBase->insert(entry);
+    }
+    if (stack.empty() || frozenBase)
     {
         return false;
     }
     return stack.front()->insert(entry);
 }
 
-// Busca un símbolo únicamente en el tope.
-SymbolEntry *SymbolTableStack::lookupTop(const std::string &id)
+// Busca un símbolo únicamente en el tope. Si el tope es el ámbito global (congelado o no),
+// la búsqueda se anota en el registro igual que findBase.
+const SymbolEntry *SymbolTableStack::findTop(std::string_view id)
 {
-    if (stack.empty())
+    if (tracker && levels() == 1)
     {
-        return nullptr;
+        tracker->recordSymbol(id);
     }
-
-    const SymbolEntry *result = stack.back()->lookup(id);
-    return const_cast<SymbolEntry *>(result);
+    if (!stack.empty())
+    {
+        return stack.back()->lookup(id);
+    }
+    if (frozenBase)
+    {
+        return frozenBase->lookup(id);
+    }
+    if (concurrentBase)
+    {
+        return concurrentBase->lookup(id);
+    }
+    return nullptr;
 }
 
 // Busca un símbolo únicamente en el ámbito global (primer elemento).
-SymbolEntry *SymbolTableStack::lookupBase(const std::string &id)
+const SymbolEntry *SymbolTableStack::findBase(std::string_view id)
+{
+    if (tracker)
+    {
+        tracker->recordSymbol(id);
+    }
+    if (frozenBase)
+    {
+        return frozenBase->lookup(id);
+    }
+    if (concurrentBase)
+    {
+        return concurrentBase->lookup(id);
+    }
+    if (!stack.empty())
+    {
+        return stack.front()->lookup(id);
+    }
+    return nullptr;
+}
+
+const SymbolEntry *SymbolTableStack::find(std::string_view id)
+{
+    size_t level = 0;
+    return resolve(id, level);
+}
+
+// Las tablas propias de la pila no son const: quitar el const de sus entradas es válido.
+// Las del global compartido pueden ser objetos const (el global del Prelude) o leerse
+// desde otros hilos.
+SymbolEntry *SymbolTableStack::writable(const SymbolEntry *entry, bool inBase) const
+{
+    if (entry && inBase && sharedBase())
+    {
+        throw std::logic_error("La entrada vive en un global compartido; usar find, findTop o findBase");
+    }
+    return const_cast<SymbolEntry *>(entry);
+}
+
+SymbolEntry *SymbolTableStack::lookupTop(std::string_view id)
+{
+    return writable(findTop(id), stack.empty());
+}
+
+SymbolEntry *SymbolTableStack::lookupBase(std::string_view id)
 {
+    return writable(findBase(id), true);
+}
+
+SymbolEntry *SymbolTableStack::lookup(std::string_view id)
+{
+    size_t level = 0;
+    const SymbolEntry *entry = resolve(id, level);
+    return writable(entry, level == 0);
+}
+
+const SymbolEntry *SymbolTableStack::remember(HotSlot *slot, size_t hash, size_t level, const SymbolEntry *entry)
+{
+    if (slot && entry)
+    {
+        if (level >= levelGeneration.size())
+        {
+            levelGeneration.resize(levels(), 0);
+        }
+        if (slot->entry && slot->hash != hash)
+        {
+            ++hotStats.evictions;
+        }
+        *slot = HotSlot{hash, entry, levelGeneration[level], static_cast<uint32_t>(level)};
+    }
+    return entry;
+}
+
+// Recorre los ámbitos del tope a la base con un solo cálculo de hash. Con la caché activa,
+// primero se prueba la ranura del id: si sigue vigente no se consulta ninguna tabla.
+const SymbolEntry *SymbolTableStack::resolve(std::string_view id, size_t &level)
+{
+    size_t hash = SymbolTable::hashId(id);
+    HotSlot *slot = nullptr;
+    if (!hotCache.empty())
+    {
+        slot = &hotCache[hash & (hotCache.size() - 1)];
+        if (slot->entry && slot->hash == hash && slot->level < levels() &&
+            levelGeneration[slot->level] == slot->generation && std::string_view(slot->entry->id) == id)
+        {
+            ++hotStats.hits;
+            // Una entrada del global implica que la búsqueda llegó a él
+            if (tracker && slot->level == 0)
+            {
+                tracker->recordSymbol(id);
+            }
+            level = slot->level;
+            return slot->entry;
+        }
+        ++hotStats.misses;
+    }
+
+    // Sin global compartido, la base es stack.front() y se revisa después del registro
+    auto locals = sharedBase() ? stack.rend() : stack.rend() - (stack.empty() ? 0 : 1);
+    level = levels();
+    for (auto it = stack.rbegin(); it != locals; ++it)
+    {
+        --level;
+        if (const SymbolEntry *result = (*it)->lookup(id, hash))
+            return remember(slot, hash, level, result);
+    }
+
+    level = 0;
+    if (tracker)
+    {
+        tracker->recordSymbol(id);
+    }
+    if (frozenBase)
+    {
+        return remember(slot, hash, 0, frozenBase->lookup(id, hash));
+    }
+    if (concurrentBase)
+    {
+        // Los nodos del global concurrente no se mueven ni se liberan: la caché puede guardarlos
+        return remember(slot, hash, 0, concurrentBase->lookup(id, hash));
+    }
+    if (!stack.empty())
+    {
+        return remember(slot, hash, 0, stack.front()->lookup(id, hash));
+    }
+    return nullptr;
+}
+
+void SymbolTableStack::setHotCache(size_t slots)
+{
+    size_t size = 0;
+    if (slots > 0)
+    {
+        size = 1;
+        while (size < slots)
+            size <<= 1;
+    }
+    hotCache.assign(size, HotSlot());
+    hotCache.shrink_to_fit();
+}
+
+void SymbolTableStack::setBloomFilters(bool enabled)
+{
+    bloomFilters = enabled;
+    for (auto &table : stack)
+    {
+        table->enableBloomFilter(enabled);
+    }
+}
+
+// Cede la tabla base a un puntero compartido de solo lectura. La caché sigue vigente: la
+// tabla no se mueve y el global conserva el nivel 0. Una base concurrente se copia, así que
+// las ranuras del nivel 0 (que apuntan a sus nodos) se invalidan.
+std::shared_ptr<const SymbolTable> SymbolTableStack::freezeBase()
+{
+    if (frozenBase)
+    {
+        return frozenBase;
+    }
+    if (concurrentBase)
+    {
+        frozenBase = concurrentBase->freeze(resource);
+        concurrentBase.reset();
+        if (!levelGeneration.empty())
+        {
+            ++levelGeneration[0];
+        }
+        return frozenBase;
+    }
     if (stack.empty())
     {
         return nullptr;
     }
 
-    const SymbolEntry *result = stack.front()->lookup(id);
-    return const_cast<SymbolEntry *>(result);
-}
\ No newline at end of file
+    // El bloque de control también va al recurso; el deleter devuelve la tabla a él
+    ScopePtr base = std::move(stack.front());
+    ResourceDeleter<SymbolTable> release = base.get_deleter();
+    frozenBase = std::shared_ptr<const SymbolTable>(base.release(), release, std::pmr::polymorphic_allocator<char>(resource));
+    stack.erase(stack.begin());
+    return frozenBase;
+}
+
+// Nivel contado desde el tope; el global congelado es el más profundo.
+const SymbolTable *SymbolTableStack::scope(size_t depth) const
+{
+    if (depth < stack.size())
+    {
+        return stack[stack.size() - 1 - depth].get();
+    }
+    if (frozenBase && depth == stack.size())
+    {
+        return frozenBase.get();
+    }
+    return nullptr;
+}
+
+VisibleSymbols SymbolTableStack::visible() const
+{
+    std::vector<const SymbolTable *> scopes;
+    scopes.reserve(levels());
+    for (size_t depth = 0; depth < levels(); ++depth)
+    {
+        if (const SymbolTable *table = scope(depth))
+        {
+            scopes.push_back(table);
+        }
+    }
+    return VisibleSymbols(std::move(scopes));
+}
+
+MemoryUsage SymbolTableStack::memoryUsage() const
+{
+    MemoryUsage usage;
+    usage.entries = (stack.capacity() + recycled.capacity()) * sizeof(void *) + stack.size() * sizeof(SymbolTable);
+    usage.buckets = hotCache.capacity() * sizeof(HotSlot) + levelGeneration.capacity() * sizeof(uint64_t);
+    for (const auto &table : stack)
+    {
+        usage += table->memoryUsage();
+    }
+    if (frozenBase)
+    {
+        usage += frozenBase->memoryUsage();
+    }
+    if (concurrentBase)
+    {
+        usage += concurrentBase->memoryUsage();
+    }
+    for (const auto &table : recycled)
+    {
+        usage.recycled += sizeof(SymbolTable) + table->memoryUsage().total();
+    }
+    return usage;
+}
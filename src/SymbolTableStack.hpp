@@ -1,49 +1,368 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <cstdint>
+#include <string_view>
 #include "SymbolTable.hpp"
 
+class FrameAllocator;
+class DependencyTracker;
+class VisibleSymbols;
+
+// Contadores de la caché de símbolos calientes de SymbolTableStack (ver setHotCache)
+struct HotCacheStats
+{
+    size_t hits = 0;          // lookup resueltos sin tocar ninguna tabla
+    size_t misses = 0;        // lookup que recorrieron los ámbitos
+    size_t evictions = 0;     // Resoluciones que desplazaron a otro id de su ranura
+    size_t invalidations = 0; // Ranuras descartadas por un insertTop que oculta su id
+
+    double hitRate() const { return hits + misses ? double(hits) / double(hits + misses) : 0.0; }
+};
+
 class SymbolTableStack
 {
+public:
+    // Tabla de un ámbito: vive en el recurso de la pila y se libera en él
+    using ScopePtr = ResourcePtr<SymbolTable>;
+
 private:
-    std::vector<SymbolTable *> stack;
+    // La pila es dueña de sus tablas
+    std::pmr::vector<ScopePtr> stack;
+
+    // Tablas de ámbitos ya cerrados, vacías pero con sus cubetas, listas para reutilizarse
+    std::pmr::vector<ScopePtr> recycled;
+
+    // Ámbito global congelado (solo lectura). Cuando existe, ocupa el lugar de la base
+    // y el vector `stack` contiene únicamente los ámbitos locales.
+    std::shared_ptr<const SymbolTable> frozenBase;
+
+    // Ámbito global concurrente compartido entre pilas de varios hilos (ver el constructor).
+    // Igual que frozenBase, ocupa el lugar de la base fuera de `stack`; insertBase sí lo llena.
+    std::shared_ptr<ConcurrentSymbolTable> concurrentBase;
+
+    bool sharedBase() const { return frozenBase || concurrentBase; }
+
+    // Si está activo, cada tabla local lleva filtro de Bloom
+    bool bloomFilters = false;
+
+    // Asignador de direcciones opcional (no es dueño)
+    FrameAllocator *allocator = nullptr;
+
+    // Registro de dependencias opcional (no es dueño)
+    DependencyTracker *tracker = nullptr;
+
+    // Recurso de memoria de las tablas que crea la pila
+    std::pmr::memory_resource *resource = std::pmr::get_default_resource();
+
+    // Ranura de la caché de símbolos calientes: la última resolución de lookup cuyo hash
+    // cae en ella. Es válida mientras su nivel siga abierto con la misma generación.
+    struct HotSlot
+    {
+        size_t hash = 0;
+        const SymbolEntry *entry = nullptr; // nullptr = ranura vacía
+        uint64_t generation = 0;
+        uint32_t level = 0; // Contado desde la base (0 = global)
+    };
+
+    // Caché de correspondencia directa (tamaño potencia de 2; vacía = desactivada)
+    std::pmr::vector<HotSlot> hotCache;
+
+    // Generación de cada nivel: sube cada vez que el nivel se cierra, lo que invalida de
+    // golpe las ranuras que apuntaban a su tabla sin recorrer la caché
+    std::pmr::vector<uint64_t> levelGeneration;
+
+    HotCacheStats hotStats;
+
+    // Cierra el nivel del tope para la caché
+    void retireTopLevel();
+
+    // Guarda en `slot` (si hay caché) la resolución de un lookup y la regresa
+    const SymbolEntry *remember(HotSlot *slot, size_t hash, size_t level, const SymbolEntry *entry);
+
+    // Resolución de find/lookup: la entrada y el nivel donde está (0 = global)
+    const SymbolEntry *resolve(std::string_view id, size_t &level);
+
+    // Entrada modificable de una tabla propia de la pila; lanza std::logic_error si vive
+    // en un global compartido (congelado o concurrente), que no debe modificarse
+    SymbolEntry *writable(const SymbolEntry *entry, bool inBase) const;
 
 public:
-    // Crea nuevo ámbito
+    SymbolTableStack() = default;
+
+    // Todo lo que la pila reserva sale de `resource` (p. ej. un monotonic_buffer_resource
+    // por sesión), que debe vivir más que la pila: los objetos SymbolTable de cada ámbito,
+    // sus entradas con el id y los parámetros, índices y filtros, los vectores de la pila
+    // y de la caché, y el bloque de control del global congelado. No lo usan el global
+    // concurrente (es compartido y lo crea el llamador) ni el rango de visible().
+    explicit SymbolTableStack(std::pmr::memory_resource *memoryResource);
+
+    // Crea una pila cuya base es un ámbito global congelado y compartido (ver freezeBase).
+    // Pensado para que cada hilo de trabajo tenga su propia pila local sobre el mismo global.
+    explicit SymbolTableStack(std::shared_ptr<const SymbolTable> global,
+                              std::pmr::memory_resource *memoryResource = std::pmr::get_default_resource());
+
+    // Crea una pila cuya base es un ámbito global concurrente: varios hilos, cada uno con su
+    // propia pila sobre la misma tabla, registran las declaraciones globales con insertBase
+    // sin candados. lookup/lookupBase ven lo que los demás hilos ya insertaron. Para recorrer
+    // el global con scope()/visible() hay que congelarlo antes (freezeBase).
+    explicit SymbolTableStack(std::shared_ptr<ConcurrentSymbolTable> global,
+                              std::pmr::memory_resource *memoryResource = std::pmr::get_default_resource());
+
+    SymbolTableStack(SymbolTableStack &&) = default;
+    SymbolTableStack &operator=(SymbolTableStack &&) = default;
+
+    // Crea nuevo ámbito (reutiliza una tabla reciclada si hay alguna)
     void pushScope();
 
-    // Sale de un ámbito
+    // Sale de un ámbito; la tabla se vacía y se guarda para el siguiente pushScope
     void popScope();
 
-    // Sale el ámbito y retorna la referencia a la tabla de símbolos en la cima
+    // Sale el ámbito y transfiere la propiedad de la tabla al llamador (su deleter la
+    // devuelve al recurso de la pila)
+    ScopePtr takeScope();
+
+    // Sale el ámbito y retorna la referencia a la tabla de símbolos en la cima.
+    // El llamador queda como dueño de la tabla y la libera con delete. Con un recurso
+    // distinto de new_delete_resource la tabla regresada es una copia en el heap (la
+    // original se recicla); takeScope la cede sin copiarla.
     SymbolTable *popSymbolTable();
 
-    // Insertar solo en tope
+    // Recurso del que reserva la pila
+    std::pmr::memory_resource *memoryResource() const { return resource; }
+
+    // Prepara n tablas recicladas para que los siguientes pushScope no reserven memoria
+    void reserveScopes(size_t n);
+
+    // Número de tablas recicladas disponibles
+    size_t recycledScopes() const { return recycled.size(); }
+
+    // Insertar solo en tope. Con un FrameAllocator conectado, las VAR/PARAM reciben su
+    // dirección del asignador (se ignora la que traiga la entrada).
     bool insertTop(const SymbolEntry &entry);
 
-    // Insertar solo en la base (ámbito global)
+    // Insertar solo en la base (ámbito global). Con base concurrente es seguro entre hilos.
     bool insertBase(const SymbolEntry &entry);
 
-    // Buscar solo en tope
-    SymbolEntry *lookupTop(const std::string &id);
+    // Buscar solo en tope (solo lectura)
+    const SymbolEntry *findTop(std::string_view id);
+
+    // Buscar solo en la base (solo lectura)
+    const SymbolEntry *findBase(std::string_view id);
+
+    // Buscar en todos los ámbitos, del más interno al global (el primero que aparezca).
+    // Con filtros de Bloom activos, un nivel que no contiene el id cuesta unas cuantas
+    // pruebas de bits y el hash del id se calcula una sola vez. Solo lectura: es la
+    // búsqueda para pilas sobre un global compartido.
+    const SymbolEntry *find(std::string_view id);
+
+    // Como findTop/findBase/find, pero la entrada se puede modificar. Solo para tablas
+    // propias de la pila: si el id se encuentra en un global congelado o concurrente
+    // (compartido con otras pilas) lanzan std::logic_error. Modificar una entrada no
+    // actualiza la huella de su tabla.
+    SymbolEntry *lookupTop(std::string_view id);
+    SymbolEntry *lookupBase(std::string_view id);
+    SymbolEntry *lookup(std::string_view id);
+
+    // Activa o desactiva los filtros de Bloom en los ámbitos locales actuales y futuros.
+    // El global congelado conserva el estado que tenía al congelarse.
+    void setBloomFilters(bool enabled);
+
+    bool bloomFiltersEnabled() const { return bloomFilters; }
+
+    // Caché de símbolos calientes para lookup: `slots` ranuras (se redondea a potencia de 2;
+    // 0 la desactiva) con las resoluciones recientes id -> entrada. Un acierto cuesta el
+    // hash del id y una comparación, sin recorrer ningún ámbito. Solo guarda resultados
+    // encontrados; popScope/takeScope invalidan las del nivel que sale e insertTop la del
+    // id que oculta. Cambiar el tamaño vacía la caché y conserva los contadores.
+    void setHotCache(size_t slots);
+
+    size_t hotCacheSlots() const { return hotCache.size(); }
 
-    // Buscar solo en la base
-    SymbolEntry *lookupBase(const std::string &id);
+    const HotCacheStats &hotCacheStats() const { return hotStats; }
+
+    void resetHotCacheStats() { hotStats = HotCacheStats(); }
+
+    // Conecta (o desconecta con nullptr) un asignador de direcciones: los ámbitos que se
+    // abran y cierren desde ahora se reflejan en él
+    void attachAllocator(FrameAllocator *frameAllocator) { allocator = frameAllocator; }
+
+    // Conecta (o desconecta con nullptr) un registro de dependencias: cada búsqueda que
+    // llega al ámbito global (lookupBase, lookupTop con solo el global abierto, o lookup
+    // sin resultado en los locales) se anota
+    // en la región abierta, se encuentre o no el id
+    void attachDependencyTracker(DependencyTracker *dependencyTracker) { tracker = dependencyTracker; }
+
+    // Congela el ámbito global: la pila cede la tabla base a un puntero compartido de solo
+    // lectura que varios hilos pueden consultar sin candados. Después de congelar,
+    // insertBase regresa false y los pop solo afectan ámbitos locales. Una base concurrente
+    // se copia a una tabla congelada (ya no debe haber inserciones en ella) y la pila deja
+    // de usarla. Regresa nullptr si la pila está vacía.
+    std::shared_ptr<const SymbolTable> freezeBase();
+
+    bool isBaseFrozen() const { return frozenBase != nullptr; }
+
+    ConcurrentSymbolTable *concurrentGlobal() const { return concurrentBase.get(); }
 
     // Depuración
     SymbolTable *currentScope()
     {
         if (stack.empty())
             return nullptr;
-        return stack.back();
+        return stack.back().get();
     }
 
+    // Con la base congelada o concurrente regresa nullptr; usar frozenGlobal() o
+    // concurrentGlobal()
     SymbolTable *globalScope()
     {
-        if (stack.empty())
+        if (stack.empty() || sharedBase())
             return nullptr;
-        return stack.front();
+        return stack.front().get();
+    }
+
+    const SymbolTable *frozenGlobal() const { return frozenBase.get(); }
+
+    size_t levels() const { return stack.size() + (sharedBase() ? 1 : 0); }
+
+    // Bytes de todos los ámbitos abiertos (incluido el global congelado) por categoría.
+    // Las tablas recicladas que la pila conserva tras popScope van en `recycled`.
+    MemoryUsage memoryUsage() const;
+
+    // Ámbito a `depth` niveles del tope: 0 es el más interno y levels() - 1 el global
+    // (congelado o no). nullptr si no hay tantos niveles, o para un global concurrente.
+    const SymbolTable *scope(size_t depth) const;
+
+    // Vinculaciones visibles desde el tope, sin copiar entradas: del ámbito más interno al
+    // global, cada uno en orden de inserción, saltando las ocultas por un ámbito interior.
+    // Un global concurrente no se recorre (puede estar creciendo); congelarlo antes.
+    //     for (const SymbolEntry &e : stack.visible()) ...
+    // Insertar o sacar ámbitos invalida el recorrido.
+    VisibleSymbols visible() const;
+};
+
+/*
+ * Rango de vinculaciones visibles de una SymbolTableStack (ver visible()).
+ * Solo guarda los punteros a los ámbitos; las entradas se leen en su lugar.
+ */
+class VisibleSymbols
+{
+private:
+    std::vector<const SymbolTable *> scopes; // Del más interno al global
+
+    // ¿Algún ámbito más interno que `depth` define el mismo id?
+    bool shadowed(const SymbolEntry &entry, size_t depth) const
+    {
+        size_t hash = SymbolTable::hashId(entry.id);
+        for (size_t d = 0; d < depth; ++d)
+        {
+            if (scopes[d]->lookup(entry.id, hash))
+                return true;
+        }
+        return false;
+    }
+
+public:
+    explicit VisibleSymbols(std::vector<const SymbolTable *> innermostFirst) : scopes(std::move(innermostFirst)) {}
+
+    class const_iterator
+    {
+    private:
+        const VisibleSymbols *owner = nullptr;
+        size_t level = 0;
+        SymbolTable::const_iterator it;
+
+        // Avanza hasta la siguiente entrada visible (o al final)
+        void settle()
+        {
+            while (level < owner->scopes.size())
+            {
+                if (it == owner->scopes[level]->end())
+                {
+                    if (++level < owner->scopes.size())
+                        it = owner->scopes[level]->begin();
+                    continue;
+                }
+                if (!owner->shadowed(*it, level))
+                    return;
+                ++it;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = SymbolEntry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const SymbolEntry *;
+        using reference = const SymbolEntry &;
+
+        const_iterator() = default;
+        const_iterator(const VisibleSymbols *o, size_t l) : owner(o), level(l)
+        {
+            if (level < owner->scopes.size())
+            {
+                it = owner->scopes[level]->begin();
+                settle();
+            }
+        }
+
+        reference operator*() const { return *it; }
+        pointer operator->() const { return &*it; }
+
+        // Nivel donde vive la entrada actual (0 = ámbito más interno)
+        size_t depth() const { return level; }
+
+        const_iterator &operator++()
+        {
+            ++it;
+            settle();
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+        bool operator==(const const_iterator &other) const
+        {
+            return level == other.level && (level == owner->scopes.size() || it == other.it);
+        }
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, scopes.size()); }
+};
+
+/*
+ * Guarda RAII de ámbito: abre un ámbito al construirse y, al destruirse, cierra todos los
+ * ámbitos abiertos desde entonces (incluso si se sale por una excepción).
+ *
+ *     {
+ *         ScopeGuard scope(stack);
+ *         stack.insertTop(...);
+ *     } // el ámbito se cierra y su tabla se recicla
+ */
+class ScopeGuard
+{
+private:
+    SymbolTableStack &stack;
+    size_t depth; // Niveles que había antes de abrir el ámbito
+
+public:
+    explicit ScopeGuard(SymbolTableStack &s) : stack(s), depth(s.levels())
+    {
+        stack.pushScope();
+    }
+
+    ~ScopeGuard()
+    {
+        while (stack.levels() > depth)
+            stack.popScope();
     }
 
-    size_t levels() const { return stack.size(); }
-};
\ No newline at end of file
+    ScopeGuard(const ScopeGuard &) = delete;
+    ScopeGuard &operator=(const ScopeGuard &) = delete;
+};
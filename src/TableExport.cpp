@@ -0,0 +1,353 @@
+#include "TableExport.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace
+{
+    // Bytes estimados por fila, para reservar el búfer de una sola vez
+    const size_t BYTES_PER_ROW = 64;
+
+    const char *kindName(TypeKind kind)
+    {
+        switch (kind)
+        {
+        case TypeKind::BASIC:
+            return "BASIC";
+        case TypeKind::ARRAY:
+            return "ARRAY";
+        case TypeKind::STRUCT:
+            return "STRUCT";
+        }
+        return "UNKNOWN";
+    }
+}
+
+// -----------------------------------------
+// ExportSink
+// -----------------------------------------
+
+ExportSink::ExportSink(int fileDescriptor, size_t chunkBytes) : fd(fileDescriptor), chunk(chunkBytes)
+{
+}
+
+ExportSink::ExportSink(std::string &target, size_t chunkBytes) : out(&target), chunk(chunkBytes)
+{
+}
+
+void ExportSink::reserve(size_t bytes)
+{
+    buffer.reserve(chunk ? std::min(bytes, chunk + 4 * BYTES_PER_ROW) : bytes);
+}
+
+void ExportSink::append(const char *text)
+{
+    append(text, std::strlen(text));
+}
+
+// El límite de bloque se revisa entre filas, no en cada fragmento
+void ExportSink::endRow()
+{
+    if (chunk && buffer.size() >= chunk)
+    {
+        flush();
+    }
+}
+
+void ExportSink::appendInt(long long value)
+{
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    append(digits, result.ptr - digits);
+}
+
+void ExportSink::appendJsonString(std::string_view text)
+{
+    append('"');
+    // Lo común es un id sin nada que escapar: se copia de una vez
+    size_t plain = 0;
+    while (plain < text.size() && text[plain] != '"' && text[plain] != '\\' &&
+           static_cast<unsigned char>(text[plain]) >= 0x20)
+    {
+        ++plain;
+    }
+    append(text.data(), plain);
+    for (char c : text.substr(plain))
+    {
+        switch (c)
+        {
+        case '"':
+            append("\\\"", 2);
+            break;
+        case '\\':
+            append("\\\\", 2);
+            break;
+        case '\n':
+            append("\\n", 2);
+            break;
+        case '\t':
+            append("\\t", 2);
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                append(escaped, 6);
+            }
+            else
+            {
+                append(c);
+            }
+        }
+    }
+    append('"');
+}
+
+// Solo se entrecomilla si hace falta (comas, comillas o saltos de línea)
+void ExportSink::appendCsvField(std::string_view text)
+{
+    if (text.find_first_of(",\"\n\r") == std::string_view::npos)
+    {
+        append(text);
+        return;
+    }
+    append('"');
+    for (char c : text)
+    {
+        if (c == '"')
+        {
+            append('"');
+        }
+        append(c);
+    }
+    append('"');
+}
+
+// Entrega el búfer al destino; a un descriptor, con write repetido solo si es parcial
+void ExportSink::flush()
+{
+    if (buffer.empty())
+    {
+        return;
+    }
+    if (out)
+    {
+        out->append(buffer);
+    }
+    else
+    {
+        const char *data = buffer.data();
+        size_t left = buffer.size();
+        while (left > 0)
+        {
+            ssize_t n = ::write(fd, data, left);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                throw std::runtime_error(std::string("Error al exportar: ") + std::strerror(errno));
+            }
+            data += n;
+            left -= static_cast<size_t>(n);
+        }
+    }
+    written += buffer.size();
+    buffer.clear();
+}
+
+// -----------------------------------------
+// Símbolos
+// -----------------------------------------
+
+void SymbolExporter::begin(size_t entries)
+{
+    sink.reserve((entries + 1) * BYTES_PER_ROW);
+    switch (format)
+    {
+    case ExportFormat::TEXT:
+        sink.append("Symbol Table:\n");
+        break;
+    case ExportFormat::JSON:
+        sink.append('[');
+        break;
+    case ExportFormat::CSV:
+        sink.append("id,type,category,address,params\n");
+        break;
+    }
+}
+
+void SymbolExporter::add(const SymbolEntry &entry)
+{
+    switch (format)
+    {
+    case ExportFormat::TEXT:
+        sink.append(entry.id);
+        sink.append(" | ", 3);
+        sink.appendInt(entry.typeId);
+        sink.append(" | ", 3);
+        sink.append(categoryName(entry.category));
+        sink.append(" | ", 3);
+        sink.appendInt(entry.address);
+        sink.append(" | [", 4);
+        for (size_t i = 0; i < entry.params.size(); ++i)
+        {
+            if (i > 0)
+                sink.append(", ", 2);
+            sink.appendInt(entry.params[i]);
+        }
+        sink.append("]\n", 2);
+        break;
+    case ExportFormat::JSON:
+        sink.append(count ? ",\n{\"id\":" : "\n{\"id\":");
+        sink.appendJsonString(entry.id);
+        sink.append(",\"type\":");
+        sink.appendInt(entry.typeId);
+        sink.append(",\"category\":\"");
+        sink.append(categoryName(entry.category));
+        sink.append("\",\"address\":");
+        sink.appendInt(entry.address);
+        sink.append(",\"params\":[");
+        for (size_t i = 0; i < entry.params.size(); ++i)
+        {
+            if (i > 0)
+                sink.append(',');
+            sink.appendInt(entry.params[i]);
+        }
+        sink.append("]}", 2);
+        break;
+    case ExportFormat::CSV:
+        sink.appendCsvField(entry.id);
+        sink.append(',');
+        sink.appendInt(entry.typeId);
+        sink.append(',');
+        sink.append(categoryName(entry.category));
+        sink.append(',');
+        sink.appendInt(entry.address);
+        sink.append(',');
+        for (size_t i = 0; i < entry.params.size(); ++i)
+        {
+            if (i > 0)
+                sink.append(';');
+            sink.appendInt(entry.params[i]);
+        }
+        sink.append('\n');
+        break;
+    }
+    sink.endRow();
+    ++count;
+}
+
+void SymbolExporter::end()
+{
+    if (format == ExportFormat::JSON)
+    {
+        sink.append("\n]\n");
+    }
+}
+
+// -----------------------------------------
+// Tipos
+// -----------------------------------------
+
+void exportTypes(const TypeTable &table, ExportSink &sink, const ExportOptions &options)
+{
+    sink.reserve((table.count() + 2) * BYTES_PER_ROW);
+    switch (options.format)
+    {
+    case ExportFormat::TEXT:
+        sink.append("=== Tabla de Tipos ===\nID\tNombre\tTam\tTipo\tElem\tBase\n");
+        break;
+    case ExportFormat::JSON:
+        sink.append('[');
+        break;
+    case ExportFormat::CSV:
+        sink.append("id,name,size,kind,elements,base\n");
+        break;
+    }
+
+    for (int id = 0; id < table.count(); ++id)
+    {
+        TypeEntryView t = table.view(id);
+        switch (options.format)
+        {
+        case ExportFormat::TEXT:
+            sink.appendInt(t.id);
+            sink.append('\t');
+            sink.append(t.name);
+            sink.append('\t');
+            sink.appendInt(t.size);
+            sink.append('\t');
+            sink.append(kindName(t.kind));
+            sink.append('\t');
+            sink.appendInt(t.elements);
+            sink.append('\t');
+            sink.appendInt(t.baseTypeId);
+            sink.append('\n');
+            break;
+        case ExportFormat::JSON:
+            sink.append(id ? ",\n{\"id\":" : "\n{\"id\":");
+            sink.appendInt(t.id);
+            sink.append(",\"name\":");
+            sink.appendJsonString(t.name);
+            sink.append(",\"size\":");
+            sink.appendInt(t.size);
+            sink.append(",\"kind\":\"");
+            sink.append(kindName(t.kind));
+            sink.append("\",\"elements\":");
+            sink.appendInt(t.elements);
+            sink.append(",\"base\":");
+            sink.appendInt(t.baseTypeId);
+            sink.append('}');
+            break;
+        case ExportFormat::CSV:
+            sink.appendInt(t.id);
+            sink.append(',');
+            sink.appendCsvField(t.name);
+            sink.append(',');
+            sink.appendInt(t.size);
+            sink.append(',');
+            sink.append(kindName(t.kind));
+            sink.append(',');
+            sink.appendInt(t.elements);
+            sink.append(',');
+            sink.appendInt(t.baseTypeId);
+            sink.append('\n');
+            break;
+        }
+        sink.endRow();
+    }
+
+    switch (options.format)
+    {
+    case ExportFormat::TEXT:
+        sink.append("======================\n");
+        break;
+    case ExportFormat::JSON:
+        sink.append("\n]\n");
+        break;
+    case ExportFormat::CSV:
+        break;
+    }
+    sink.flush();
+}
+
+size_t exportTypes(const TypeTable &table, int fd, const ExportOptions &options)
+{
+    ExportSink sink(fd, options.chunkBytes);
+    exportTypes(table, sink, options);
+    return sink.bytesWritten();
+}
+
+std::string exportTypesToString(const TypeTable &table, const ExportOptions &options)
+{
+    std::string out;
+    ExportSink sink(out, options.chunkBytes);
+    exportTypes(table, sink, options);
+    return out;
+}
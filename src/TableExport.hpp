@@ -0,0 +1,140 @@
+#pragma once
+#include "SymbolTable.hpp"
+#include "TypeTable.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/*
+ * Exportación rápida de SymbolTable y TypeTable para depurar y comparar (diff).
+ *
+ * Todo se formatea en un búfer reservado de antemano y se escribe con una sola llamada a
+ * write(2). En modo streaming (chunkBytes > 0) el búfer no crece de ese tamaño y se
+ * vacía cada vez que se llena, para tablas muy grandes.
+ *
+ * Formatos:
+ *   TEXT  igual que print(): "id | type | category | address | [params]" y
+ *         "ID\tNombre\tTam\tTipo\tElem\tBase" para tipos
+ *   JSON  un arreglo de objetos, uno por línea
+ *   CSV   con encabezado; los parámetros van separados por ';'
+ */
+enum class ExportFormat
+{
+    TEXT,
+    JSON,
+    CSV
+};
+
+struct ExportOptions
+{
+    ExportFormat format = ExportFormat::TEXT;
+    // Ordena los símbolos por id (el orden normal es el del almacenamiento). Los tipos
+    // siempre salen por ID, que ya es determinista.
+    bool sorted = false;
+    // 0: todo en un búfer y una escritura. >0: streaming; el búfer se vacía al terminar
+    // la fila con la que llega a este tamaño.
+    size_t chunkBytes = 0;
+};
+
+// Destino de la exportación: un descriptor de archivo o un std::string
+class ExportSink
+{
+private:
+    int fd = -1;
+    std::string *out = nullptr;
+    std::string buffer;
+    size_t chunk;
+    size_t written = 0;
+
+public:
+    ExportSink(int fileDescriptor, size_t chunkBytes);
+    ExportSink(std::string &target, size_t chunkBytes);
+
+    // Reserva para `bytes` (en streaming, para un bloque y una fila de holgura)
+    void reserve(size_t bytes);
+
+    void append(const char *data, size_t length) { buffer.append(data, length); }
+    void append(const std::string &text) { append(text.data(), text.size()); }
+    void append(std::string_view text) { append(text.data(), text.size()); }
+    void append(const char *text);
+    void append(char c) { buffer.push_back(c); }
+    void appendInt(long long value);
+
+    // Texto entre comillas con escapes de JSON o de CSV
+    void appendJsonString(std::string_view text);
+    void appendCsvField(std::string_view text);
+
+    // Fin de una fila: en streaming, vacía el búfer si ya llegó al tamaño de bloque
+    void endRow();
+
+    // Escribe lo pendiente (lanza std::runtime_error si write falla)
+    void flush();
+
+    // Bytes entregados hasta ahora
+    size_t bytesWritten() const { return written + buffer.size(); }
+};
+
+// Formateo de los símbolos ya ordenados o en el orden de la tabla
+class SymbolExporter
+{
+private:
+    ExportSink &sink;
+    ExportFormat format;
+    size_t count = 0;
+
+public:
+    SymbolExporter(ExportSink &s, ExportFormat f) : sink(s), format(f) {}
+
+    void begin(size_t entries);
+    void add(const SymbolEntry &entry);
+    void end();
+};
+
+// Recorre cualquier tabla de SymbolEntry (SymbolTable, FrozenSymbolTable...)
+template <typename Table>
+void exportSymbols(const Table &table, ExportSink &sink, const ExportOptions &options)
+{
+    SymbolExporter exporter(sink, options.format);
+    exporter.begin(table.size());
+    if (options.sorted)
+    {
+        std::vector<const SymbolEntry *> entries;
+        entries.reserve(table.size());
+        table.forEach([&](const SymbolEntry &entry)
+                      { entries.push_back(&entry); });
+        std::sort(entries.begin(), entries.end(), [](const SymbolEntry *a, const SymbolEntry *b)
+                  { return a->id < b->id; });
+        for (const SymbolEntry *entry : entries)
+            exporter.add(*entry);
+    }
+    else
+    {
+        table.forEach([&](const SymbolEntry &entry)
+                      { exporter.add(entry); });
+    }
+    exporter.end();
+    sink.flush();
+}
+
+// Escribe la tabla en un descriptor de archivo; regresa los bytes escritos
+template <typename Table>
+size_t exportSymbols(const Table &table, int fd, const ExportOptions &options = {})
+{
+    ExportSink sink(fd, options.chunkBytes);
+    exportSymbols(table, sink, options);
+    return sink.bytesWritten();
+}
+
+// Regresa la tabla formateada como texto
+template <typename Table>
+std::string exportSymbolsToString(const Table &table, const ExportOptions &options = {})
+{
+    std::string out;
+    ExportSink sink(out, options.chunkBytes);
+    exportSymbols(table, sink, options);
+    return out;
+}
+
+void exportTypes(const TypeTable &table, ExportSink &sink, const ExportOptions &options);
+size_t exportTypes(const TypeTable &table, int fd, const ExportOptions &options = {});
+std::string exportTypesToString(const TypeTable &table, const ExportOptions &options = {});
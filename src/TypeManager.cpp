@@ -0,0 +1,19 @@
+#include "TypeManager.hpp"
+#include "CodeGenerator.hpp"
+
+// Conversión implícita con emisión de código; la memoria de conversiones vive en el generador
+std::string TypeManager::ampliar(const std::string& dir, int t1, int t2, CodeGenerator& gen) const {
+    if (!isValidConversion(t1, t2, true)) {
+        throw std::runtime_error("Conversión implícita inválida");
+    }
+    if (typeTable->equivalent(t1, t2)) {
+        return dir;
+    }
+    if (const std::string* cached = gen.findConversion(dir, t1, t2)) {
+        return *cached;
+    }
+    std::string temp = gen.newTemp();
+    gen.emit(std::string("(").append(typeTable->getNameView(t2)).append(")"), dir, "", temp);
+    gen.recordConversion(dir, t1, t2, temp);
+    return temp;
+}
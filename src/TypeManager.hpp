@@ -3,6 +3,35 @@
 #include <string>
 #include <stdexcept>
 #include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+class CodeGenerator;
+
+/**
+ * Operaciones del API por lotes (TypeManager::checkBatch)
+ */
+enum class TypeOp : int32_t {
+    MAX = 0,    // Resultado: TypeManager::max(t1, t2)
+    MIN,        // Resultado: TypeManager::min(t1, t2)
+    COMPATIBLE, // Resultado: areCompatible(t1, t2) (0 o 1)
+    IMPLICIT,   // Resultado: isValidConversion(t1, t2, true) (0 o 1)
+    EXPLICIT,   // Resultado: isValidConversion(t1, t2, false) (0 o 1)
+    COUNT
+};
+
+// La ruta AVX2 carga 8 operaciones seguidas directo del arreglo de TypeOp como enteros de
+// 32 bits: cada elemento debe ser exactamente un int32_t, sin relleno entre elementos
+static_assert(std::is_same_v<std::underlying_type_t<TypeOp>, int32_t>, "TypeOp debe ser int32_t");
+static_assert(sizeof(TypeOp) == sizeof(int32_t) && alignof(TypeOp) == alignof(int32_t),
+              "TypeOp debe ocupar lo mismo que un int32_t");
+static_assert(std::is_standard_layout_v<TypeOp> && std::is_trivially_copyable_v<TypeOp>,
+              "TypeOp debe poder leerse como bytes");
 
 /**
  * Type Manager (Manejador de Tipos)
@@ -19,6 +48,152 @@ class TypeManager {
 private:
     const TypeTable* typeTable;
 
+    // --- Retícula precalculada para checkBatch ---
+    // Cada tipo cae en una clase: su prioridad (0..5) si es básico con jerarquía, u
+    // OTHER_CLASS en otro caso. La retícula dice, para cada (op, clase1, clase2) con
+    // t1 != t2, qué resulta: en MAX/MIN 0 = t1, 1 = t2, -1 = error; en los predicados 0/1.
+    static constexpr int OTHER_CLASS = 6;
+    static constexpr int CLASS_COUNT = 7;
+    static constexpr int OP_COUNT = static_cast<int>(TypeOp::COUNT);
+    // Solo checkBatch y prepareBatch leen y hacen crecer estos arreglos; las funciones
+    // escalares (max, min, areCompatible, isValidConversion...) nunca los tocan, así que
+    // pueden correr en otro hilo mientras uno llama a checkBatch.
+    mutable std::vector<int32_t> typeClass;
+    mutable std::vector<int32_t> typeCanon; // ID canónico de cada tipo (ver TypeTable::canonicalId)
+    mutable std::vector<int32_t> lattice;
+
+    // Prioridad de un tipo básico con jerarquía (ver getPriority); -1 para cualquier otro.
+    // Lee por la referencia ya validada: sin copias ni otra revisión del ID.
+    // La longitud del nombre deja a lo más tres candidatos por comparar.
+    static int rankOf(TypeRef type) {
+        if (type.kind() != TypeKind::BASIC) return -1;
+        std::string_view name = type.name();
+        switch (name.size()) {
+        case 3:
+            return name == "int" ? 3 : -1;
+        case 4:
+            if (name == "void") return 0;
+            if (name == "bool") return 1;
+            if (name == "char") return 2;
+            return -1;
+        case 5:
+            return name == "float" ? 4 : -1;
+        case 6:
+            return name == "double" ? 5 : -1;
+        default:
+            return -1;
+        }
+    }
+
+    // Prioridad si el tipo es numérico (char..double); -1 si no. Valida el ID y lee solo la
+    // tabla de tipos, nunca las clases de checkBatch (ver typeClass).
+    int numericRank(int typeId) const {
+        int rank = rankOf(typeTable->ref(typeId));
+        return rank >= 2 && rank <= 5 ? rank : -1;
+    }
+
+    // Clase de un tipo para la retícula
+    int32_t classOf(int typeId) const {
+        int rank = rankOf(typeTable->ref(typeId));
+        return rank < 0 ? OTHER_CLASS : rank;
+    }
+
+    // Llena la retícula con las mismas reglas que max/min/areCompatible/isValidConversion
+    void buildLattice() const {
+        lattice.assign(OP_COUNT * CLASS_COUNT * CLASS_COUNT, -1);
+        for (int c1 = 0; c1 < CLASS_COUNT; ++c1) {
+            for (int c2 = 0; c2 < CLASS_COUNT; ++c2) {
+                bool numeric = c1 >= 2 && c1 <= 5 && c2 >= 2 && c2 <= 5;
+                auto at = [&](TypeOp op) -> int32_t& {
+                    return lattice[(static_cast<int>(op) * CLASS_COUNT + c1) * CLASS_COUNT + c2];
+                };
+                at(TypeOp::MAX) = numeric ? (c1 > c2 ? 0 : 1) : -1;
+                at(TypeOp::MIN) = numeric ? (c1 < c2 ? 0 : 1) : -1;
+                at(TypeOp::COMPATIBLE) = numeric ? 1 : 0;
+                at(TypeOp::IMPLICIT) = numeric && c1 < c2 ? 1 : 0;
+                at(TypeOp::EXPLICIT) = numeric ? 1 : 0;
+            }
+        }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    // Bloques de 8 elementos con gathers sobre la retícula; regresa cuántos resolvió (el
+    // resto lo termina checkOne). Se compila para AVX2 con target("avx2") aunque el resto
+    // del programa no lleve -mavx2, y solo se llama si batchAvx2Available().
+    __attribute__((target("avx2")))
+    size_t checkBatchAvx2(const int32_t* t1, const int32_t* t2, const TypeOp* ops, size_t n,
+                          int32_t* result, uint8_t* error) const {
+        size_t i = 0;
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i minusOne = _mm256_set1_epi32(-1);
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256i count = _mm256_set1_epi32(static_cast<int32_t>(typeClass.size()));
+        const __m256i opCount = _mm256_set1_epi32(OP_COUNT);
+        const __m256i lastSelect = _mm256_set1_epi32(static_cast<int32_t>(TypeOp::MIN));
+        const __m256i classCount = _mm256_set1_epi32(CLASS_COUNT);
+
+        for (; i + 8 <= n; i += 8) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t1 + i));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(t2 + i));
+            // Carga sin alinear de los bytes de ops (ver los static_assert de TypeOp)
+            __m256i op = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ops + i));
+
+            // Índices válidos: 0 <= x < limite
+            __m256i valid = _mm256_and_si256(
+                _mm256_and_si256(_mm256_cmpgt_epi32(count, a), _mm256_cmpgt_epi32(a, minusOne)),
+                _mm256_and_si256(_mm256_cmpgt_epi32(count, b), _mm256_cmpgt_epi32(b, minusOne)));
+            valid = _mm256_and_si256(valid,
+                _mm256_and_si256(_mm256_cmpgt_epi32(opCount, op), _mm256_cmpgt_epi32(op, minusOne)));
+
+            __m256i ca = _mm256_mask_i32gather_epi32(zero, typeClass.data(), a, valid, 4);
+            __m256i cb = _mm256_mask_i32gather_epi32(zero, typeClass.data(), b, valid, 4);
+            __m256i index = _mm256_add_epi32(
+                _mm256_mullo_epi32(_mm256_add_epi32(_mm256_mullo_epi32(op, classCount), ca), classCount), cb);
+            __m256i r = _mm256_mask_i32gather_epi32(minusOne, lattice.data(), index, valid, 4);
+
+            // MAX/MIN: el selector se cambia por el ID del operando
+            __m256i selects = _mm256_cmpgt_epi32(_mm256_add_epi32(lastSelect, one), op);
+            __m256i picked = _mm256_blendv_epi8(a, b, _mm256_cmpeq_epi32(r, one));
+            picked = _mm256_blendv_epi8(picked, minusOne, _mm256_cmpgt_epi32(zero, r));
+            r = _mm256_blendv_epi8(r, picked, selects);
+
+            // Tipos equivalentes: MAX/MIN regresan t1 y los predicados son verdaderos
+            __m256i canonA = _mm256_mask_i32gather_epi32(zero, typeCanon.data(), a, valid, 4);
+            __m256i canonB = _mm256_mask_i32gather_epi32(zero, typeCanon.data(), b, valid, 4);
+            __m256i same = _mm256_and_si256(_mm256_cmpeq_epi32(canonA, canonB), valid);
+            r = _mm256_blendv_epi8(r, _mm256_blendv_epi8(one, a, selects), same);
+            r = _mm256_blendv_epi8(minusOne, r, valid);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i), r);
+            int negative = _mm256_movemask_ps(_mm256_castsi256_ps(r));
+            for (int k = 0; k < 8; ++k) {
+                error[i + k] = (negative >> k) & 1;
+            }
+        }
+        return i;
+    }
+#endif
+
+    // Resuelve un elemento del lote sin SIMD
+    void checkOne(int32_t t1, int32_t t2, int32_t op, int32_t& result, uint8_t& error) const {
+        int32_t n = static_cast<int32_t>(typeClass.size());
+        if (t1 < 0 || t1 >= n || t2 < 0 || t2 >= n || op < 0 || op >= OP_COUNT) {
+            result = -1;
+            error = 1;
+            return;
+        }
+        bool selects = op <= static_cast<int32_t>(TypeOp::MIN);
+        if (typeCanon[t1] == typeCanon[t2]) {
+            result = selects ? t1 : 1;
+            error = 0;
+            return;
+        }
+        int32_t r = lattice[(op * CLASS_COUNT + typeClass[t1]) * CLASS_COUNT + typeClass[t2]];
+        if (selects && r >= 0) r = (r == 0) ? t1 : t2;
+        result = r;
+        error = r < 0 ? 1 : 0;
+    }
+
     /**
      * Obtiene la prioridad de un tipo 
      * Jerarquía: void(0) < bool(1) < char(2) < int(3) < float(4) < double(5)
@@ -28,20 +203,17 @@ private:
      * @throws std::runtime_error si el tipo no es básico
      */
     int getPriority(int typeId) const {
-        const TypeEntry& type = typeTable->get(typeId);
+        TypeRef type = typeTable->ref(typeId);
         
-        if (type.kind != TypeKind::BASIC) {
+        if (type.kind() != TypeKind::BASIC) {
             throw std::runtime_error("Solo los tipos básicos tienen jerarquía definida");
         }
         
-        if (type.name == "void") return 0;
-        if (type.name == "bool") return 1;
-        if (type.name == "char") return 2;
-        if (type.name == "int") return 3;
-        if (type.name == "float") return 4;
-        if (type.name == "double") return 5;
-        
-        throw std::runtime_error("Tipo desconocido: " + type.name);
+        int rank = rankOf(type);
+        if (rank < 0) {
+            throw std::runtime_error("Tipo desconocido: " + std::string(type.name()));
+        }
+        return rank;
     }
 
     /**
@@ -52,16 +224,7 @@ private:
      * @return true si es tipo numérico
      */
     bool isNumericType(int typeId) const {
-        const TypeEntry& type = typeTable->get(typeId);
-        if (type.kind != TypeKind::BASIC) return false;
-        
-        std::string name = type.name;
-        if (name == "char") return true;
-        if (name == "int") return true;
-        if (name == "float") return true;
-        if (name == "double") return true;
-        
-        return false;
+        return numericRank(typeId) >= 0;
     }
 
 public:
@@ -72,6 +235,20 @@ public:
      */
     TypeManager(const TypeTable& tt) : typeTable(&tt) {}
 
+    /**
+     * Constructor que reutiliza la retícula ya calculada por otro manejador
+     * 
+     * @param tt Tabla que extiende a la de `prepared` (ver TypeTable::overlay): los
+     *           primeros IDs son los mismos, así que sus clases siguen valiendo
+     * @param prepared Manejador de la tabla base, con prepareBatch ya llamado
+     */
+    TypeManager(const TypeTable& tt, const TypeManager& prepared)
+        : typeTable(&tt), typeClass(prepared.typeClass), typeCanon(prepared.typeCanon),
+          lattice(prepared.lattice) {}
+
+    // Tabla de tipos sobre la que trabaja este manejador
+    const TypeTable& getTypeTable() const { return *typeTable; }
+
     /**
      * max - Obtiene el tipo de mayor jerarquía
      * Para operaciones aritméticas, se usa el tipo más amplio 
@@ -82,16 +259,16 @@ public:
      * @throws std::runtime_error si tipos no son compatibles
      */
     int max(int t1, int t2) const {
-        if (t1 == t2) {
+        if (typeTable->equivalent(t1, t2)) {
             return t1;
         }
-        if (!isNumericType(t1) || !isNumericType(t2)) {
+        // Cada ID se valida una sola vez
+        int priority1 = numericRank(t1);
+        int priority2 = numericRank(t2);
+        if (priority1 < 0 || priority2 < 0) {
             throw std::runtime_error("Los tipos no son numéricos, por lo que no tienen una jerarquía comparable");
         }
         
-        int priority1 = getPriority(t1);
-        int priority2 = getPriority(t2);
-        
         if (priority1 > priority2) {
             return t1;
         } else {
@@ -108,17 +285,16 @@ public:
      * @throws std::runtime_error si tipos no son compatibles
      */
     int min(int t1, int t2) const {
-        if (t1 == t2) {
+        if (typeTable->equivalent(t1, t2)) {
             return t1;
         }
         
-        if (!isNumericType(t1) || !isNumericType(t2)) {
+        int priority1 = numericRank(t1);
+        int priority2 = numericRank(t2);
+        if (priority1 < 0 || priority2 < 0) {
             throw std::runtime_error("Los tipos no son numéricos, por lo que no tienen una jerarquía comparable");
         }
         
-        int priority1 = getPriority(t1);
-        int priority2 = getPriority(t2);
-        
         if (priority1 < priority2) {
             return t1;
         } else {
@@ -141,7 +317,7 @@ public:
         if (!isValidConversion(t1, t2, true)) {
             throw std::runtime_error("Conversión implícita inválida");
         }
-        if (t1 == t2) {
+        if (typeTable->equivalent(t1, t2)) {
             return dir;
         }
         // En si, se debería generar código como:
@@ -153,6 +329,23 @@ public:
         return dir + 100; 
     }
 
+    /**
+     * ampliar - Conversión implícita que emite código real
+     * 
+     * Emite el cuádruplo de conversión `temp = (t2) dir` en el generador. Si en el bloque
+     * básico actual ya se convirtió la misma dirección de t1 a t2 (y desde entonces no se
+     * escribió en ella), regresa el temporal existente en lugar de emitir otra conversión,
+     * p. ej. `i` convertido a double en cada término de un polinomio.
+     * 
+     * @param dir Dirección del operando origen
+     * @param t1 Tipo del operando origen
+     * @param t2 Tipo al que se quiere convertir
+     * @param gen Generador donde se emite la conversión (ver CodeGenerator::endBlock)
+     * @return Dirección con el valor convertido
+     * @throws std::runtime_error si conversión no es válida
+     */
+    std::string ampliar(const std::string& dir, int t1, int t2, CodeGenerator& gen) const; // TypeManager.cpp
+
     /**
      * reducir - Maneja conversión explícita a tipo menor
      * Según el libro Aho: Las conversiones explícitas requieren de un casting
@@ -168,7 +361,7 @@ public:
         if (!areCompatible(t1, t2)) {
             throw std::runtime_error("Conversión explícita inválida");
         }
-        if (t1 == t2) {
+        if (typeTable->equivalent(t1, t2)) {
             return dir;
         }
         // En si, deberíamos generar código de casting mas o menos así
@@ -182,6 +375,18 @@ public:
 
     // Funciones Auxiliares
 
+    /**
+     * Verifica si un tipo es de punto flotante (float o double)
+     * Sirve para decidir si una operación entre constantes trunca (entera) o no
+     * 
+     * @param typeId ID del tipo a verificar
+     * @return true si es float o double
+     */
+    bool isFloating(int typeId) const {
+        int rank = rankOf(typeTable->ref(typeId));
+        return rank == 4 || rank == 5;
+    }
+
     /**
      * Verifica si dos tipos son compatibles para operaciones binarias
      * 
@@ -190,7 +395,7 @@ public:
      * @return true si son compatibles
      */
     bool areCompatible(int t1, int t2) const {
-        if (t1 == t2) {
+        if (typeTable->equivalent(t1, t2)) {
             return true;
         }
         return isNumericType(t1) && isNumericType(t2);
@@ -205,21 +410,85 @@ public:
      * @return true si la conversión es válida
      */
     bool isValidConversion(int t1, int t2, bool isImplicit) const {
-        if (t1 == t2) {
+        if (typeTable->equivalent(t1, t2)) {
             return true;
         }
         
-        if (!isNumericType(t1) || !isNumericType(t2)) {
+        int t1Priority = numericRank(t1);
+        int t2Priority = numericRank(t2);
+        if (t1Priority < 0 || t2Priority < 0) {
             return false;
         }
         
-        int t1Priority = getPriority(t1);
-        int t2Priority = getPriority(t2);
-        
         if (isImplicit) {
             return t1Priority < t2Priority;
         } else {
             return true;
         }
     }
+
+    // API por lotes
+
+    /**
+     * Prepara la retícula de checkBatch para los tipos registrados hasta ahora
+     * 
+     * checkBatch la actualiza sola si se agregaron tipos; llamarla antes es necesario solo
+     * si varios hilos van a usar checkBatch al mismo tiempo.
+     */
+    void prepareBatch() const {
+        if (lattice.empty()) {
+            buildLattice();
+        }
+        for (int id = static_cast<int>(typeClass.size()); id < typeTable->count(); ++id) {
+            typeClass.push_back(classOf(id));
+            typeCanon.push_back(typeTable->canonicalId(id));
+        }
+    }
+
+    // Ruta de checkBatch: AUTO usa AVX2 si el procesador lo tiene; SCALAR y AVX2 la fuerzan.
+    // Forzar AVX2 sin soporte lanza std::runtime_error en vez de caer a la escalar, así una
+    // comparación entre ambas nunca compara la escalar consigo misma.
+    enum class BatchPath { AUTO, SCALAR, AVX2 };
+
+    // ¿El procesador donde corre el programa soporta la ruta AVX2?
+    static bool batchAvx2Available() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * checkBatch - Revisa n operaciones de tipos en una sola pasada
+     * 
+     * Pensado para un árbol de expresión aplanado en arreglos contiguos. Para cada i:
+     * result[i] es lo que regresaría la función escalar correspondiente a ops[i] (un ID de
+     * tipo en MAX/MIN, 0 o 1 en los predicados) y error[i] vale 1 cuando la función escalar
+     * lanzaría una excepción (result[i] = -1). Un ID fuera de la tabla también es error.
+     * 
+     * Si el procesador tiene AVX2 (se revisa al ejecutar, no al compilar) se procesan 8
+     * elementos por iteración con gathers sobre la retícula; si no, se usa la versión
+     * escalar, con los mismos resultados. Con path = AVX2 y sin soporte lanza
+     * std::runtime_error antes de escribir nada.
+     */
+    void checkBatch(const int32_t* t1, const int32_t* t2, const TypeOp* ops, size_t n,
+                    int32_t* result, uint8_t* error, BatchPath path = BatchPath::AUTO) const {
+        if (path == BatchPath::AVX2 && !batchAvx2Available()) {
+            throw std::runtime_error("checkBatch: el procesador no soporta la ruta AVX2");
+        }
+        prepareBatch();
+        size_t i = 0;
+
+#if defined(__x86_64__) || defined(__i386__)
+        if (path != BatchPath::SCALAR && batchAvx2Available()) {
+            i = checkBatchAvx2(t1, t2, ops, n, result, error);
+        }
+#else
+        (void)path;
+#endif
+        for (; i < n; ++i) {
+            checkOne(t1[i], t2[i], static_cast<int32_t>(ops[i]), result[i], error[i]);
+        }
+    }
 };
@@ -1,108 +1,510 @@
 #include "TypeTable.hpp"
+#include "SymbolTable.hpp"
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+
+namespace {
+    // Redondea `value` hacia arriba al múltiplo de `align` (potencia de 2)
+    int alignUp(int value, int align) {
+        return (value + align - 1) & ~(align - 1);
+    }
+
+    void checkId(bool exists) {
+        if (!exists) {
+            throw std::out_of_range("ID de tipo fuera de rango");
+        }
+    }
+}
 
 // Constructor: Actualmente no requiere inicialización compleja
-TypeTable::TypeTable() {
+TypeTable::TypeTable() : TypeTable(std::pmr::get_default_resource()) {
     // Opcionalmente se podría inicializar con un tipo "inválido" o "error" en el índice 0
 }
 
+// Cada contenedor recibe el recurso en su asignador
+TypeTable::TypeTable(std::pmr::memory_resource* memoryResource)
+    : resource(memoryResource), slots(resource), arrays(resource), structs(resource),
+      frozenFields(resource), nameOf(resource), names(resource), nameIndex(resource),
+      prints(resource), lazyStructs(resource), compat(makeInResource<CompatEntries>(resource, resource)),
+      compatById(resource), canonical(resource), canonicalByShape(resource), canonicalArrays(resource) {
+}
+
+// Los miembros ResourcePtr<SymbolTable> y ResourcePtr<FrozenSymbolTable> requieren el
+// tipo completo aquí
+TypeTable::~TypeTable() = default;
+TypeTable::TypeTable(TypeTable&&) noexcept = default;
+TypeTable& TypeTable::operator=(TypeTable&&) noexcept = default;
+
+// La capa empieza vacía: solo toma la base, su número de tipos y la huella acumulada
+TypeTable::TypeTable(std::shared_ptr<const TypeTable> baseTable, std::pmr::memory_resource* memoryResource)
+    : TypeTable(memoryResource) {
+    baseCount = baseTable->count();
+    tablePrint = baseTable->tablePrint;
+    base = std::move(baseTable);
+}
+
+TypeTable TypeTable::overlay(std::shared_ptr<const TypeTable> base, std::pmr::memory_resource* memoryResource) {
+    if (!base) {
+        throw std::invalid_argument("overlay requiere una tabla base");
+    }
+    return TypeTable(std::move(base), memoryResource);
+}
+
+int TypeTable::findCanonicalArray(uint64_t shape) const {
+    if (base) {
+        int id = base->findCanonicalArray(shape);
+        if (id >= 0) {
+            return id;
+        }
+    }
+    auto it = canonicalArrays.find(shape);
+    return it == canonicalArrays.end() ? -1 : it->second;
+}
+
+int TypeTable::findCanonicalShape(const Shape& shape) const {
+    if (base) {
+        int id = base->findCanonicalShape(shape);
+        if (id >= 0) {
+            return id;
+        }
+    }
+    auto it = canonicalByShape.find(shape);
+    return it == canonicalByShape.end() ? -1 : it->second;
+}
+
+// Regresa el índice del nombre, guardándolo si es la primera vez que aparece
+int32_t TypeTable::intern(const std::string& name) {
+    auto it = nameIndex.find(name);
+    if (it != nameIndex.end()) {
+        return it->second;
+    }
+    int32_t index = static_cast<int32_t>(names.size());
+    names.emplace_back(name, CountingAllocator<char, MemoryCategory::NAMES>(resource));
+    nameIndex.emplace(names.back(), index);
+    return index;
+}
+
+// Agrega la entrada caliente de un tipo y regresa su ID
+int TypeTable::pushType(TypeKind kind, int32_t nameId, int size, int32_t payload, const Fingerprint& print) {
+    int id = count(); // El ID sigue al último tipo (de la base o propio)
+    slots.push_back({kind, size, payload});
+    compatById.emplace_back(nullptr);
+    nameOf.push_back(nameId);
+    prints.push_back(print);
+    tablePrint += slotPrint(id, print);
+    return id;
+}
+
 // Agrega un tipo básico a la tabla
 int TypeTable::addBasicType(const std::string& name, int size) {
-    TypeEntry entry;
-    entry.id = static_cast<int>(types.size()); // El ID es el índice actual en el vector
-    entry.kind = TypeKind::BASIC;
-    entry.name = name;
-    entry.size = size;
-    // Inicializamos campos no usados con valores por defecto
-    entry.elements = 0;
-    entry.baseTypeId = -1;
-    entry.structFields = nullptr;
-    
-    types.push_back(entry);
-    return entry.id; // Retorna el ID asignado
+    // Los tipos básicos no tienen datos extra
+    Fingerprint print = FingerprintBuilder().add(static_cast<int>(TypeKind::BASIC), size).add(name).result();
+    int id = pushType(TypeKind::BASIC, intern(name), size, -1, print);
+    canonical.push_back(id); // Los tipos básicos son nominales
+    return id; // Retorna el ID asignado
 }
 
 // Agrega un tipo arreglo (ej: int[10])
 int TypeTable::addArrayType(int baseTypeId, int elements) {
     // Validar que el tipo base exista
-    if (baseTypeId < 0 || baseTypeId >= static_cast<int>(types.size())) {
+    if (!exists(baseTypeId)) {
         throw std::runtime_error("ID de tipo base inválido para arreglo");
     }
 
-    TypeEntry entry;
-    entry.id = static_cast<int>(types.size());
-    entry.kind = TypeKind::ARRAY;
-    
     // Construir nombre compuesto, ej: "int[10]"
-    const TypeEntry& base = types[baseTypeId];
-    entry.name = base.name + "[" + std::to_string(elements) + "]";
-    
+    std::string name = std::string(nameUnchecked(baseTypeId)) + "[" + std::to_string(elements) + "]";
+
     // El tamaño total es el tamaño del tipo base multiplicado por la cantidad de elementos
-    entry.size = base.size * elements;
-    entry.elements = elements;
-    entry.baseTypeId = baseTypeId;
-    entry.structFields = nullptr;
-    
-    types.push_back(entry);
-    return entry.id;
+    int32_t payload = static_cast<int32_t>(arrays.size());
+    int size = sizeUnchecked(baseTypeId) * elements;
+    arrays.push_back({elements, baseTypeId});
+    Fingerprint print = FingerprintBuilder().add(static_cast<int>(TypeKind::ARRAY), elements).add(printOf(baseTypeId)).result();
+    int id = pushType(TypeKind::ARRAY, intern(name), size, payload, print);
+
+    uint64_t shape = (static_cast<uint64_t>(canonicalOf(baseTypeId)) << 32) | static_cast<uint32_t>(elements);
+    int representative = findCanonicalArray(shape);
+    if (representative < 0) {
+        representative = id;
+        canonicalArrays.emplace(shape, id);
+    }
+    canonical.push_back(representative);
+    return id;
+}
+
+// Agrega la entrada de una estructura con la huella de sus campos, sin ID canónico
+int TypeTable::pushStruct(const std::string& name, int size, SymbolTable* fields, const std::vector<FieldShape>& shape) {
+    int32_t payload = static_cast<int32_t>(structs.size());
+    structs.push_back({fields, nullptr}); // Guarda la referencia a la tabla de campos del struct
+    return pushType(TypeKind::STRUCT, intern(name), size, payload, structPrint(count(), name, size, shape));
 }
 
 // Agrega un tipo estructura (struct)
 int TypeTable::addStructType(const std::string& name, int size, SymbolTable* fields) {
-    TypeEntry entry;
-    entry.id = static_cast<int>(types.size());
-    entry.kind = TypeKind::STRUCT;
-    entry.name = name;
-    entry.size = size;
-    entry.elements = 0;
-    entry.baseTypeId = -1;
-    entry.structFields = fields; // Guarda la referencia a la tabla de campos del struct
-    
-    types.push_back(entry);
-    return entry.id;
+    std::vector<FieldShape> shape;
+    if (fields) {
+        fields->forEach([&](const SymbolEntry& field) {
+            shape.push_back({std::string(field.id), field.typeId, field.address});
+        });
+    }
+    int id = pushStruct(name, size, fields, shape);
+
+    if (fields) {
+        registerCanonical(id, structShape(id, size, std::move(shape)));
+    } else {
+        canonical.push_back(id); // Sin campos conocidos: nominal
+    }
+    return id;
+}
+
+// Asigna el ID canónico de la forma (o registra este tipo como su representante)
+void TypeTable::registerCanonical(int id, const std::string& shape) {
+    Shape key(shape, CountingAllocator<char, MemoryCategory::KEYS>(resource));
+    int representative = findCanonicalShape(key);
+    if (representative < 0) {
+        representative = id;
+        canonicalByShape.emplace(std::move(key), id);
+    }
+    canonical.push_back(representative);
+}
+
+// Forma de una estructura: tamaño y campos ordenados por dirección y nombre
+std::string TypeTable::structShape(int id, int size, std::vector<FieldShape> fields) const {
+    std::sort(fields.begin(), fields.end(), [](const FieldShape& a, const FieldShape& b) {
+        return a.address != b.address ? a.address < b.address : a.name < b.name;
+    });
+
+    std::string shape = "S" + std::to_string(size) + "{";
+    for (const FieldShape& field : fields) {
+        // Un campo del mismo tipo que la estructura (o de un tipo aún no registrado) se
+        // representa por su ID tal cual
+        int fieldType = (field.typeId >= 0 && field.typeId < id) ? canonicalOf(field.typeId) : field.typeId;
+        shape += field.name + ":" + std::to_string(fieldType) + "@" + std::to_string(field.address) + ";";
+    }
+    return shape + "}";
+}
+
+// Huella de una estructura: los campos se suman (sin orden), cada uno con la huella de su tipo
+Fingerprint TypeTable::structPrint(int id, const std::string& name, int size, const std::vector<FieldShape>& fields) const {
+    Fingerprint sum;
+    for (const FieldShape& field : fields) {
+        FingerprintBuilder builder;
+        builder.add(field.name).add(field.address);
+        if (field.typeId >= 0 && field.typeId < id) {
+            builder.add(printOf(field.typeId));
+        } else {
+            builder.add(field.typeId);
+        }
+        sum += builder.result();
+    }
+    return FingerprintBuilder()
+        .add(static_cast<int>(TypeKind::STRUCT), size)
+        .add(name)
+        .add(sum)
+        .add(static_cast<uint64_t>(fields.size()))
+        .result();
+}
+
+// Solo valida el ID: no arma la entrada de get() ni anota la lectura
+Fingerprint TypeTable::fingerprint(int id) const {
+    checkId(exists(id));
+    return printOf(id);
+}
+
+int TypeTable::canonicalId(int id) const {
+    checkId(exists(id));
+    touch(id);
+    return canonicalOf(id);
+}
+
+// Agrega una estructura perezosa (sin construir su tabla de campos)
+int TypeTable::addLazyStructType(const std::string& name, int size, LazyStructDescriptor descriptor) {
+    // Se valida todo el descriptor antes de registrar nada: un campo inválido no deja un
+    // tipo a medio agregar
+    if (!descriptor.source && !descriptor.fields.empty()) {
+        throw std::invalid_argument("Descriptor de estructura con campos y sin búfer fuente");
+    }
+    size_t sourceSize = descriptor.source ? descriptor.source->size() : 0;
+    for (const LazyField& field : descriptor.fields) {
+        if (!exists(field.typeId)) {
+            throw std::runtime_error("ID de tipo inválido para campo de estructura");
+        }
+        if (field.nameOffset > sourceSize || field.nameLength > sourceSize - field.nameOffset) {
+            throw std::out_of_range("Nombre de campo fuera del búfer del descriptor");
+        }
+    }
+
+    // La huella y la forma canónica salen del descriptor, sin construir la tabla de campos
+    std::vector<FieldShape> shape;
+    int offset = 0;
+    for (const LazyField& field : descriptor.fields) {
+        offset = alignUp(offset, alignmentOf(field.typeId));
+        shape.push_back({descriptor.source->substr(field.nameOffset, field.nameLength), field.typeId, offset});
+        offset += getSize(field.typeId);
+    }
+    int id = pushStruct(name, size, nullptr, shape);
+    registerCanonical(id, structShape(id, size, std::move(shape)));
+
+    auto lazy = makeInResource<LazyStruct>(resource);
+    lazy->descriptor = std::move(descriptor);
+    lazyStructs.emplace(id, std::move(lazy));
+    return id;
+}
+
+// Construye la tabla de campos de una estructura perezosa (una sola vez, aun entre hilos)
+void TypeTable::materialize(const LazyStruct& lazy) const {
+    std::call_once(lazy.built, [&] {
+        auto fields = makeInResource<SymbolTable>(resource, resource);
+        // Sin campos el búfer puede faltar
+        std::string_view source = lazy.descriptor.source ? std::string_view(*lazy.descriptor.source) : std::string_view();
+        int offset = 0;
+        for (const LazyField& field : lazy.descriptor.fields) {
+            offset = alignUp(offset, alignmentOf(field.typeId));
+            SymbolEntry entry(source.substr(field.nameOffset, field.nameLength), field.typeId, Category::VAR, offset,
+                              {}, resource);
+            fields->insert(entry);
+            offset += getSize(field.typeId);
+        }
+        // Se publica al final: quien vea `published` distinto de nullptr ve la tabla completa
+        lazy.fields = std::move(fields);
+        lazy.published.store(lazy.fields.get(), std::memory_order_release);
+    });
 }
 
 // Verifica si un ID existe en la tabla
 bool TypeTable::exists(int id) const {
-    return id >= 0 && id < static_cast<int>(types.size());
+    return id >= 0 && id < count();
 }
 
-// Obtiene la entrada completa de un tipo
-const TypeEntry& TypeTable::get(int id) const {
+// Arma la vista completa de un tipo
+TypeEntryView TypeTable::view(int id) const {
     if (!exists(id)) {
         throw std::out_of_range("ID de tipo fuera de rango");
     }
-    return types[id];
+    touch(id);
+    if (id < baseCount) {
+        return base->view(id);
+    }
+    const TypeSlot& slot = slots[id - baseCount];
+
+    TypeEntryView entry;
+    entry.id = id;
+    entry.kind = slot.kind;
+    entry.name = names[nameOf[id - baseCount]];
+    entry.size = slot.size;
+    // Campos que no aplican al tipo llevan valores por defecto
+    entry.elements = slot.kind == TypeKind::ARRAY ? arrays[slot.payload].elements : 0;
+    entry.baseTypeId = slot.kind == TypeKind::ARRAY ? arrays[slot.payload].baseTypeId : -1;
+    entry.structFields = slot.kind == TypeKind::STRUCT ? structs[slot.payload].fields : nullptr;
+    if (slot.kind == TypeKind::STRUCT && !entry.structFields) {
+        entry.structFields = builtLazyFields(id);
+    }
+    return entry;
+}
+
+// Entrada de compatibilidad: se arma una vez por tipo (y otra si una estructura perezosa
+// se construyó después, para que structFields deje de ser nullptr)
+const TypeEntry& TypeTable::get(int id) const {
+    if (id >= 0 && id < baseCount) {
+        touch(id);
+        return base->get(id);
+    }
+    TypeEntryView current = view(id);
+    auto stale = [&](const TypeEntry* entry) {
+        return !entry || entry->structFields != current.structFields;
+    };
+    CompatSlot& slot = compatById[id - baseCount];
+    const TypeEntry* entry = slot.load(std::memory_order_acquire);
+    if (stale(entry)) {
+        std::lock_guard<std::mutex> lock(compat->mutex);
+        entry = slot.load(std::memory_order_relaxed);
+        if (stale(entry)) {
+            compat->storage.push_back({current.id, current.kind, std::string(current.name), current.size,
+                                       current.elements, current.baseTypeId, current.structFields});
+            entry = &compat->storage.back();
+            slot.store(entry, std::memory_order_release);
+        }
+    }
+    return *entry;
 }
 
 // --- Implementación de Getters específicos ---
+// Leen directo del almacenamiento compacto, sin armar la vista completa (los IDs de la
+// base, a través de ella)
 
 std::string TypeTable::getName(int id) const {
-    return get(id).name;
+    checkId(exists(id));
+    touch(id);
+    return std::string(id < baseCount ? base->nameUnchecked(id) : names[nameOf[id - baseCount]]);
+}
+
+std::string_view TypeTable::getNameView(int id) const {
+    checkId(exists(id));
+    touch(id);
+    return id < baseCount ? base->nameUnchecked(id) : names[nameOf[id - baseCount]];
 }
 
 int TypeTable::getSize(int id) const {
-    return get(id).size;
+    checkId(exists(id));
+    touch(id);
+    return id < baseCount ? base->sizeUnchecked(id) : slots[id - baseCount].size;
+}
+
+int TypeTable::alignmentOf(int id) const {
+    checkId(exists(id));
+    touch(id);
+    return alignmentUnchecked(id);
+}
+
+// El tipo base de un arreglo puede estar en la base aunque el arreglo sea propio
+int TypeTable::alignmentUnchecked(int id) const {
+    while (kindUnchecked(id) == TypeKind::ARRAY) {
+        id = baseTypeUnchecked(id);
+    }
+    int align = 1;
+    while (align * 2 <= sizeUnchecked(id) && align < 8) {
+        align *= 2;
+    }
+    return align;
 }
 
 int TypeTable::getNumElements(int id) const {
-    return get(id).elements;
+    checkId(exists(id));
+    touch(id);
+    if (id < baseCount) {
+        return base->numElementsUnchecked(id);
+    }
+    const TypeSlot& slot = slots[id - baseCount];
+    return slot.kind == TypeKind::ARRAY ? arrays[slot.payload].elements : 0;
 }
 
 int TypeTable::getBaseType(int id) const {
-    return get(id).baseTypeId;
+    checkId(exists(id));
+    touch(id);
+    if (id < baseCount) {
+        return base->baseTypeUnchecked(id);
+    }
+    const TypeSlot& slot = slots[id - baseCount];
+    return slot.kind == TypeKind::ARRAY ? arrays[slot.payload].baseTypeId : -1;
 }
 
 SymbolTable* TypeTable::getStructFields(int id) const {
-    return get(id).structFields;
+    checkId(exists(id));
+    touch(id);
+    if (id < baseCount) {
+        return base->getStructFields(id);
+    }
+    const TypeSlot& slot = slots[id - baseCount];
+    if (slot.kind != TypeKind::STRUCT) {
+        return nullptr;
+    }
+    if (!lazyStructs.empty()) {
+        auto it = lazyStructs.find(id);
+        if (it != lazyStructs.end()) {
+            materialize(*it->second);
+            return it->second->published.load(std::memory_order_acquire);
+        }
+    }
+    return structs[slot.payload].fields;
+}
+
+const SymbolEntry* TypeTable::lookupMember(int id, const std::string& field) const {
+    if (const FrozenSymbolTable* frozen = getFrozenFields(id)) {
+        return frozen->lookup(field);
+    }
+    SymbolTable* fields = getStructFields(id);
+    return fields ? fields->lookup(field) : nullptr;
+}
+
+void TypeTable::freezeStructFields(int id) {
+    checkId(exists(id));
+    if (id < baseCount) {
+        return;
+    }
+    SymbolTable* fields = getStructFields(id);
+    if (!fields || structs[slots[id - baseCount].payload].frozen) {
+        return;
+    }
+    frozenFields.push_back(makeInResource<FrozenSymbolTable>(resource, fields->freeze(resource)));
+    structs[slots[id - baseCount].payload].frozen = frozenFields.back().get();
+}
+
+void TypeTable::freezeStructFields() {
+    for (int id = baseCount; id < count(); ++id) {
+        const TypeSlot& slot = slots[id - baseCount];
+        if (slot.kind == TypeKind::STRUCT && !structs[slot.payload].frozen) {
+            freezeStructFields(id);
+        }
+    }
+}
+
+const FrozenSymbolTable* TypeTable::getFrozenFields(int id) const {
+    checkId(exists(id));
+    touch(id);
+    if (id < baseCount) {
+        return base->getFrozenFields(id);
+    }
+    const TypeSlot& slot = slots[id - baseCount];
+    return slot.kind == TypeKind::STRUCT ? structs[slot.payload].frozen : nullptr;
+}
+
+bool TypeTable::isMaterialized(int id) const {
+    if (id >= 0 && id < baseCount) {
+        return base->isMaterialized(id);
+    }
+    auto it = lazyStructs.find(id);
+    return it == lazyStructs.end() || it->second->published.load(std::memory_order_acquire) != nullptr;
+}
+
+SymbolTable* TypeTable::builtLazyFields(int id) const {
+    if (lazyStructs.empty()) {
+        return nullptr;
+    }
+    auto it = lazyStructs.find(id);
+    return it == lazyStructs.end() ? nullptr : it->second->published.load(std::memory_order_acquire);
+}
+
+MemoryUsage TypeTable::memoryUsage() const {
+    MemoryUsage usage;
+    usage.entries = vectorBytes(slots) + vectorBytes(arrays) + vectorBytes(structs) +
+                    vectorBytes(nameOf) + vectorBytes(canonical) + vectorBytes(frozenFields) +
+                    vectorBytes(prints);
+    usage.names = names.size() * sizeof(Name);
+    for (const auto& name : names) {
+        usage.names += stringHeapBytes(name);
+    }
+    // Entradas de compatibilidad que get() ya armó
+    usage.entries += compatById.size() * sizeof(std::atomic<const TypeEntry*>);
+    {
+        std::lock_guard<std::mutex> lock(compat->mutex);
+        usage.entries += compat->storage.size() * sizeof(TypeEntry);
+        for (const TypeEntry& entry : compat->storage) {
+            usage.names += stringHeapBytes(entry.name);
+        }
+    }
+    usage.buckets = hashMapBytes(nameIndex) + hashMapBytes(canonicalByShape) +
+                    hashMapBytes(canonicalArrays) + hashMapBytes(lazyStructs);
+    for (const auto& shape : canonicalByShape) {
+        usage.keys += stringHeapBytes(shape.first);
+    }
+    for (const auto& lazy : lazyStructs) {
+        usage.entries += sizeof(LazyStruct) + vectorBytes(lazy.second->descriptor.fields);
+        if (const SymbolTable* fields = lazy.second->published.load(std::memory_order_acquire)) {
+            usage += fields->memoryUsage();
+        }
+    }
+    for (const auto& frozen : frozenFields) {
+        usage += frozen->memoryUsage();
+    }
+    return usage;
 }
 
 // Imprime el contenido de la tabla para depuración
 void TypeTable::print() const {
     std::cout << "=== Tabla de Tipos ===\n";
     std::cout << "ID\tNombre\tTam\tTipo\tElem\tBase\n";
-    for (const auto& t : types) {
+    for (int id = 0; id < count(); ++id) {
+        TypeEntryView t = view(id);
         std::string kindStr;
         switch (t.kind) {
             case TypeKind::BASIC: kindStr = "BASIC"; break;
@@ -1,9 +1,22 @@
 #pragma once
+#include <atomic>
+#include <cassert>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <deque>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <unordered_map>
 
-class SymbolTable; // Declaración adelantada (Forward declaration) para evitar dependencias circulares
+#include "DependencyTracker.hpp"
+#include "Fingerprint.hpp"
+#include "MemoryAccounting.hpp"
+#include "SymbolTableFwd.hpp" // Declaración adelantada (Forward declaration) para evitar dependencias circulares
 
 // Enumeración para distinguir los tipos de datos soportados
 enum class TypeKind {
@@ -12,7 +25,7 @@ enum class TypeKind {
     STRUCT  // Estructuras definidas por el usuario
 };
 
-// Estructura que almacena toda la información de un tipo
+// Estructura que almacena toda la información de un tipo (la regresa TypeTable::get)
 struct TypeEntry {
     int id;             // Identificador numérico único
     TypeKind kind;      // Categoría del tipo (Básico, Arreglo, Estructura)
@@ -27,14 +40,191 @@ struct TypeEntry {
     SymbolTable* structFields; // Puntero a la tabla de símbolos que contiene los campos de la estructura
 };
 
+// Los mismos datos que TypeEntry armados al momento desde el almacenamiento compacto, sin
+// copiar el nombre (ver TypeTable::view). `name` apunta al nombre internado en la tabla y
+// vive lo mismo que ella.
+struct TypeEntryView {
+    int id;
+    TypeKind kind;
+    std::string_view name;
+    int size;
+    int elements;
+    int baseTypeId;
+    SymbolTable* structFields;
+};
+
+// Campo de una estructura perezosa: el nombre es un rango dentro del búfer fuente
+struct LazyField {
+    size_t nameOffset;  // Inicio del nombre en el búfer
+    size_t nameLength;  // Longitud del nombre
+    int typeId;         // Tipo del campo
+};
+
+// Descripción barata de una estructura cuyos campos aún no se han construido
+struct LazyStructDescriptor {
+    std::shared_ptr<const std::string> source; // Búfer (p. ej. el texto del encabezado)
+    std::vector<LazyField> fields;             // Campos en orden de declaración
+};
+
+class TypeRef;
+
 // Clase que administra la Tabla de Tipos
 class TypeTable {
 private:
-    std::vector<TypeEntry> types; // Almacenamiento principal de los tipos. El índice del vector es el ID del tipo.
+    // Recurso del que salen los contenedores internos, nombres y tablas de campos
+    std::pmr::memory_resource* resource;
+
+    // Capa (ver overlay): los IDs 0..baseCount-1 son de `base` y se le consultan a ella;
+    // los arreglos de abajo guardan solo los tipos propios, indexados por id - baseCount
+    std::shared_ptr<const TypeTable> base;
+    int baseCount = 0;
+
+    // --- Almacenamiento compacto ---
+    // Arreglo caliente: lo que se consulta en cada comprobación de tipos (12 bytes por tipo).
+    // El índice del vector es id - baseCount; payload indexa arrays o structs según kind.
+    struct TypeSlot {
+        TypeKind kind;
+        int32_t size;
+        int32_t payload;
+    };
+    struct ArrayPayload {
+        int32_t elements;
+        int32_t baseTypeId;
+    };
+    struct StructPayload {
+        SymbolTable* fields;
+        const FrozenSymbolTable* frozen; // Copia congelada de fields (ver freezeStructFields)
+    };
+
+    template <typename T>
+    using Entries = std::vector<T, CountingAllocator<T, MemoryCategory::ENTRIES>>;
+
+    Entries<TypeSlot> slots;
+    Entries<ArrayPayload> arrays;
+    Entries<StructPayload> structs;
+    Entries<ResourcePtr<FrozenSymbolTable>> frozenFields; // Dueño de las copias congeladas
+
+    // Nombres internados: cada nombre distinto se guarda una vez (el deque no mueve sus
+    // elementos, así las vistas siguen válidas al agregar tipos)
+    Entries<int32_t> nameOf;               // ID propio -> índice de nombre
+    using Name = CountedString<MemoryCategory::NAMES>;
+    std::deque<Name, CountingAllocator<Name, MemoryCategory::NAMES>> names;
+    std::unordered_map<std::string_view, int32_t, std::hash<std::string_view>, std::equal_to<std::string_view>,
+                       CountingAllocator<std::pair<const std::string_view, int32_t>, MemoryCategory::BUCKETS>>
+        nameIndex;
+
+    int32_t intern(const std::string& name);
+    int pushType(TypeKind kind, int32_t nameId, int size, int32_t payload, const Fingerprint& print);
+
+    // Huellas estructurales: una por tipo propio (ID -> huella) y la suma de (ID, huella) de
+    // toda la tabla (la base incluida), ambas al día en O(1) por tipo agregado
+    Entries<Fingerprint> prints;
+    Fingerprint tablePrint;
+    const Fingerprint& printOf(int id) const {
+        return id < baseCount ? base->printOf(id) : prints[id - baseCount];
+    }
+    static Fingerprint slotPrint(int id, const Fingerprint& print) {
+        return FingerprintBuilder().add(static_cast<uint64_t>(id)).add(print).result();
+    }
+
+    // Estructuras perezosas: la tabla de campos se construye la primera vez que se pide
+    // La tabla se construye desde métodos const: lo que cambia al construirla es mutable y
+    // se publica con `published` dentro del call_once. La StructPayload de una perezosa
+    // conserva fields = nullptr; los lectores toman la tabla de `published`.
+    struct LazyStruct {
+        LazyStructDescriptor descriptor;
+        mutable std::once_flag built;
+        mutable ResourcePtr<SymbolTable> fields;                 // Dueña de la tabla construida
+        mutable std::atomic<SymbolTable*> published{nullptr};    // fields.get() una vez construida
+    };
+    template <typename K, typename V>
+    using Index = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>,
+                                     CountingAllocator<std::pair<const K, V>, MemoryCategory::BUCKETS>>;
+
+    Index<int, ResourcePtr<LazyStruct>> lazyStructs;
+
+    void materialize(const LazyStruct& lazy) const;
+
+    // Tabla ya construida de una estructura perezosa (sin construirla); nullptr si no es
+    // perezosa o aún no se construye
+    SymbolTable* builtLazyFields(int id) const;
+
+    // Entradas de compatibilidad de get(): la TypeEntry de un tipo se arma la primera vez que
+    // se pide y se publica con un puntero atómico, así los lectores no toman candado. Las
+    // entradas viven en `storage` (un deque no mueve sus elementos), de modo que las
+    // referencias que regresa get() siguen válidas al agregar tipos.
+    struct CompatEntries {
+        std::mutex mutex;
+        std::deque<TypeEntry, CountingAllocator<TypeEntry, MemoryCategory::ENTRIES>> storage;
+
+        explicit CompatEntries(std::pmr::memory_resource* resource) : storage(resource) {}
+    };
+    ResourcePtr<CompatEntries> compat;
+    using CompatSlot = std::atomic<const TypeEntry*>;
+    mutable std::deque<CompatSlot, CountingAllocator<CompatSlot, MemoryCategory::ENTRIES>> compatById; // Uno por tipo; nullptr = sin armar
+
+    // Registro de dependencias opcional (no es dueño): cada consulta de un tipo se anota
+    DependencyTracker* tracker = nullptr;
+    void touch(int id) const {
+        if (tracker) {
+            tracker->recordType(id);
+        }
+    }
+
+    // Canonicalización: tipos estructuralmente iguales comparten un ID canónico, así la
+    // equivalencia estructural es una sola comparación de enteros
+    Entries<int> canonical;                              // ID propio -> ID canónico
+    using Shape = CountedString<MemoryCategory::KEYS>;
+    struct ShapeHash {
+        size_t operator()(const Shape& shape) const { return std::hash<std::string_view>()(shape); }
+    };
+    std::unordered_map<Shape, int, ShapeHash, std::equal_to<Shape>,
+                       CountingAllocator<std::pair<const Shape, int>, MemoryCategory::BUCKETS>>
+        canonicalByShape;                                // Forma de struct -> ID canónico
+    Index<uint64_t, int> canonicalArrays;                // (base canónica, elementos) -> ID canónico
+    int canonicalOf(int id) const {
+        return id < baseCount ? base->canonicalOf(id) : canonical[id - baseCount];
+    }
+    // Representante ya registrado (en la base o en esta capa); -1 si no hay
+    int findCanonicalArray(uint64_t shape) const;
+    int findCanonicalShape(const Shape& shape) const;
+
+    struct FieldShape {
+        std::string name;
+        int typeId;
+        int address;
+    };
+    void registerCanonical(int id, const std::string& shape);
+    std::string structShape(int id, int size, std::vector<FieldShape> fields) const;
+    Fingerprint structPrint(int id, const std::string& name, int size, const std::vector<FieldShape>& fields) const;
+
+    // Agrega la entrada de una estructura (huella incluida) sin registrar su ID canónico
+    int pushStruct(const std::string& name, int size, SymbolTable* fields, const std::vector<FieldShape>& shape);
+
+    TypeTable(std::shared_ptr<const TypeTable> baseTable, std::pmr::memory_resource* resource);
+    int alignmentUnchecked(int id) const;
 
 public:
     TypeTable();
-    ~TypeTable() = default;
+
+    // Todo lo que la tabla reserva sale de `resource`, que debe vivir más que la tabla:
+    // los arreglos internos, los nombres, las formas canónicas, las estructuras perezosas
+    // y las tablas de campos que construye (objetos y entradas). La única excepción es el
+    // nombre (std::string) de las TypeEntry que arma get(); view() y getNameView no
+    // copian el nombre.
+    explicit TypeTable(std::pmr::memory_resource* resource);
+    ~TypeTable();
+    TypeTable(TypeTable&&) noexcept;
+    TypeTable& operator=(TypeTable&&) noexcept;
+
+    // Capa sobre `base`: ve todos sus tipos (mismos IDs, nombres, IDs canónicos y huellas)
+    // y crece por su cuenta, con IDs a partir de base->count(). Pensada para que cada unidad
+    // de compilación extienda un preludio compartido: no copia nada de la base, las
+    // consultas de sus IDs se le pasan a ella y la capa guarda (en `resource`) solo sus
+    // propios tipos. La base no debe modificarse mientras tenga capas; sus estructuras
+    // perezosas se construyen en la base (con su recurso) al pedirlas desde una capa.
+    static TypeTable overlay(std::shared_ptr<const TypeTable> base,
+                             std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     // --- Métodos para creación de tipos ---
     
@@ -47,21 +237,194 @@ public:
     // Agrega un tipo estructura con sus campos definidos en una tabla de símbolos
     int addStructType(const std::string& name, int size, SymbolTable* fields);
 
+    // Agrega una estructura perezosa: solo guarda el descriptor. La SymbolTable de campos
+    // (cada campo tras el anterior, alineado según alignmentOf) se construye en la
+    // primera llamada a getStructFields o lookupMember. Hasta entonces
+    // get(id).structFields es nullptr. Lanza excepción, sin registrar nada, si un campo
+    // tiene un tipo inexistente o un nombre fuera del búfer, o si hay campos sin búfer.
+    int addLazyStructType(const std::string& name, int size, LazyStructDescriptor descriptor);
+
     // --- Consultas Generales ---
     
     // Verifica si un ID de tipo es válido
     bool exists(int id) const;
+
+    // ID canónico: el primer tipo registrado con la misma estructura. Los básicos son
+    // nominales; los arreglos se identifican por (tipo base canónico, elementos); las
+    // estructuras por su tamaño y sus campos (nombre, tipo canónico, dirección). La
+    // estructura de un struct se toma al agregarlo; cambios posteriores a su tabla de
+    // campos no se reflejan.
+    int canonicalId(int id) const;
+
+    // Equivalencia estructural en O(1). Solo se anotan en el registro de dependencias los
+    // IDs que existen: uno fuera de rango haría crecer sus arreglos sin motivo.
+    bool equivalent(int t1, int t2) const {
+        bool valid1 = exists(t1);
+        bool valid2 = exists(t2);
+        if (valid1) {
+            touch(t1);
+        }
+        if (valid2) {
+            touch(t2);
+        }
+        return t1 == t2 || (valid1 && valid2 && canonicalOf(t1) == canonicalOf(t2));
+    }
+
+    // Huella estructural de un tipo, estable entre ejecuciones: clase, nombre y tamaño; los
+    // arreglos incluyen la huella de su tipo base y las estructuras la de cada campo
+    // (nombre, dirección y huella de su tipo), sin importar el orden de los campos. Igual
+    // que el ID canónico, se calcula al agregar el tipo. Un campo que apunta a la propia
+    // estructura (o a un tipo posterior) aporta su ID.
+    Fingerprint fingerprint(int id) const;
+
+    // Huella de toda la tabla: cambia si cambia cualquier tipo o su ID
+    Fingerprint fingerprint() const {
+        return FingerprintBuilder().add(tablePrint).add(static_cast<uint64_t>(count())).result();
+    }
+
+    // Número de tipos registrados, los de la base incluidos (los IDs válidos son 0..count()-1)
+    int count() const { return baseCount + static_cast<int>(slots.size()); }
     
-    // Obtiene la entrada completa del tipo (lanza excepción si no existe)
+    // Obtiene la entrada completa del tipo (lanza excepción si no existe). La referencia
+    // sigue válida mientras viva la tabla. La entrada se arma en la primera llamada; para
+    // lecturas sin copiar el nombre usar view(), ref() o los getters específicos.
     const TypeEntry& get(int id) const;
+
+    // La misma información que get() armada al momento desde el almacenamiento compacto,
+    // sin copiar el nombre ni guardar nada (lanza excepción si no existe)
+    TypeEntryView view(int id) const;
     
     // --- Getters Específicos (Simplifican el acceso a propiedades) ---
     std::string getName(int id) const;
+    std::string_view getNameView(int id) const; // Sin copia; vive lo mismo que la tabla
     int getSize(int id) const;
     int getNumElements(int id) const;      // Útil para arreglos
     int getBaseType(int id) const;         // Útil para arreglos
-    SymbolTable* getStructFields(int id) const; // Útil para estructuras
+
+    // Alineación de un tipo: la de su tipo base en arreglos, y para los demás la mayor
+    // potencia de 2 que no exceda su tamaño, con tope de 8. Es la que usan FrameAllocator
+    // y los campos de las estructuras perezosas, para que ambos acomoden igual los tipos.
+    int alignmentOf(int id) const;
+    SymbolTable* getStructFields(int id) const; // Útil para estructuras (construye los campos perezosos)
+
+    // Busca un campo de una estructura; nullptr si no existe o el tipo no tiene campos.
+    // Si la estructura está congelada busca en la copia congelada (una sola prueba).
+    const SymbolEntry* lookupMember(int id, const std::string& field) const;
+
+    // Congela la tabla de campos de una estructura terminada (construye las perezosas).
+    // Desde ahí lookupMember ignora cambios a la tabla original. No es seguro llamarlo
+    // mientras otros hilos consultan la tabla de tipos. Si ya estaba congelada, o es un
+    // tipo de la base de una capa (la base no se modifica), no hace nada.
+    void freezeStructFields(int id);
+
+    // Congela las tablas de campos de todas las estructuras propias
+    void freezeStructFields();
+
+    // Copia congelada de los campos; nullptr si la estructura no se ha congelado
+    const FrozenSymbolTable* getFrozenFields(int id) const;
+
+    // true si la estructura ya tiene su tabla de campos (las no perezosas siempre)
+    bool isMaterialized(int id) const;
     
+    // Conecta (o desconecta con nullptr) un registro de dependencias: get, los getters,
+    // lookupMember, canonicalId y equivalent anotan los IDs consultados en la región abierta
+    void attachDependencyTracker(DependencyTracker* dependencyTracker) { tracker = dependencyTracker; }
+    DependencyTracker* dependencyTracker() const { return tracker; }
+
+    // Bytes de la tabla por categoría: entradas, nombres internados, índices y las tablas
+    // de campos que la TypeTable posee (perezosas materializadas y congeladas). En una capa
+    // no cuenta la base.
+    MemoryUsage memoryUsage() const;
+
     // Función auxiliar para depuración (imprime la tabla en consola)
     void print() const;
+
+    // --- Acceso sin validación (rutas calientes) ---
+    // Para IDs que ya se validaron (p. ej. con ref o exists). No revisan el rango (solo
+    // assert en depuración) ni anotan dependencias.
+    // En una capa, los IDs de la base se le piden a ella.
+    TypeKind kindUnchecked(int id) const {
+        assert(exists(id));
+        return id < baseCount ? base->kindUnchecked(id) : slots[id - baseCount].kind;
+    }
+    std::string_view nameUnchecked(int id) const {
+        assert(exists(id));
+        return id < baseCount ? base->nameUnchecked(id) : names[nameOf[id - baseCount]];
+    }
+    int sizeUnchecked(int id) const {
+        assert(exists(id));
+        return id < baseCount ? base->sizeUnchecked(id) : slots[id - baseCount].size;
+    }
+    int numElementsUnchecked(int id) const {
+        assert(exists(id));
+        if (id < baseCount) {
+            return base->numElementsUnchecked(id);
+        }
+        const TypeSlot& slot = slots[id - baseCount];
+        return slot.kind == TypeKind::ARRAY ? arrays[slot.payload].elements : 0;
+    }
+    int baseTypeUnchecked(int id) const {
+        assert(exists(id));
+        if (id < baseCount) {
+            return base->baseTypeUnchecked(id);
+        }
+        const TypeSlot& slot = slots[id - baseCount];
+        return slot.kind == TypeKind::ARRAY ? arrays[slot.payload].baseTypeId : -1;
+    }
+    // Las estructuras perezosas aún sin construir pasan por getStructFields
+    SymbolTable* structFieldsUnchecked(int id) const {
+        assert(exists(id));
+        if (id < baseCount) {
+            return base->structFieldsUnchecked(id);
+        }
+        const TypeSlot& slot = slots[id - baseCount];
+        if (slot.kind != TypeKind::STRUCT) {
+            return nullptr;
+        }
+        SymbolTable* fields = structs[slot.payload].fields;
+        return fields || lazyStructs.empty() ? fields : getStructFields(id);
+    }
+
+    // Referencia validada: revisa el ID una sola vez (lanza std::out_of_range) y anota la
+    // dependencia; después cada acceso es una lectura directa
+    TypeRef ref(int id) const;
 };
+
+/**
+ * Referencia a un tipo ya validado: un puntero a la tabla y el ID (se pasa por valor).
+ * Se obtiene con TypeTable::ref; las lecturas no vuelven a validar ni copian el nombre.
+ * Sigue siendo válida mientras viva la tabla (agregar tipos no la invalida).
+ */
+class TypeRef {
+private:
+    const TypeTable* table;
+    int typeId;
+
+    friend class TypeTable;
+    TypeRef(const TypeTable* typeTable, int id) : table(typeTable), typeId(id) {}
+
+public:
+    int id() const { return typeId; }
+    TypeKind kind() const { return table->kindUnchecked(typeId); }
+    std::string_view name() const { return table->nameUnchecked(typeId); }
+    int size() const { return table->sizeUnchecked(typeId); }
+    int numElements() const { return table->numElementsUnchecked(typeId); }
+    SymbolTable* structFields() const { return table->structFieldsUnchecked(typeId); }
+
+    // Tipo base de un arreglo (ya validado al agregar el arreglo). Solo para arreglos.
+    TypeRef base() const {
+        assert(kind() == TypeKind::ARRAY);
+        return TypeRef(table, table->baseTypeUnchecked(typeId));
+    }
+
+    bool operator==(const TypeRef& other) const { return typeId == other.typeId && table == other.table; }
+    bool operator!=(const TypeRef& other) const { return !(*this == other); }
+};
+
+inline TypeRef TypeTable::ref(int id) const {
+    if (!exists(id)) {
+        throw std::out_of_range("ID de tipo fuera de rango");
+    }
+    touch(id);
+    return TypeRef(this, id);
+}
@@ -0,0 +1,247 @@
+#include "ValueNumbering.hpp"
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+    bool isCommutative(const std::string &op)
+    {
+        return op == "+" || op == "*";
+    }
+
+    // Bits de un entero de `size` bytes (8 a 64; tamaños raros se tratan como 64)
+    int integerBits(int size)
+    {
+        return size >= 1 && size < 8 ? size * 8 : 64;
+    }
+
+    // ¿Cabe v en un entero con signo de `bits` bits?
+    bool fitsIn(long long v, int bits)
+    {
+        if (bits >= 64)
+            return true;
+        long long limit = 1LL << (bits - 1);
+        return v >= -limit && v < limit;
+    }
+
+    // Reduce v módulo 2^bits al rango con signo (complemento a 2)
+    long long wrapTo(long long v, int bits)
+    {
+        if (bits >= 64)
+            return v;
+        uint64_t mask = (uint64_t(1) << bits) - 1;
+        uint64_t u = static_cast<uint64_t>(v) & mask;
+        if (u >> (bits - 1))
+            u |= ~mask;
+        return static_cast<long long>(u);
+    }
+
+    // m en [0, 2^64) a uint64_t, sin pasar por una conversión fuera de rango
+    uint64_t toUnsigned(double m)
+    {
+        const double half = 9223372036854775808.0; // 2^63
+        return m >= half ? static_cast<uint64_t>(m - half) + (uint64_t(1) << 63) : static_cast<uint64_t>(m);
+    }
+
+    // Parte entera de un double dando la vuelta en 2^64 (convertir directo a long long un
+    // valor fuera de rango es indefinido). NaN e infinitos quedan en 0.
+    long long truncateToInteger(double value)
+    {
+        if (!std::isfinite(value))
+            return 0;
+        double m = std::fmod(std::trunc(value), 18446744073709551616.0); // 2^64
+        uint64_t u = m < 0 ? uint64_t(0) - toUnsigned(-m) : toUnsigned(m);
+        return static_cast<long long>(u);
+    }
+
+    // Valor exacto de una literal entera (value es double y pierde precisión arriba de 2^53)
+    long long integerOf(const Operand &c)
+    {
+        return std::strtoll(c.addr.c_str(), nullptr, 10);
+    }
+
+    // Opera dos enteros; false si la operación desborda 64 bits o divide entre cero
+    bool foldIntegers(const std::string &op, long long x, long long y, long long &result)
+    {
+        if (op == "+")
+            return !__builtin_add_overflow(x, y, &result);
+        if (op == "-")
+            return !__builtin_sub_overflow(x, y, &result);
+        if (op == "*")
+            return !__builtin_mul_overflow(x, y, &result);
+        if ((op == "/" || op == "%") && y != 0 && !(x == LLONG_MIN && y == -1))
+        {
+            result = op == "/" ? x / y : x % y;
+            return true;
+        }
+        return false;
+    }
+}
+
+Operand ValueNumbering::integerConstant(long long value, int typeId) const
+{
+    Operand c;
+    c.typeId = typeId;
+    c.isConstant = true;
+    c.addr = std::to_string(value);
+    c.value = static_cast<double>(value);
+    return c;
+}
+
+Operand ValueNumbering::constant(double value, int typeId) const
+{
+    Operand c;
+    c.typeId = typeId;
+    c.isConstant = true;
+
+    if (types.isFloating(typeId))
+    {
+        std::ostringstream out;
+        out.precision(17);
+        out << value;
+        c.addr = out.str();
+        // Se asegura que la literal se lea como flotante
+        if (c.addr.find_first_of(".en") == std::string::npos)
+            c.addr += ".0";
+        c.value = value;
+    }
+    else
+    {
+        int bits = integerBits(types.getTypeTable().getSize(typeId));
+        return integerConstant(wrapTo(truncateToInteger(value), bits), typeId);
+    }
+    return c;
+}
+
+// Las constantes se numeran por tipo y literal; las direcciones por nombre
+int ValueNumbering::valueNumber(const Operand &operand)
+{
+    std::string key = operand.isConstant
+                          ? "#" + std::to_string(operand.typeId) + ":" + operand.addr
+                          : operand.addr;
+    auto it = numberOf.find(key);
+    if (it != numberOf.end())
+        return it->second;
+    numberOf.emplace(key, nextNumber);
+    return nextNumber++;
+}
+
+// Si la expresión ya tiene un temporal en el bloque lo regresa; si no, emite el cuádruplo
+Operand ValueNumbering::reuseOrEmit(const std::string &key, const std::string &op,
+                                    const Operand &a, const std::string &arg2, int resultType)
+{
+    auto it = available.find(key);
+    if (it != available.end())
+    {
+        ++reused;
+        return it->second;
+    }
+
+    std::string temp = gen.newTemp();
+    gen.emit(op, a.addr, arg2, temp);
+    ++emitted;
+
+    Operand result = Operand::variable(temp, resultType);
+    numberOf[temp] = nextNumber++;
+    available.emplace(key, result);
+    return result;
+}
+
+Operand ValueNumbering::convert(const Operand &a, int toType)
+{
+    if (types.getTypeTable().equivalent(a.typeId, toType))
+        return a;
+    if (!types.isValidConversion(a.typeId, toType, true))
+        throw std::runtime_error("Conversión implícita inválida");
+
+    // Una literal se convierte aquí mismo
+    if (a.isConstant)
+    {
+        ++folded;
+        return constant(a.value, toType);
+    }
+
+    // Las conversiones se recuerdan en el CodeGenerator (la misma memoria que usa
+    // TypeManager::ampliar); aquí solo se numera el temporal nuevo
+    size_t before = gen.getCode().size();
+    Operand result = Operand::variable(types.ampliar(a.addr, a.typeId, toType, gen), toType);
+    if (gen.getCode().size() != before)
+    {
+        ++emitted;
+        numberOf[result.addr] = nextNumber++;
+    }
+    else
+    {
+        ++reused;
+    }
+    return result;
+}
+
+Operand ValueNumbering::binary(const std::string &op, const Operand &a, const Operand &b)
+{
+    int resultType = types.max(a.typeId, b.typeId);
+    Operand x = convert(a, resultType);
+    Operand y = convert(b, resultType);
+
+    // División entre cero, desbordamiento u operador desconocido: se deja en tiempo de ejecución
+    if (x.isConstant && y.isConstant && types.isFloating(resultType))
+    {
+        bool foldable = true;
+        double value = 0;
+
+        if (op == "+")
+            value = x.value + y.value;
+        else if (op == "-")
+            value = x.value - y.value;
+        else if (op == "*")
+            value = x.value * y.value;
+        else if (op == "/" && y.value != 0)
+            value = x.value / y.value;
+        else
+            foldable = false;
+
+        if (foldable)
+        {
+            ++folded;
+            return constant(value, resultType);
+        }
+    }
+    else if (x.isConstant && y.isConstant)
+    {
+        // Enteros: en 64 bits y solo si el resultado cabe en el ancho del tipo
+        long long value;
+        if (foldIntegers(op, integerOf(x), integerOf(y), value) &&
+            fitsIn(value, integerBits(types.getTypeTable().getSize(resultType))))
+        {
+            ++folded;
+            return integerConstant(value, resultType);
+        }
+    }
+
+    int vx = valueNumber(x);
+    int vy = valueNumber(y);
+    if (isCommutative(op) && vy < vx)
+        std::swap(vx, vy);
+
+    std::string key = op + std::to_string(vx) + "," + std::to_string(vy);
+    Operand result = reuseOrEmit(key, op, x, y.addr, resultType);
+    return result;
+}
+
+void ValueNumbering::assign(const std::string &target, const Operand &value)
+{
+    gen.emit("=", value.addr, "", target);
+    ++emitted;
+    numberOf[target] = valueNumber(value);
+}
+
+void ValueNumbering::endBlock()
+{
+    numberOf.clear();
+    available.clear();
+    gen.endBlock();
+}
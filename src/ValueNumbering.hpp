@@ -0,0 +1,81 @@
+#pragma once
+#include "CodeGenerator.hpp"
+#include "TypeManager.hpp"
+#include <string>
+#include <unordered_map>
+
+// Operando de una expresión: una dirección (variable o temporal) o una constante
+struct Operand
+{
+    std::string addr;        // Nombre, temporal o literal ya formateado
+    int typeId;              // Tipo del operando
+    bool isConstant = false; // true si es una literal
+    double value = 0;        // Valor de la literal (si isConstant)
+
+    static Operand variable(const std::string &addr, int typeId)
+    {
+        return {addr, typeId, false, 0};
+    }
+};
+
+/**
+ * Numeración de valores local y plegado de constantes.
+ *
+ * Se coloca entre el análisis semántico y el CodeGenerator: cada operación pasa por aquí
+ * antes de emitirse como cuádruplo, dentro de un bloque básico.
+ * - Las operaciones entre constantes se calculan aquí y no emiten código.
+ * - Una operación que ya se calculó en el bloque con los mismos valores de entrada
+ *   regresa el temporal existente en lugar de emitir otro cuádruplo.
+ * - Las conversiones pasan por TypeManager::ampliar, que las recuerda en el CodeGenerator
+ *   por dirección; endBlock también termina el bloque del generador.
+ * El tipo de resultado de una operación es TypeManager::max de sus operandos, y los
+ * operandos se amplían a ese tipo antes de operar.
+ *
+ * Los temporales que produce no deben liberarse (CodeGenerator::releaseTemp) antes de
+ * endBlock, porque pueden reutilizarse como resultado de una expresión repetida.
+ */
+class ValueNumbering
+{
+private:
+    CodeGenerator &gen;
+    const TypeManager &types;
+
+    std::unordered_map<std::string, int> numberOf;       // Dirección o literal -> número de valor
+    std::unordered_map<std::string, Operand> available;  // Expresión -> operando que ya tiene su valor
+    int nextNumber = 0;
+
+    int emitted = 0;
+    int folded = 0;
+    int reused = 0;
+
+    int valueNumber(const Operand &operand);
+    Operand integerConstant(long long value, int typeId) const;
+    Operand reuseOrEmit(const std::string &key, const std::string &op,
+                        const Operand &a, const std::string &arg2, int resultType);
+
+public:
+    ValueNumbering(CodeGenerator &generator, const TypeManager &manager)
+        : gen(generator), types(manager) {}
+
+    // Crea una constante del tipo dado. En los tipos enteros se trunca hacia cero y se da
+    // la vuelta al ancho del tipo (8 * getSize bits, complemento a 2)
+    Operand constant(double value, int typeId) const;
+
+    // Ampliación implícita de un operando; lanza std::runtime_error si no es válida
+    Operand convert(const Operand &a, int toType);
+
+    // Operación aritmética binaria (+, -, *, /, %). Entre constantes se pliega, salvo la
+    // división entre cero y, en enteros, un resultado que no cabe en el ancho del tipo
+    Operand binary(const std::string &op, const Operand &a, const Operand &b);
+
+    // Emite target = value; desde aquí target tiene el número de valor de value
+    void assign(const std::string &target, const Operand &value);
+
+    // Fin de bloque básico (etiqueta o salto): se olvidan todos los valores conocidos
+    void endBlock();
+
+    // Estadísticas
+    int emittedCount() const { return emitted; }
+    int foldedCount() const { return folded; }
+    int reusedCount() const { return reused; }
+};
@@ -0,0 +1,171 @@
+#include "WorkStealingPool.hpp"
+#include <string>
+
+namespace
+{
+    // Alberca e índice del hilo actual (nullptr si el hilo no pertenece a ninguna)
+    thread_local const WorkStealingPool *currentPool = nullptr;
+    thread_local size_t currentIndex = 0;
+}
+
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::thread::hardware_concurrency();
+        if (threadCount == 0)
+            threadCount = 1;
+    }
+
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < threadCount; ++i)
+    {
+        threads.emplace_back([this, i]
+                             { run(i); });
+    }
+}
+
+// Espera las tareas pendientes y detiene los hilos
+WorkStealingPool::~WorkStealingPool()
+{
+    waitAll();
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+}
+
+void WorkStealingPool::submit(std::function<void()> task)
+{
+    size_t target;
+    if (currentPool == this)
+        target = currentIndex; // Trabajo anidado: se queda en la cola del propio hilo
+    else
+        target = nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+
+    pending.fetch_add(1);
+    {
+        // Se toma waitMutex para no perder la notificación de un hilo que está por dormir
+        std::lock_guard<std::mutex> lock(waitMutex);
+        queued.fetch_add(1);
+    }
+    {
+        std::lock_guard<std::mutex> lock(workers[target]->mutex);
+        workers[target]->tasks.push_back(std::move(task));
+    }
+    workAvailable.notify_one();
+}
+
+void WorkStealingPool::submit(TaskGroup &group, std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(group.mutex);
+        ++group.pending;
+    }
+    submit([&group, task = std::move(task)]
+           {
+               task();
+               // Se avisa con el candado tomado: quien espera no puede destruir el grupo
+               // hasta que este hilo lo suelte
+               std::lock_guard<std::mutex> lock(group.mutex);
+               if (--group.pending == 0)
+                   group.done.notify_all(); });
+}
+
+bool WorkStealingPool::isPoolThread() const
+{
+    return currentPool == this;
+}
+
+// Desde una tarea propia la espera nunca termina: esa tarea sigue pendiente mientras espera
+void WorkStealingPool::rejectWaitFromTask(const char *what) const
+{
+    if (isPoolThread())
+        throw std::logic_error(std::string(what) + " llamado desde una tarea de la misma alberca");
+}
+
+void WorkStealingPool::wait()
+{
+    rejectWaitFromTask("WorkStealingPool::wait()");
+    waitAll();
+}
+
+void WorkStealingPool::wait(TaskGroup &group)
+{
+    rejectWaitFromTask("WorkStealingPool::wait(TaskGroup&)");
+    std::unique_lock<std::mutex> lock(group.mutex);
+    group.done.wait(lock, [&group]
+                    { return group.pending == 0; });
+}
+
+void WorkStealingPool::waitAll()
+{
+    std::unique_lock<std::mutex> lock(waitMutex);
+    allDone.wait(lock, [this]
+                 { return pending.load() == 0; });
+}
+
+// Toma trabajo del final de la cola propia
+bool WorkStealingPool::tryPop(size_t self, std::function<void()> &task)
+{
+    Worker &w = *workers[self];
+    std::lock_guard<std::mutex> lock(w.mutex);
+    if (w.tasks.empty())
+        return false;
+    task = std::move(w.tasks.back());
+    w.tasks.pop_back();
+    return true;
+}
+
+// Roba del frente de la cola de otro hilo
+bool WorkStealingPool::trySteal(size_t self, std::function<void()> &task)
+{
+    for (size_t k = 1; k < workers.size(); ++k)
+    {
+        Worker &victim = *workers[(self + k) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::run(size_t self)
+{
+    currentPool = this;
+    currentIndex = self;
+
+    while (true)
+    {
+        std::function<void()> task;
+        if (tryPop(self, task) || trySteal(self, task))
+        {
+            queued.fetch_sub(1);
+            task();
+            if (pending.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> lock(waitMutex);
+                allDone.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(waitMutex);
+        workAvailable.wait(lock, [this]
+                           { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0)
+            return;
+    }
+}
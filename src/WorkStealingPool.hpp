@@ -0,0 +1,151 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Alberca de hilos con robo de trabajo (work stealing).
+ *
+ * Cada hilo tiene su propia cola doble: toma trabajo del final de la suya (LIFO, mejor
+ * localidad) y, cuando se vacía, roba del frente de las colas de los demás (FIFO).
+ * Las tareas enviadas desde fuera se reparten en round-robin; las enviadas desde un
+ * hilo de la alberca van a la cola de ese mismo hilo.
+ */
+class WorkStealingPool
+{
+private:
+    struct Worker
+    {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex waitMutex;
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+
+    std::atomic<size_t> pending{0};  // Tareas enviadas que aún no terminan
+    std::atomic<size_t> queued{0};   // Tareas en alguna cola (aún no tomadas)
+    std::atomic<size_t> nextWorker{0};
+    bool stopping = false;
+
+    bool tryPop(size_t self, std::function<void()> &task);
+    bool trySteal(size_t self, std::function<void()> &task);
+    void run(size_t self);
+    void waitAll();
+    void rejectWaitFromTask(const char *what) const;
+
+public:
+    /*
+     * Lote de tareas con su propio contador de pendientes: wait(group) espera solo a las
+     * tareas enviadas con submit(group, ...), no al resto de la alberca. Así dos hilos que
+     * comparten la alberca no se bloquean con el trabajo del otro. Debe vivir hasta que
+     * wait(group) regrese.
+     */
+    class TaskGroup
+    {
+    private:
+        friend class WorkStealingPool;
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t pending = 0;
+
+    public:
+        TaskGroup() = default;
+        TaskGroup(const TaskGroup &) = delete;
+        TaskGroup &operator=(const TaskGroup &) = delete;
+    };
+
+    // Si threadCount es 0 se usa std::thread::hardware_concurrency()
+    explicit WorkStealingPool(size_t threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    // Encola una tarea. Las tareas no deben lanzar excepciones.
+    void submit(std::function<void()> task);
+
+    // Encola una tarea que cuenta en `group`
+    void submit(TaskGroup &group, std::function<void()> task);
+
+    // Bloquea hasta que todas las tareas enviadas a la alberca hayan terminado, incluidas
+    // las de otros hilos. Desde una tarea de la misma alberca lanza std::logic_error: esa
+    // tarea cuenta como pendiente y wait nunca regresaría.
+    void wait();
+
+    // Bloquea hasta que terminen las tareas de `group`. Igual que wait(), lanza
+    // std::logic_error si se llama desde una tarea de la misma alberca (las tareas del
+    // grupo siguen corriendo: quien lo envió desde una tarea debe revisar isPoolThread antes).
+    void wait(TaskGroup &group);
+
+    size_t size() const { return threads.size(); }
+
+    // true si el hilo actual es uno de los hilos de esta alberca (está corriendo una tarea)
+    bool isPoolThread() const;
+};
+
+/*
+ * Ejecuta task(i) para cada i en [0, count) en la alberca y regresa los resultados en el
+ * orden de los índices. Cada tarea escribe solo en su propia ranura, de modo que Result
+ * puede ser bool (sin los bits compartidos de std::vector<bool>) o no tener constructor
+ * por omisión. Si alguna tarea lanza, se relanza la excepción del primer índice que falló,
+ * igual que en una ejecución secuencial.
+ *
+ * Espera solo a sus propias tareas (con un TaskGroup), así que varios hilos pueden usar
+ * la misma alberca a la vez. Desde una tarea de la misma alberca lanza std::logic_error.
+ */
+template <typename Task>
+auto collectInOrder(WorkStealingPool &pool, size_t count, Task task)
+    -> std::vector<std::invoke_result_t<Task &, size_t>>
+{
+    using Result = std::invoke_result_t<Task &, size_t>;
+
+    // Se revisa antes de enviar nada: las tareas ya enviadas usarían las ranuras locales
+    if (pool.isPoolThread())
+        throw std::logic_error("collectInOrder llamado desde una tarea de la misma alberca");
+
+    std::unique_ptr<std::optional<Result>[]> slots(new std::optional<Result>[count]);
+    std::unique_ptr<std::exception_ptr[]> errors(new std::exception_ptr[count]);
+
+    WorkStealingPool::TaskGroup group;
+    for (size_t i = 0; i < count; ++i)
+    {
+        pool.submit(group, [&task, &slots, &errors, i]
+                    {
+                        try
+                        {
+                            slots[i].emplace(task(i));
+                        }
+                        catch (...)
+                        {
+                            errors[i] = std::current_exception();
+                        } });
+    }
+    pool.wait(group);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (errors[i])
+            std::rethrow_exception(errors[i]);
+    }
+
+    std::vector<Result> results;
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+        results.push_back(std::move(*slots[i]));
+    return results;
+}
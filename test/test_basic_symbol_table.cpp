@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include "SymbolTable.hpp"
+#include "AuxiliaryTables.hpp"
+#include <set>
+
+// Misma batería para cada combinación de hash y almacenamiento
+template <typename Table>
+class BasicSymbolTableTest : public ::testing::Test
+{
+};
+
+using TableTypes = ::testing::Types<
+    BasicSymbolTable<std::string, SymbolEntry, StdHash, NodeMapStorage>,
+    BasicSymbolTable<std::string, SymbolEntry, FnvHash, FlatMapStorage>,
+    BasicSymbolTable<std::string, SymbolEntry, WyHash, SortedVectorStorage>,
+    BasicSymbolTable<std::string, SymbolEntry, WyHash, PerfectHashStorage>>;
+TYPED_TEST_SUITE(BasicSymbolTableTest, TableTypes);
+
+TYPED_TEST(BasicSymbolTableTest, InsertLookupAndDuplicates)
+{
+    TypeParam table;
+    for (int i = 0; i < 200; ++i)
+        EXPECT_TRUE(table.insert({"v" + std::to_string(i), i % 5, Category::VAR, i * 4, {}}));
+    EXPECT_FALSE(table.insert({"v7", 3, Category::CONST, 0, {}}));
+    EXPECT_EQ(table.size(), 200u);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        std::string id = "v" + std::to_string(i);
+        const SymbolEntry *entry = table.lookup(id);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->address, i * 4);
+        EXPECT_EQ(table.getType(id), i % 5);
+    }
+    EXPECT_EQ(table.getCategory("v7"), Category::VAR); // el duplicado no sobrescribe
+    EXPECT_EQ(table.lookup("nope"), nullptr);
+    EXPECT_THROW(table.getAddress("nope"), SymbolNotFoundError);
+}
+
+TYPED_TEST(BasicSymbolTableTest, BloomForEachAndClear)
+{
+    TypeParam table;
+    table.enableBloomFilter(true);
+    for (int i = 0; i < 100; ++i)
+        table.insert({"x" + std::to_string(i), 0, Category::VAR, i, {}});
+
+    std::set<std::string> seen;
+    table.forEach([&](const SymbolEntry &entry)
+                  { seen.emplace(entry.id); });
+    EXPECT_EQ(seen.size(), 100u);
+
+    std::string id = "x42";
+    EXPECT_NE(table.lookup(id, TypeParam::hashId(id)), nullptr);
+
+    table.clear();
+    EXPECT_EQ(table.size(), 0u);
+    EXPECT_EQ(table.lookup("x42"), nullptr);
+    EXPECT_TRUE(table.insert({"x42", 1, Category::VAR, 0, {}}));
+}
+
+TEST(AuxiliaryTablesTest, LabelsMacrosAndKeywords)
+{
+    LabelTable labels;
+    EXPECT_TRUE(labels.insert({"L0", 0}));
+    EXPECT_TRUE(labels.insert({"L1", 12}));
+    EXPECT_FALSE(labels.insert({"L1", 40}));
+    EXPECT_EQ(labels.lookup("L1")->position, 12);
+
+    MacroTable macros;
+    macros.insert({"MAX", "((a) > (b) ? (a) : (b))", {"a", "b"}});
+    ASSERT_NE(macros.lookup("MAX"), nullptr);
+    EXPECT_EQ(macros.lookup("MAX")->params.size(), 2u);
+
+    KeywordTable keywords;
+    const char *words[] = {"if", "else", "while", "do", "for", "return", "struct", "int", "float", "char"};
+    for (int i = 0; i < 10; ++i)
+        EXPECT_TRUE(keywords.insert({words[i], i}));
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(keywords.lookup(words[i])->token, i);
+    EXPECT_EQ(keywords.lookup("switch"), nullptr);
+}
+
+TEST(HashPoliciesTest, DeterministicAndSeeded)
+{
+    EXPECT_EQ(WyHash::hash("contador", 0), WyHash::hash("contador", 0));
+    EXPECT_NE(WyHash::hash("contador", 0), WyHash::hash("contador", 1));
+    EXPECT_NE(FnvHash::hash("a", 0), FnvHash::hash("b", 0));
+    EXPECT_NE(WyHash::hash("", 0), WyHash::hash(std::string_view("\0", 1), 0));
+}
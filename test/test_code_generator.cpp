@@ -32,3 +32,156 @@ TEST(CodeGeneratorTest, ResetReinitializesCounters) {
     EXPECT_EQ(gen.newTemp(), "t0");
     EXPECT_EQ(gen.newLabel(), "L0");
 }
+
+// Sin reutilización (por defecto), liberar no cambia la secuencia de nombres
+TEST(CodeGeneratorTest, NeverReuseKeepsSequence) {
+    CodeGenerator gen;
+
+    std::string t0 = gen.newTemp();
+    gen.releaseTemp(t0);
+    EXPECT_EQ(gen.newTemp(), "t1");
+    EXPECT_EQ(gen.liveTemps(), 1);
+}
+
+// En RECYCLE el último temporal liberado es el primero en reutilizarse
+TEST(CodeGeneratorTest, RecycleReusesMostRecentlyFreed) {
+    CodeGenerator gen;
+    gen.setTempReuse(TempReuse::RECYCLE);
+
+    std::string t0 = gen.newTemp();
+    std::string t1 = gen.newTemp();
+    gen.newTemp();
+
+    gen.releaseTemp(t0);
+    gen.releaseTemp(t1);
+
+    EXPECT_EQ(gen.newTemp(), "t1");
+    EXPECT_EQ(gen.newTemp(), "t0");
+    EXPECT_EQ(gen.newTemp(), "t3");
+    EXPECT_EQ(gen.tempsCreated(), 4);
+}
+
+// Las marcas de expresión liberan todo menos el resultado
+TEST(CodeGeneratorTest, ExpressionMarksReleaseIntermediates) {
+    CodeGenerator gen;
+    gen.setTempReuse(TempReuse::CHECKED);
+
+    // a = (b + c) * (d + e), dentro de una sentencia que abre la marca exterior
+    size_t outer = gen.markTemps();
+    size_t mark = gen.markTemps();
+    std::string left = gen.newTemp();
+    std::string right = gen.newTemp();
+    std::string product = gen.newTemp();
+    gen.releaseTemps(mark, product);
+
+    EXPECT_EQ(gen.liveTemps(), 1);
+    EXPECT_EQ(gen.newTemp(), right); // el último liberado primero
+    EXPECT_EQ(gen.newTemp(), left);
+
+    // El resultado sigue vivo y se libera con la expresión exterior
+    gen.releaseTemps(outer);
+    EXPECT_EQ(gen.liveTemps(), 0);
+}
+
+// Sin marcas abiertas no se registra nada, y solo los nombres entregados cuentan como temporales
+TEST(CodeGeneratorTest, UnmarkedTempsAndUserNames) {
+    CodeGenerator gen;
+    gen.setTempReuse(TempReuse::CHECKED);
+
+    for (int i = 0; i < 1000; ++i) {
+        gen.releaseTemp(gen.newTemp());
+    }
+    EXPECT_EQ(gen.markTemps(), 0u); // El registro no creció
+    gen.releaseTemps(0);
+
+    std::string t0 = gen.newTemp();
+    EXPECT_NO_THROW(gen.releaseTemp("t00"));
+    EXPECT_NO_THROW(gen.releaseTemp("t1"));
+    EXPECT_NO_THROW(gen.releaseTemp("t99999999999999999999"));
+    EXPECT_EQ(gen.liveTemps(), 1);
+    gen.releaseTemp(t0);
+    EXPECT_EQ(gen.liveTemps(), 0);
+}
+
+// En CHECKED liberar un temporal muerto es un error
+TEST(CodeGeneratorTest, CheckedModeRejectsDeadRelease) {
+    CodeGenerator gen;
+    gen.setTempReuse(TempReuse::CHECKED);
+
+    std::string t0 = gen.newTemp();
+    gen.releaseTemp(t0);
+
+    EXPECT_THROW(gen.releaseTemp(t0), std::logic_error);
+}
+
+// En CHECKED los nombres de variables del usuario se ignoran al liberar
+TEST(CodeGeneratorTest, CheckedModeIgnoresUserVariables) {
+    CodeGenerator gen;
+    gen.setTempReuse(TempReuse::CHECKED);
+
+    std::string t0 = gen.newTemp();
+    EXPECT_NO_THROW(gen.releaseTemp("x"));
+    EXPECT_NO_THROW(gen.releaseTemp("t7"));
+    EXPECT_NO_THROW(gen.releaseTemp("t07"));
+    EXPECT_EQ(gen.liveTemps(), 1);
+    EXPECT_EQ(gen.newTemp(), "t1"); // Nada se liberó
+    gen.releaseTemp(t0);
+    EXPECT_EQ(gen.liveTemps(), 1);
+}
+
+// Se reporta el máximo de temporales vivos por función
+TEST(CodeGeneratorTest, ReportsPeakLivePerFunction) {
+    CodeGenerator gen;
+    gen.setTempReuse(TempReuse::RECYCLE);
+
+    gen.beginFunction("f");
+    for (int i = 0; i < 100; ++i) {
+        std::string a = gen.newTemp();
+        std::string b = gen.newTemp();
+        gen.releaseTemp(a);
+        gen.releaseTemp(b);
+    }
+    EXPECT_EQ(gen.endFunction(), 2);
+    EXPECT_EQ(gen.tempsCreated(), 2);
+
+    gen.beginFunction("g");
+    size_t mark = gen.markTemps();
+    for (int i = 0; i < 5; ++i) {
+        gen.newTemp();
+    }
+    gen.releaseTemps(mark);
+    gen.endFunction();
+
+    EXPECT_EQ(gen.peakLiveTempsOf("f"), 2);
+    EXPECT_EQ(gen.peakLiveTempsOf("g"), 5);
+    EXPECT_EQ(gen.peakLiveTempsOf("h"), -1);
+}
+
+// Invalidar una conversión quita sus dos entradas (origen y temporal): una escritura
+// posterior en la dirección vieja no borra conversiones más nuevas
+TEST(CodeGeneratorTest, ConversionMemoForgetsBothKeys) {
+    CodeGenerator gen;
+
+    gen.recordConversion("i", 0, 1, "t0");
+    gen.emit("=", "5", "", "t0"); // se escribe en el temporal
+    EXPECT_EQ(gen.rememberedConversions(), 0u);
+    EXPECT_EQ(gen.findConversion("i", 0, 1), nullptr);
+
+    gen.recordConversion("i", 0, 1, "t1");
+    gen.emit("=", "7", "", "t0"); // ya no tiene ninguna conversión
+    ASSERT_NE(gen.findConversion("i", 0, 1), nullptr);
+    EXPECT_EQ(*gen.findConversion("i", 0, 1), "t1");
+
+    // Registrar de nuevo la misma conversión reemplaza el par anterior
+    gen.recordConversion("i", 0, 1, "t2");
+    gen.emit("=", "8", "", "t1");
+    EXPECT_EQ(*gen.findConversion("i", 0, 1), "t2");
+
+    // Muchas escrituras en un bloque no dejan entradas colgadas
+    for (int k = 0; k < 100; ++k) {
+        std::string temp = "t" + std::to_string(10 + k);
+        gen.recordConversion("x", 0, 1, temp);
+        gen.emit("+", "x", "1", "x");
+    }
+    EXPECT_EQ(gen.rememberedConversions(), 1u);
+}
@@ -0,0 +1,146 @@
+#include "../src/CompileSession.hpp"
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::shared_ptr<const Prelude> makePrelude()
+    {
+        TypeTable types;
+        types.addBasicType("int", 4);
+        types.addBasicType("float", 4);
+        types.addBasicType("double", 8);
+
+        SymbolTable symbols;
+        symbols.insert({"printf", 0, Category::FUNCTION, 0, {}});
+        symbols.insert({"PI", 2, Category::VAR, 8, {}});
+        return std::make_shared<const Prelude>(std::move(types), std::move(symbols));
+    }
+}
+
+// La unidad ve los tipos y los símbolos del preludio con los mismos IDs
+TEST(CompileSessionTest, UnitSeesPrelude)
+{
+    CompileSession session(makePrelude());
+    auto unit = session.openUnit("a.c");
+
+    EXPECT_EQ(unit->name(), "a.c");
+    EXPECT_EQ(unit->types().count(), 3);
+    EXPECT_EQ(unit->types().getName(1), "float");
+    ASSERT_NE(unit->symbols().find("printf"), nullptr);
+    EXPECT_EQ(unit->symbols().find("PI")->address, 8);
+    EXPECT_EQ(unit->typeManager().max(0, 2), 2);
+}
+
+// Lo que agrega una unidad no se ve en el preludio ni en otras unidades
+TEST(CompileSessionTest, UnitsAreIsolated)
+{
+    CompileSession session(makePrelude());
+    auto a = session.openUnit("a.c");
+    auto b = session.openUnit("b.c");
+
+    int arr = a->types().addArrayType(0, 10);
+    EXPECT_EQ(arr, 3); // IDs nuevos después de los del preludio
+    EXPECT_TRUE(a->symbols().insertTop({"x", arr, Category::VAR, 0, {}}));
+
+    EXPECT_EQ(b->types().count(), 3);
+    EXPECT_EQ(session.getPrelude().types().count(), 3);
+    EXPECT_EQ(b->symbols().find("x"), nullptr);
+    EXPECT_EQ(session.getPrelude().symbols()->lookup("x"), nullptr);
+
+    // La otra unidad asigna el mismo ID a su propio tipo
+    EXPECT_EQ(b->types().addArrayType(1, 4), 3);
+    EXPECT_EQ(a->types().getBaseType(3), 0);
+    EXPECT_EQ(b->types().getBaseType(3), 1);
+}
+
+// El global de la unidad puede ocultar un símbolo del preludio
+TEST(CompileSessionTest, UnitShadowsPreludeSymbol)
+{
+    CompileSession session(makePrelude());
+    auto unit = session.openUnit("a.c");
+
+    EXPECT_TRUE(unit->symbols().insertTop({"PI", 0, Category::VAR, 100, {}}));
+    EXPECT_EQ(unit->symbols().find("PI")->address, 100);
+    EXPECT_EQ(session.getPrelude().symbols()->lookup("PI")->address, 8);
+}
+
+// En paralelo se obtiene lo mismo que en secuencia y el error de la primera unidad
+TEST(CompileSessionTest, ParallelMatchesSequential)
+{
+    CompileSession session(makePrelude());
+    std::vector<std::string> names;
+    for (int i = 0; i < 16; ++i)
+        names.push_back("u" + std::to_string(i) + ".c");
+
+    auto compile = [](TranslationUnit &unit)
+    {
+        int t = unit.types().addArrayType(0, static_cast<int>(unit.name().size()));
+        unit.symbols().insertTop({"v", t, Category::VAR, 0, {}});
+        return unit.name() + ":" + std::to_string(unit.symbols().find("v")->typeId) + ":" +
+               std::to_string(unit.types().getNumElements(t));
+    };
+
+    WorkStealingPool pool(4);
+    auto sequential = session.compileAll(names, compile);
+    auto parallel = session.compileParallel(names, pool, compile);
+    EXPECT_EQ(sequential, parallel);
+    EXPECT_EQ(sequential[0], "u0.c:3:4");
+
+    auto failing = [](TranslationUnit &unit) -> int
+    {
+        if (unit.name() == "u3.c" || unit.name() == "u9.c")
+            throw std::runtime_error(unit.name());
+        return 0;
+    };
+    try
+    {
+        session.compileParallel(names, pool, failing);
+        FAIL() << "se esperaba una excepción";
+    }
+    catch (const std::runtime_error &e)
+    {
+        EXPECT_STREQ(e.what(), "u3.c");
+    }
+
+    // Resultados bool: cada unidad escribe su propia ranura, sin los bits compartidos
+    // de std::vector<bool>
+    for (int i = 16; i < 400; ++i)
+        names.push_back("u" + std::to_string(i) + ".c");
+    auto hasPi = [](TranslationUnit &unit)
+    {
+        return unit.symbols().find("PI") != nullptr && unit.name().size() % 2 == 0;
+    };
+    EXPECT_EQ(session.compileParallel(names, pool, hasPi), session.compileAll(names, hasPi));
+}
+
+// compileAll, compileParallel y compileCached abren cada unidad sobre el recurso que reciben
+TEST(CompileSessionTest, SessionPassesResourceToUnits)
+{
+    CompileSession session(makePrelude());
+    std::vector<std::string> names = {"a.c", "b.c", "c.c"};
+    std::pmr::synchronized_pool_resource arena;
+    auto compile = [&arena](TranslationUnit &unit)
+    {
+        int t = unit.types().addArrayType(0, 2);
+        unit.symbols().insertTop({"v", t, Category::VAR, 0, {}});
+        bool own = unit.symbols().memoryResource() == &arena;
+        return std::string(own ? "arena" : "heap") + ":" + std::to_string(t);
+    };
+
+    std::vector<std::string> expected(names.size(), "arena:3");
+    EXPECT_EQ(session.compileAll(names, compile, &arena), expected);
+
+    WorkStealingPool pool(2);
+    EXPECT_EQ(session.compileParallel(names, pool, compile, &arena), expected);
+
+    AnalysisCache cache;
+    auto inputsOf = [](const std::string &name)
+    { return FingerprintBuilder().add(name).result(); };
+    EXPECT_EQ(session.compileCached(names, cache, inputsOf, compile, &arena), expected);
+
+    EXPECT_EQ(session.compileAll(names, compile)[0], "heap:3");
+}
@@ -0,0 +1,169 @@
+#include "../src/ConcurrentSymbolTable.hpp"
+#include "../src/SymbolTableStack.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Misma semántica que SymbolTable::insert en un solo hilo
+TEST(ConcurrentSymbolTableTest, InsertAndLookup)
+{
+    ConcurrentSymbolTable table(8);
+
+    EXPECT_TRUE(table.insert({"x", 3, Category::VAR, 0, {}}));
+    EXPECT_FALSE(table.insert({"x", 4, Category::CONST, 4, {}}));
+    EXPECT_TRUE(table.insert({"f", 3, Category::FUNCTION, 8, {3, 3}}));
+
+    const SymbolEntry *x = table.lookup("x");
+    ASSERT_NE(x, nullptr);
+    EXPECT_EQ(x->typeId, 3);
+    EXPECT_EQ(table.lookup("f")->params.size(), 2u);
+    EXPECT_EQ(table.lookup("y"), nullptr);
+    EXPECT_EQ(table.size(), 2u);
+}
+
+// Cuando varios hilos insertan el mismo id, exactamente uno gana
+TEST(ConcurrentSymbolTableTest, RacingDuplicatesOnlyOneWins)
+{
+    ConcurrentSymbolTable table(16); // pocas cubetas para forzar colisiones
+    const int threads = 8;
+    const int ids = 2000;
+    std::atomic<int> wins{0};
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&, t]
+                          {
+                              for (int i = 0; i < ids; ++i)
+                              {
+                                  if (table.insert({"s" + std::to_string(i), t, Category::VAR, i, {}}))
+                                      wins++;
+                              } });
+    }
+    for (auto &th : pool)
+        th.join();
+
+    EXPECT_EQ(wins.load(), ids);
+    EXPECT_EQ(table.size(), static_cast<size_t>(ids));
+    for (int i = 0; i < ids; ++i)
+    {
+        const SymbolEntry *e = table.lookup("s" + std::to_string(i));
+        ASSERT_NE(e, nullptr);
+        EXPECT_EQ(e->address, i);
+    }
+}
+
+// La tabla duplica sus cubetas con la carga, sin perder entradas, aun entre hilos
+TEST(ConcurrentSymbolTableTest, GrowsWithLoad)
+{
+    ConcurrentSymbolTable table(2);
+    const int threads = 4;
+    const int perThread = 5000;
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&, t]
+                          {
+                              for (int i = 0; i < perThread; ++i)
+                              {
+                                  int n = t * perThread + i;
+                                  EXPECT_TRUE(table.insert({"g" + std::to_string(n), 3, Category::VAR, n, {}}));
+                              } });
+    }
+    for (auto &th : pool)
+        th.join();
+
+    EXPECT_EQ(table.size(), static_cast<size_t>(threads * perThread));
+    EXPECT_GE(table.bucketCount() * 2, table.size()); // A lo más dos entradas por cubeta
+    for (int n = 0; n < threads * perThread; ++n)
+    {
+        const SymbolEntry *e = table.lookup("g" + std::to_string(n));
+        ASSERT_NE(e, nullptr);
+        EXPECT_EQ(e->address, n);
+    }
+
+    size_t seen = 0;
+    table.forEach([&](const SymbolEntry &)
+                  { ++seen; });
+    EXPECT_EQ(seen, table.size());
+    EXPECT_GT(table.memoryUsage().entries, 0u);
+}
+
+// La política de hash es un parámetro, como en BasicSymbolTable
+TEST(ConcurrentSymbolTableTest, UsesHashPolicy)
+{
+    BasicConcurrentSymbolTable<FnvHash> table(4);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_TRUE(table.insert({"f" + std::to_string(i), 3, Category::FUNCTION, i, {}}));
+    EXPECT_FALSE(table.insert({"f7", 4, Category::VAR, 0, {}}));
+    EXPECT_EQ(table.lookup("f7")->address, 7);
+    EXPECT_EQ(BasicConcurrentSymbolTable<FnvHash>::hashId("x"), FnvHash::hash("x", 0));
+    EXPECT_EQ(ConcurrentSymbolTable::hashId("x"), SymbolTable::hashId("x"));
+}
+
+// Varias pilas, una por hilo, registran sus globales con insertBase en la misma base
+// concurrente; cada una ve lo que insertaron las demás
+TEST(ConcurrentSymbolTableTest, SharedBaseBehindInsertBase)
+{
+    auto global = std::make_shared<ConcurrentSymbolTable>();
+    const int threads = 4;
+    const int perThread = 1000;
+    std::atomic<int> wins{0};
+
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+    {
+        pool.emplace_back([&, t]
+                          {
+                              SymbolTableStack stack(global);
+                              stack.setHotCache(64);
+                              EXPECT_EQ(stack.levels(), 1u);
+                              for (int i = 0; i < perThread; ++i)
+                              {
+                                  // Todos declaran "comun"; solo uno gana
+                                  if (stack.insertBase({"comun", t, Category::VAR, 0, {}}))
+                                      wins++;
+                                  stack.insertBase({"t" + std::to_string(t) + "_" + std::to_string(i), t, Category::VAR, i, {}});
+                              }
+                              stack.pushScope();
+                              EXPECT_TRUE(stack.insertTop({"local", t, Category::VAR, 0, {}}));
+                              EXPECT_FALSE(stack.insertBase({"comun", t, Category::VAR, 0, {}}));
+                              ASSERT_NE(stack.find("comun"), nullptr);
+                              EXPECT_EQ(stack.findBase("local"), nullptr);
+                              stack.popScope();
+                              EXPECT_EQ(stack.levels(), 1u); });
+    }
+    for (auto &th : pool)
+        th.join();
+
+    EXPECT_EQ(wins.load(), 1);
+    EXPECT_EQ(global->size(), static_cast<size_t>(threads * perThread + 1));
+
+    SymbolTableStack reader(global);
+    ASSERT_NE(reader.find("t3_999"), nullptr);
+    EXPECT_EQ(reader.findTop("t0_5")->address, 5);
+    EXPECT_EQ(reader.globalScope(), nullptr);
+    EXPECT_EQ(reader.concurrentGlobal(), global.get());
+
+    // Al congelar, la pila deja la base concurrente y sigue viendo lo mismo
+    auto frozen = reader.freezeBase();
+    EXPECT_EQ(frozen->size(), global->size());
+    EXPECT_EQ(reader.concurrentGlobal(), nullptr);
+    EXPECT_FALSE(reader.insertBase({"tarde", 3, Category::VAR, 0, {}}));
+    ASSERT_NE(reader.find("t1_10"), nullptr);
+    EXPECT_EQ(reader.levels(), 1u);
+}
+
+// El resultado congelado puede servir como base de una pila local
+TEST(ConcurrentSymbolTableTest, FreezeFeedsLayeredStack)
+{
+    ConcurrentSymbolTable table;
+    table.insert({"g", 3, Category::VAR, 0, {}});
+
+    SymbolTableStack stack(table.freeze());
+    ASSERT_NE(stack.findBase("g"), nullptr);
+    EXPECT_FALSE(stack.insertBase({"h", 3, Category::VAR, 0, {}}));
+}
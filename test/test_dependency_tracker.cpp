@@ -0,0 +1,143 @@
+#include "../src/DependencyTracker.hpp"
+#include "../src/SymbolTableStack.hpp"
+#include "../src/TypeTable.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+// Solo se invalidan las regiones que leyeron lo editado
+TEST(DependencyTrackerTest, InvalidatesOnlyReaders)
+{
+    DependencyTracker deps;
+    deps.beginRegion("f");
+    deps.recordSymbol("a");
+    deps.recordType(3);
+    deps.endRegion();
+    deps.beginRegion("g");
+    deps.recordSymbol("b");
+    deps.endRegion();
+
+    EXPECT_TRUE(deps.dirtyRegions().empty());
+    EXPECT_EQ(deps.invalidateSymbol("b"), 1u);
+    EXPECT_EQ(deps.invalidateSymbol("b"), 0u); // ya estaba sucia
+    EXPECT_EQ(deps.dirtyRegions(), std::vector<std::string>{"g"});
+    EXPECT_EQ(deps.invalidate({"z"}, {3}), 1u);
+    EXPECT_TRUE(deps.isDirty("f"));
+
+    // Al recomprobar se olvidan las dependencias viejas y se anotan las nuevas
+    size_t checked = deps.recheck([&](const std::string &name)
+                                  { deps.recordSymbol(name == "f" ? "c" : "b"); });
+    EXPECT_EQ(checked, 2u);
+    EXPECT_TRUE(deps.dirtyRegions().empty());
+    EXPECT_EQ(deps.invalidateSymbol("a"), 0u);
+    EXPECT_EQ(deps.invalidateType(3), 0u);
+    EXPECT_EQ(deps.symbolsReadBy("f"), std::vector<std::string>{"c"});
+
+    // Sin región abierta no se anota nada
+    deps.recordSymbol("suelto");
+    EXPECT_EQ(deps.invalidateSymbol("suelto"), 0u);
+}
+
+// Los ids llegan como vistas (p. ej. un trozo del fuente) y se copian una sola vez
+TEST(DependencyTrackerTest, RecordsStringViews)
+{
+    DependencyTracker deps;
+    std::string source = "alfa beta";
+    deps.beginRegion("f");
+    deps.recordSymbol(std::string_view(source).substr(0, 4));
+    deps.recordSymbol(std::string_view(source).substr(0, 4));
+    deps.endRegion();
+    deps.beginRegion("g");
+    deps.recordSymbol(std::string_view(source).substr(5));
+    deps.recordSymbol("alfa");
+    deps.endRegion();
+    source.assign("xxxx xxxx"); // Lo anotado no depende del búfer original
+
+    EXPECT_EQ(deps.symbolsReadBy("f"), std::vector<std::string>{"alfa"});
+    EXPECT_EQ(deps.invalidateSymbol("alfa"), 2u);
+    EXPECT_FALSE(deps.isDirty("h"));
+    EXPECT_EQ(deps.invalidateSymbol("beta"), 0u); // g ya estaba sucia
+    EXPECT_EQ(deps.invalidateSymbol("alf"), 0u);
+}
+
+// La pila y la tabla de tipos anotan lo que se lee del ámbito global
+TEST(DependencyTrackerTest, StackAndTypeTableRecordGlobalReads)
+{
+    TypeTable tt;
+    int tInt = tt.addBasicType("int", 4);
+    int tFloat = tt.addBasicType("float", 4);
+
+    DependencyTracker deps;
+    tt.attachDependencyTracker(&deps);
+    SymbolTableStack stack;
+    stack.attachDependencyTracker(&deps);
+    stack.pushScope();
+    stack.insertBase({"x", tInt, Category::VAR, 0, {}});
+    stack.insertBase({"y", tFloat, Category::VAR, 4, {}});
+
+    deps.beginRegion("f");
+    {
+        ScopeGuard scope(stack);
+        tt.getSize(stack.lookup("x")->typeId);
+        EXPECT_EQ(stack.lookup("w"), nullptr); // no existe aún, pero se anota
+    }
+    deps.endRegion();
+
+    deps.beginRegion("g");
+    {
+        ScopeGuard scope(stack);
+        stack.insertTop({"x", tFloat, Category::VAR, 0, {}}); // oculta al global
+        stack.lookup("x");
+        tt.get(stack.lookupBase("y")->typeId);
+    }
+    deps.endRegion();
+
+    auto fSymbols = deps.symbolsReadBy("f");
+    std::sort(fSymbols.begin(), fSymbols.end());
+    EXPECT_EQ(fSymbols, (std::vector<std::string>{"w", "x"}));
+    EXPECT_EQ(deps.symbolsReadBy("g"), std::vector<std::string>{"y"});
+    EXPECT_EQ(deps.typesReadBy("f"), std::vector<int>{tInt});
+    EXPECT_EQ(deps.typesReadBy("g"), std::vector<int>{tFloat});
+
+    // Editar x solo ensucia f; declarar w también
+    EXPECT_EQ(deps.invalidate({"x"}, {}), 1u);
+    EXPECT_EQ(deps.dirtyRegions(), std::vector<std::string>{"f"});
+    EXPECT_EQ(deps.invalidate({}, {tFloat}), 1u);
+    EXPECT_EQ(deps.dirtyRegions(), (std::vector<std::string>{"f", "g"}));
+}
+
+// Solo se anotan IDs válidos, y lookupTop sobre el global también cuenta como lectura
+TEST(DependencyTrackerTest, RecordsOnlyValidTypesAndGlobalTopReads)
+{
+    TypeTable tt;
+    int tInt = tt.addBasicType("int", 4);
+
+    DependencyTracker deps;
+    tt.attachDependencyTracker(&deps);
+    SymbolTableStack stack;
+    stack.attachDependencyTracker(&deps);
+    stack.pushScope();
+    stack.insertBase({"g", tInt, Category::VAR, 0, {}});
+
+    deps.beginRegion("f");
+    EXPECT_FALSE(tt.equivalent(tInt, 1000000));
+    EXPECT_FALSE(tt.equivalent(-3, tInt));
+    EXPECT_NE(stack.lookupTop("g"), nullptr);
+    {
+        ScopeGuard scope(stack);
+        stack.lookupTop("local"); // el tope ya no es el global
+    }
+    deps.endRegion();
+
+    EXPECT_EQ(deps.typesReadBy("f"), std::vector<int>{tInt});
+    EXPECT_EQ(deps.symbolsReadBy("f"), std::vector<std::string>{"g"});
+
+    // Con el global congelado como único nivel pasa lo mismo
+    SymbolTableStack layered(stack.freezeBase());
+    layered.attachDependencyTracker(&deps);
+    deps.beginRegion("h");
+    EXPECT_NE(layered.findTop("g"), nullptr);
+    deps.endRegion();
+    EXPECT_EQ(deps.symbolsReadBy("h"), std::vector<std::string>{"g"});
+}
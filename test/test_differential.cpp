@@ -0,0 +1,57 @@
+#include "../fuzz/SymbolTableDifferential.hpp"
+#include <gtest/gtest.h>
+#include <random>
+
+// Secuencias aleatorias (semilla fija): todos los backends coinciden con la referencia.
+// `make fuzz` corre muchas más con sanitizers.
+TEST(DifferentialTest, BackendsMatchReference)
+{
+    std::mt19937_64 random(2024);
+    for (int i = 0; i < 60; ++i)
+    {
+        std::vector<uint8_t> bytes(3 * (random() % 300));
+        for (uint8_t &byte : bytes)
+            byte = static_cast<uint8_t>(random());
+        differential::Report report = differential::run(differential::decode(bytes.data(), bytes.size()));
+        ASSERT_TRUE(report.mismatch.empty()) << report.mismatch;
+    }
+}
+
+// Las reglas de la referencia, en una secuencia escrita a mano
+TEST(DifferentialTest, ReferenceSemantics)
+{
+    using differential::Op;
+    std::vector<differential::Step> steps = {
+        {Op::INSERT_TOP, 0, 1},  // Pila vacía: falla
+        {Op::INSERT_BASE, 0, 1}, // Pila vacía: falla
+        {Op::PUSH, 0, 0},
+        {Op::INSERT_BASE, 0, 1},
+        {Op::INSERT_TOP, 0, 2},  // Repetido: falla y conserva la entrada
+        {Op::LOOKUP_TOP, 0, 0},
+        {Op::FREEZE_BASE, 0, 0},
+        {Op::POP, 0, 0},         // No saca el global congelado
+        {Op::INSERT_TOP, 1, 0},  // Sin ámbitos locales: falla
+        {Op::LOOKUP_TOP, 0, 0},  // Ve el global congelado
+        {Op::PUSH, 0, 0},
+        {Op::INSERT_TOP, 0, 3},  // Oculta al global
+        {Op::LOOKUP, 0, 0},
+        {Op::LOOKUP_BASE, 0, 0},
+    };
+
+    differential::ReferenceStack reference;
+    std::vector<bool> ok;
+    std::vector<int> types;
+    for (const auto &step : steps)
+    {
+        differential::Outcome outcome = reference.apply(step);
+        ok.push_back(outcome.ok);
+        types.push_back(outcome.ok ? outcome.entry.typeId : -1);
+    }
+    EXPECT_EQ(ok, (std::vector<bool>{false, false, false, true, false, true, false, false, false, true, false, true, true, true}));
+    EXPECT_EQ(types[5], 1);
+    EXPECT_EQ(types[12], 3);
+    EXPECT_EQ(types[13], 1);
+
+    differential::Report report = differential::run(steps);
+    EXPECT_TRUE(report.mismatch.empty()) << report.mismatch;
+}
@@ -0,0 +1,181 @@
+#include "../src/AnalysisCache.hpp"
+#include "../src/AuxiliaryTables.hpp"
+#include "../src/CompileSession.hpp"
+#include "../src/SymbolTable.hpp"
+#include "../src/TypeTable.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+// La huella de una tabla no depende del orden de inserción ni del almacenamiento
+TEST(FingerprintTest, SymbolTableIsOrderIndependent)
+{
+    SymbolTable a, b;
+    EXPECT_EQ(a.fingerprint(), b.fingerprint());
+
+    a.insert({"x", 1, Category::VAR, 0, {}});
+    a.insert({"f", 2, Category::FUNCTION, 0, {1, 1}});
+    b.insert({"f", 2, Category::FUNCTION, 0, {1, 1}});
+    EXPECT_NE(a.fingerprint(), b.fingerprint());
+    b.insert({"x", 1, Category::VAR, 0, {}});
+    EXPECT_EQ(a.fingerprint(), b.fingerprint());
+    EXPECT_EQ(a.freeze().fingerprint(), a.fingerprint());
+
+    // Una inserción repetida no cambia nada; cualquier campo distinto sí
+    a.insert({"x", 7, Category::VAR, 0, {}});
+    EXPECT_EQ(a.fingerprint(), b.fingerprint());
+
+    SymbolTable c;
+    c.insert({"x", 1, Category::VAR, 4, {}});
+    c.insert({"f", 2, Category::FUNCTION, 0, {1, 1}});
+    EXPECT_NE(c.fingerprint(), a.fingerprint());
+
+    a.clear();
+    EXPECT_EQ(a.fingerprint(), SymbolTable().fingerprint());
+
+    LabelTable l1, l2;
+    l1.insert({"L1", 3});
+    l2.insert({"L1", 4});
+    EXPECT_NE(l1.fingerprint(), l2.fingerprint());
+}
+
+// Las huellas de tipos son estructurales y recursivas, e iguales entre tablas
+TEST(FingerprintTest, TypeFingerprintsAreStructural)
+{
+    TypeTable t1, t2;
+    int i1 = t1.addBasicType("int", 4);
+    int f2 = t2.addBasicType("float", 4);
+    int i2 = t2.addBasicType("int", 4);
+    EXPECT_EQ(t1.fingerprint(i1), t2.fingerprint(i2));
+    EXPECT_NE(t2.fingerprint(f2), t2.fingerprint(i2));
+
+    // Mismo arreglo con otro ID: misma huella; otro tipo base: distinta
+    EXPECT_EQ(t1.fingerprint(t1.addArrayType(i1, 3)), t2.fingerprint(t2.addArrayType(i2, 3)));
+    EXPECT_NE(t2.fingerprint(t2.addArrayType(f2, 3)), t1.fingerprint(t1.addArrayType(i1, 3)));
+
+    // Estructura con campos en otro orden de inserción
+    SymbolTable fa, fb;
+    fa.insert({"a", i1, Category::VAR, 0, {}});
+    fa.insert({"b", i1, Category::VAR, 4, {}});
+    fb.insert({"b", i2, Category::VAR, 4, {}});
+    fb.insert({"a", i2, Category::VAR, 0, {}});
+    int s1 = t1.addStructType("P", 8, &fa);
+    int s2 = t2.addStructType("P", 8, &fb);
+    EXPECT_EQ(t1.fingerprint(s1), t2.fingerprint(s2));
+
+    // La perezosa da la misma huella que la construida
+    LazyStructDescriptor lazy;
+    lazy.source = std::make_shared<const std::string>("ab");
+    lazy.fields = {{0, 1, i1}, {1, 1, i1}};
+    EXPECT_EQ(t1.fingerprint(t1.addLazyStructType("P", 8, lazy)), t1.fingerprint(s1));
+
+    // La huella de la tabla depende de los IDs; overlay la conserva
+    TypeTable t3;
+    t3.addBasicType("int", 4);
+    t3.addBasicType("float", 4);
+    TypeTable t4;
+    t4.addBasicType("float", 4);
+    t4.addBasicType("int", 4);
+    EXPECT_NE(t3.fingerprint(), t4.fingerprint());
+    Fingerprint print3 = t3.fingerprint();
+    auto shared3 = std::make_shared<const TypeTable>(std::move(t3));
+    TypeTable layer = TypeTable::overlay(shared3);
+    EXPECT_EQ(layer.fingerprint(), print3);
+
+    // Una capa que agrega tipos da la misma huella que la tabla completa
+    layer.addArrayType(0, 3);
+    t4 = TypeTable();
+    t4.addBasicType("int", 4);
+    t4.addBasicType("float", 4);
+    t4.addArrayType(0, 3);
+    EXPECT_EQ(layer.fingerprint(), t4.fingerprint());
+}
+
+// La caché sobrevive a un viaje por disco y rechaza archivos dañados
+TEST(FingerprintTest, AnalysisCacheRoundTrip)
+{
+    std::string path = ::testing::TempDir() + "analysis_cache_test.bin";
+    AnalysisCache cache;
+    Fingerprint k1 = FingerprintBuilder().add("a.c").result();
+    Fingerprint k2 = FingerprintBuilder().add("b.c").result();
+    cache.store(k1, "ok");
+    cache.store(k2, std::string("bin\0ario\n", 9));
+    cache.save(path);
+
+    AnalysisCache loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.size(), 2u);
+    ASSERT_NE(loaded.find(k2), nullptr);
+    EXPECT_EQ(*loaded.find(k2), std::string("bin\0ario\n", 9));
+
+    {
+        std::ofstream truncated(path, std::ios::binary | std::ios::trunc);
+        truncated << "SEMCACHE";
+    }
+    EXPECT_FALSE(loaded.load(path));
+    EXPECT_EQ(loaded.size(), 0u);
+    std::remove(path.c_str());
+    EXPECT_FALSE(loaded.load(path));
+}
+
+// Solo se vuelven a compilar las unidades cuyas entradas cambiaron
+TEST(FingerprintTest, CompileCachedSkipsUnchangedUnits)
+{
+    CompileSession session;
+    AnalysisCache cache;
+    std::vector<std::string> names = {"a.c", "b.c", "c.c"};
+    std::string sourceOfB = "int b;";
+    auto inputsOf = [&](const std::string &name)
+    { return FingerprintBuilder().add(name == "b.c" ? sourceOfB : name).result(); };
+
+    int compiled = 0;
+    auto compile = [&](TranslationUnit &unit)
+    {
+        ++compiled;
+        return unit.name() + ":" + std::to_string(unit.types().count());
+    };
+
+    auto first = session.compileCached(names, cache, inputsOf, compile);
+    EXPECT_EQ(compiled, 3);
+    EXPECT_EQ(session.compileCached(names, cache, inputsOf, compile), first);
+    EXPECT_EQ(compiled, 3);
+
+    sourceOfB = "int b, c;";
+    session.compileCached(names, cache, inputsOf, compile);
+    EXPECT_EQ(compiled, 4);
+    EXPECT_EQ(cache.hits(), 5u);
+    EXPECT_EQ(cache.misses(), 4u);
+}
+
+// Las huellas de cadenas no dependen del orden de bytes ni de __int128: valores fijos
+TEST(FingerprintTest, StringFingerprintsArePinned)
+{
+    EXPECT_EQ(FingerprintBuilder().add(std::string_view("huella de una cadena de prueba")).result().toHex(),
+              "cd1c5bd78714be186a1178394b80f728");
+    EXPECT_EQ(FingerprintBuilder().add(7).add(std::string_view("abc")).result().toHex(),
+              "1972d33ff2add0a99d76da68d2671323");
+
+    uint64_t x = 0x9e3779b97f4a7c15ULL;
+    for (int i = 0; i < 1000; ++i)
+    {
+        uint64_t y = mixHash(x + i);
+        EXPECT_EQ(WyHash::mumPortable(x, y), WyHash::mum(x, y));
+        x = y;
+    }
+    EXPECT_EQ(WyHash::mumPortable(~0ULL, ~0ULL), WyHash::mum(~0ULL, ~0ULL));
+
+    // fingerprint(id) solo valida el ID
+    TypeTable types;
+    int tInt = types.addBasicType("int", 4);
+    EXPECT_THROW(types.fingerprint(tInt + 1), std::out_of_range);
+    EXPECT_THROW(types.canonicalId(-1), std::out_of_range);
+    EXPECT_EQ(types.fingerprint(tInt), types.fingerprint(types.canonicalId(tInt)));
+
+    DependencyTracker deps;
+    types.attachDependencyTracker(&deps);
+    deps.beginRegion("r");
+    types.fingerprint(tInt);
+    deps.endRegion();
+    EXPECT_TRUE(deps.typesReadBy("r").empty());
+}
@@ -0,0 +1,109 @@
+#include "../src/FrameAllocator.hpp"
+#include "../src/SymbolTableStack.hpp"
+#include "../src/TypeTable.hpp"
+#include <gtest/gtest.h>
+
+// Los desplazamientos respetan la alineación de cada tipo
+TEST(FrameAllocatorTest, AllocatesAlignedOffsets)
+{
+    TypeTable tt;
+    int tChar = tt.addBasicType("char", 1);
+    int tInt = tt.addBasicType("int", 4);
+    int tDouble = tt.addBasicType("double", 8);
+    int tArr = tt.addArrayType(tChar, 3);
+
+    FrameAllocator fa(tt);
+    fa.beginFunction("f");
+
+    EXPECT_EQ(fa.allocate(tChar), 0);
+    EXPECT_EQ(fa.allocate(tInt), 4);    // se salta 1..3
+    EXPECT_EQ(fa.allocate(tArr), 8);    // char[3] se alinea como char
+    EXPECT_EQ(fa.allocate(tDouble), 16); // se salta 11..15
+
+    EXPECT_EQ(fa.endFunction(), 24);
+    EXPECT_EQ(fa.frameSizeOf("f"), 24);
+    EXPECT_EQ(fa.frameSizeOf("g"), -1);
+}
+
+// Los campos de una estructura perezosa quedan donde el marco pondría las mismas variables
+TEST(FrameAllocatorTest, LazyStructFieldsMatchFrameLayout)
+{
+    TypeTable tt;
+    int tChar = tt.addBasicType("char", 1);
+    int tInt = tt.addBasicType("int", 4);
+    int tDouble = tt.addBasicType("double", 8);
+    int tArr = tt.addArrayType(tChar, 3);
+
+    auto source = std::make_shared<const std::string>("ciad");
+    int id = tt.addLazyStructType("S", 24, {source, {{0, 1, tChar}, {1, 1, tInt}, {2, 1, tArr}, {3, 1, tDouble}}});
+
+    FrameAllocator fa(tt);
+    fa.beginFunction("f");
+    for (const char *field : {"c", "i", "a", "d"})
+    {
+        int typeId = tt.lookupMember(id, field)->typeId;
+        EXPECT_EQ(tt.lookupMember(id, field)->address, fa.allocate(typeId)) << field;
+    }
+}
+
+// Ámbitos hermanos comparten espacio: el marco mide la rama más profunda
+TEST(FrameAllocatorTest, SiblingScopesReuseSlots)
+{
+    TypeTable tt;
+    int tInt = tt.addBasicType("int", 4);
+
+    FrameAllocator fa(tt);
+    fa.beginFunction("main");
+
+    int a = fa.allocate(tInt);
+    fa.enterScope();
+    int b = fa.allocate(tInt);
+    int c = fa.allocate(tInt);
+    fa.exitScope();
+    fa.enterScope();
+    int d = fa.allocate(tInt);
+    fa.exitScope();
+
+    EXPECT_EQ(a, 0);
+    EXPECT_EQ(b, 4);
+    EXPECT_EQ(c, 8);
+    EXPECT_EQ(d, 4); // reutiliza el lugar de b
+    EXPECT_EQ(fa.endFunction(), 12);
+}
+
+// Conectado a la pila, insertTop asigna direcciones a VAR/PARAM y popScope libera
+TEST(FrameAllocatorTest, DrivenBySymbolTableStack)
+{
+    TypeTable tt;
+    int tInt = tt.addBasicType("int", 4);
+    int tDouble = tt.addBasicType("double", 8);
+
+    SymbolTableStack stack;
+    stack.pushScope(); // global, antes de conectar el asignador
+
+    FrameAllocator fa(tt);
+    stack.attachAllocator(&fa);
+    fa.beginFunction("f");
+
+    stack.pushScope(); // parámetros y cuerpo
+    EXPECT_TRUE(stack.insertTop({"p", tInt, Category::PARAM, 999, {}}));
+    EXPECT_FALSE(stack.insertTop({"p", tInt, Category::VAR, 999, {}})); // duplicado no reserva
+    EXPECT_TRUE(stack.insertTop({"k", tInt, Category::CONST, 77, {}}));  // CONST conserva su dirección
+
+    {
+        ScopeGuard inner(stack);
+        EXPECT_TRUE(stack.insertTop({"d", tDouble, Category::VAR, 0, {}}));
+        EXPECT_EQ(stack.lookupTop("d")->address, 8);
+    }
+    {
+        ScopeGuard inner(stack);
+        EXPECT_TRUE(stack.insertTop({"e", tInt, Category::VAR, 0, {}}));
+        EXPECT_EQ(stack.lookupTop("e")->address, 4);
+    }
+
+    EXPECT_EQ(stack.lookupTop("p")->address, 0);
+    EXPECT_EQ(stack.lookupTop("k")->address, 77);
+
+    stack.popScope();
+    EXPECT_EQ(fa.endFunction(), 16);
+}
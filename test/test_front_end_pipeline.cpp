@@ -0,0 +1,200 @@
+#include "../src/FrontEndPipeline.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using K = FrontEndEventKind;
+
+    // Fuente que entrega los eventos de un vector
+    struct VectorSource
+    {
+        const std::vector<FrontEndEvent> &events;
+        size_t next = 0;
+        bool operator()(FrontEndEvent &event)
+        {
+            if (next == events.size())
+                return false;
+            event = events[next++];
+            return true;
+        }
+    };
+
+    // Programa de prueba: `functions` funciones con locales int/float y asignaciones mixtas
+    std::vector<FrontEndEvent> program(int functions, int tInt, int tFloat)
+    {
+        std::vector<FrontEndEvent> events;
+        for (int f = 0; f < functions; ++f)
+        {
+            events.push_back({K::BEGIN_FUNCTION, "f" + std::to_string(f), tInt});
+            events.push_back({K::DECLARE, "i", tInt, Category::PARAM});
+            events.push_back({K::DECLARE, "x", tFloat});
+            events.push_back({K::OPEN_SCOPE, ""});
+            events.push_back({K::DECLARE, "y", tFloat});
+            // y = x + i * 2
+            events.push_back({K::LOAD, "x"});
+            events.push_back({K::LOAD, "i"});
+            events.push_back({K::CONSTANT, "2", tInt});
+            events.push_back({K::BINARY, "*"});
+            events.push_back({K::BINARY, "+"});
+            events.push_back({K::ASSIGN, "y"});
+            events.push_back({K::CLOSE_SCOPE, ""});
+            events.push_back({K::END_BLOCK, ""});
+            // x = i
+            events.push_back({K::LOAD, "i"});
+            events.push_back({K::ASSIGN, "x"});
+            events.push_back({K::END_FUNCTION, ""});
+        }
+        return events;
+    }
+
+    struct Fixture
+    {
+        TypeTable types;
+        int tInt = types.addBasicType("int", 4);
+        int tFloat = types.addBasicType("float", 4);
+        TypeManager manager{types};
+        SymbolTableStack symbols;
+        CodeGenerator gen;
+        Fixture() { symbols.pushScope(); }
+    };
+
+    std::vector<std::string> render(const CodeGenerator &gen)
+    {
+        std::vector<std::string> lines;
+        for (const Quad &q : gen.getCode())
+            lines.push_back(q.result + " = " + q.arg1 + " " + q.op + " " + q.arg2);
+        return lines;
+    }
+}
+
+// Declaraciones, tipos y código en un solo recorrido del flujo
+TEST(FrontEndPipelineTest, EmitsTypedCodeFromEvents)
+{
+    Fixture fx;
+    auto events = program(1, fx.tInt, fx.tFloat);
+    FrontEndPipeline pipeline(fx.symbols, fx.manager, fx.gen, PipelineOptions{4, 1, false});
+    PipelineStats stats = pipeline.run(VectorSource{events});
+
+    EXPECT_EQ(stats.events, events.size());
+    EXPECT_EQ(stats.batches, (events.size() + 3) / 4);
+    EXPECT_EQ(stats.peakBufferedEvents, 4u);
+
+    // i * 2 en int, se amplía a float para sumar con x; luego x = (float) i
+    std::vector<std::string> expected = {
+        "t0 = i * 2", "t1 = t0 (float) ", "t2 = x + t1", "y = t2 = ", "t3 = i (float) ", "x = t3 = "};
+    EXPECT_EQ(render(fx.gen), expected);
+
+    // Los ámbitos de la función se cerraron; la función quedó en el global
+    EXPECT_EQ(fx.symbols.levels(), 1u);
+    ASSERT_NE(fx.symbols.lookup("f0"), nullptr);
+    EXPECT_EQ(fx.symbols.lookup("x"), nullptr);
+}
+
+// Con hilos y lotes pequeños el código es el mismo y lo que está en tránsito sigue acotado
+TEST(FrontEndPipelineTest, ThreadedMatchesSequential)
+{
+    Fixture a, b;
+    auto events = program(200, a.tInt, a.tFloat);
+
+    FrontEndPipeline sequential(a.symbols, a.manager, a.gen, PipelineOptions{64, 2, false});
+    sequential.run(VectorSource{events});
+
+    PipelineOptions options{5, 2, true};
+    FrontEndPipeline threaded(b.symbols, b.manager, b.gen, options);
+    PipelineStats stats = threaded.run(VectorSource{events});
+
+    EXPECT_EQ(render(a.gen), render(b.gen));
+    EXPECT_EQ(stats.events, events.size());
+    // Un lote en cada cola llena, uno en cada etapa y el que espera para entrar
+    EXPECT_LE(stats.peakBufferedEvents, options.batchEvents * (3 * options.queueBatches + 4));
+    EXPECT_EQ(b.symbols.levels(), 1u);
+}
+
+// El primer error detiene el flujo, se relanza y la pila vuelve a como estaba
+TEST(FrontEndPipelineTest, ErrorsStopThePipeline)
+{
+    for (bool threaded : {false, true})
+    {
+        Fixture fx;
+        auto events = program(50, fx.tInt, fx.tFloat);
+        events.insert(events.begin() + 80, {K::LOAD, "desconocida"});
+
+        FrontEndPipeline pipeline(fx.symbols, fx.manager, fx.gen, PipelineOptions{8, 1, threaded});
+        EXPECT_THROW(pipeline.run(VectorSource{events}), SymbolNotFoundError);
+        EXPECT_EQ(fx.symbols.levels(), 1u);
+
+        // Ámbito sin cerrar al final del flujo
+        std::vector<FrontEndEvent> open = {{K::OPEN_SCOPE, ""}, {K::DECLARE, "z", fx.tInt}};
+        EXPECT_THROW(pipeline.run(VectorSource{open}), std::runtime_error);
+        EXPECT_EQ(fx.symbols.levels(), 1u);
+
+        // Asignación que requiere reducir
+        std::vector<FrontEndEvent> narrowing = {
+            {K::DECLARE, "n", fx.tInt}, {K::CONSTANT, "1.5", fx.tFloat}, {K::ASSIGN, "n"}};
+        EXPECT_THROW(pipeline.run(VectorSource{narrowing}), std::runtime_error);
+    }
+}
+
+// Con errores en dos etapas, con y sin hilos se relanza el del evento más temprano, aunque
+// con hilos la etapa de declaraciones llegue antes a su error
+TEST(FrontEndPipelineTest, ThreadedReportsTheSameErrorAsSequential)
+{
+    auto message = [](bool threaded, bool typeErrorFirst)
+    {
+        Fixture fx;
+        auto events = program(100, fx.tInt, fx.tFloat);
+        // Cada función ocupa 16 eventos. El error de tipos al final del primer lote y el
+        // de nombres al inicio del segundo: con hilos las declaraciones suelen llegar al
+        // suyo mientras la etapa de tipos aún recorre el primer lote
+        size_t typeAt = typeErrorFirst ? 16 * 3 + 13 : 16 * 10 + 13;
+        size_t nameAt = typeErrorFirst ? 16 * 4 + 2 : 16 * 1 + 2;
+        // Insertar primero en la posición mayor para no desplazar la otra
+        std::vector<std::pair<size_t, std::vector<FrontEndEvent>>> errors = {
+            {typeAt, {{K::CONSTANT, "1.5", fx.tFloat}, {K::ASSIGN, "i"}}}, // float -> int
+            {nameAt, {{K::LOAD, "desconocida"}}}};
+        if (errors[0].first < errors[1].first)
+            std::swap(errors[0], errors[1]);
+        for (auto &[at, inserted] : errors)
+            events.insert(events.begin() + at, inserted.begin(), inserted.end());
+
+        FrontEndPipeline pipeline(fx.symbols, fx.manager, fx.gen, PipelineOptions{64, 4, threaded});
+        try
+        {
+            pipeline.run(VectorSource{events});
+        }
+        catch (const std::exception &error)
+        {
+            EXPECT_EQ(fx.symbols.levels(), 1u);
+            return std::string(error.what());
+        }
+        ADD_FAILURE() << "El flujo debía fallar";
+        return std::string();
+    };
+
+    for (bool typeErrorFirst : {true, false})
+    {
+        std::string expected = message(false, typeErrorFirst);
+        EXPECT_EQ(expected.find("desconocida") == std::string::npos, typeErrorFirst) << expected;
+        for (int run = 0; run < 20; ++run)
+            EXPECT_EQ(message(true, typeErrorFirst), expected);
+    }
+}
+
+// Con hilos, dos etapas leerían la TypeTable a la vez: no se admite un registro de dependencias
+TEST(FrontEndPipelineTest, ThreadedRejectsDependencyTracker)
+{
+    Fixture fx;
+    DependencyTracker tracker;
+    fx.types.attachDependencyTracker(&tracker);
+    auto events = program(2, fx.tInt, fx.tFloat);
+
+    FrontEndPipeline threaded(fx.symbols, fx.manager, fx.gen, PipelineOptions{8, 1, true});
+    EXPECT_THROW(threaded.run(VectorSource{events}), std::logic_error);
+    EXPECT_EQ(fx.symbols.levels(), 1u);
+
+    // Sin hilos sí se puede
+    FrontEndPipeline single(fx.symbols, fx.manager, fx.gen, PipelineOptions{8, 1, false});
+    EXPECT_EQ(single.run(VectorSource{events}).events, events.size());
+}
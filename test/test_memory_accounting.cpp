@@ -0,0 +1,273 @@
+#include "../src/MemoryAccounting.hpp"
+#include "../src/SymbolTableStack.hpp"
+#include "../src/TypeTable.hpp"
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <string>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Reservas del operator new global que siguen vivas, de las hechas mientras el hilo tenía
+// `countGlobalNews` activo. Cada bloque lleva antes un encabezado con el desplazamiento al
+// inicio real y un bit que dice si se contó.
+namespace
+{
+    std::atomic<long> liveGlobalNews{0};
+    thread_local bool countGlobalNews = false;
+
+    void *taggedNew(size_t size, size_t align)
+    {
+        size_t header = align < 16 ? 16 : align;
+        size_t total = (header + size + header - 1) / header * header;
+        char *base = static_cast<char *>(std::aligned_alloc(header, total));
+        if (!base)
+            throw std::bad_alloc();
+        char *user = base + header;
+        reinterpret_cast<size_t *>(user)[-1] = header | (countGlobalNews ? 1 : 0);
+        if (countGlobalNews)
+            ++liveGlobalNews;
+        return user;
+    }
+
+    void taggedDelete(void *p) noexcept
+    {
+        if (!p)
+            return;
+        size_t tag = static_cast<size_t *>(p)[-1];
+        if (tag & 1)
+            --liveGlobalNews;
+        std::free(static_cast<char *>(p) - (tag & ~size_t(1)));
+    }
+}
+
+void *operator new(size_t size) { return taggedNew(size, 16); }
+void *operator new(size_t size, std::align_val_t align) { return taggedNew(size, static_cast<size_t>(align)); }
+void operator delete(void *p) noexcept { taggedDelete(p); }
+void operator delete(void *p, size_t) noexcept { taggedDelete(p); }
+void operator delete(void *p, std::align_val_t) noexcept { taggedDelete(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { taggedDelete(p); }
+
+// Cada categoría crece con lo que le corresponde
+TEST(MemoryAccountingTest, SymbolTableReportsByCategory)
+{
+    SymbolTable st;
+    MemoryUsage empty = st.memoryUsage();
+    EXPECT_EQ(empty.total(), 0u);
+
+    st.insert({"corto", 1, Category::VAR, 0, {}});
+    MemoryUsage one = st.memoryUsage();
+    EXPECT_GT(one.entries, 0u);
+    EXPECT_GT(one.buckets, 0u);
+    EXPECT_EQ(one.keys, 0u); // cabe en SSO
+    EXPECT_EQ(one.params, 0u);
+
+    st.insert({"un_identificador_bastante_largo", 1, Category::FUNCTION, 0, {1, 2, 3, 4}});
+    MemoryUsage two = st.memoryUsage();
+    EXPECT_GE(two.keys, 31u);
+    EXPECT_GE(two.params, 4 * sizeof(int));
+
+    st.enableBloomFilter(true);
+    EXPECT_EQ(st.memoryUsage().buckets, two.buckets + 512 / 8);
+}
+
+// Las tablas que la pila guarda tras popScope se ven en `recycled`
+TEST(MemoryAccountingTest, StackReportsRecycledScopes)
+{
+    SymbolTableStack stack;
+    stack.pushScope();
+    stack.pushScope();
+    for (int i = 0; i < 100; ++i)
+        stack.insertTop({"v" + std::to_string(i), 0, Category::VAR, i, {}});
+    MemoryUsage open = stack.memoryUsage();
+    EXPECT_EQ(open.recycled, 0u);
+
+    stack.popScope();
+    MemoryUsage closed = stack.memoryUsage();
+    EXPECT_GT(closed.recycled, 0u);
+    EXPECT_LT(closed.entries, open.entries);
+}
+
+TEST(MemoryAccountingTest, TypeTableCountsNamesAndFieldTables)
+{
+    TypeTable tt;
+    int tInt = tt.addBasicType("int", 4);
+    tt.addBasicType("un_nombre_de_tipo_muy_largo_para_sso", 8);
+    MemoryUsage before = tt.memoryUsage();
+    EXPECT_GE(before.names, 2 * sizeof(std::string) + 36);
+
+    auto source = std::make_shared<const std::string>("struct Uno { int u; };");
+    int idUno = tt.addLazyStructType("Uno", 4, LazyStructDescriptor{source, {{17, 1, tInt}}});
+    tt.lookupMember(idUno, "u");
+    MemoryUsage after = tt.memoryUsage();
+    EXPECT_GT(after.entries, before.entries);
+    EXPECT_GT(after.buckets, before.buckets);
+}
+
+// Los contadores globales siguen a CountingAllocator y guardan el máximo
+TEST(MemoryAccountingTest, CountingAllocatorAndHighWaterMark)
+{
+    size_t baseParams = trackedMemory().params;
+    resetMemoryHighWaterMark();
+    size_t base = memoryHighWaterMark();
+    {
+        std::vector<int, CountingAllocator<int, MemoryCategory::PARAMS>> v;
+        v.reserve(1000);
+        EXPECT_EQ(trackedMemory().params, baseParams + 1000 * sizeof(int));
+        EXPECT_GE(memoryHighWaterMark(), base + 1000 * sizeof(int));
+    }
+    EXPECT_EQ(trackedMemory().params, baseParams);
+    EXPECT_GE(memoryHighWaterMark(), base + 1000 * sizeof(int)); // el máximo se queda
+
+    // Las tablas de símbolos reservan por CountingAllocator
+    size_t entriesBefore = trackedMemory().entries;
+    SymbolTable st;
+    st.insert({"x", 0, Category::VAR, 0, {}});
+    EXPECT_GT(trackedMemory().entries, entriesBefore);
+}
+
+// El texto de los ids, los params y los nombres de tipos también llegan a los contadores
+TEST(MemoryAccountingTest, IdsParamsAndNamesAreTracked)
+{
+    std::string longId(100, 'k');
+    std::string longName(100, 'n');
+    MemoryUsage before = trackedMemory();
+    resetMemoryHighWaterMark();
+    size_t peakBefore = memoryHighWaterMark();
+    {
+        SymbolTable st;
+        st.insert({longId, 0, Category::FUNCTION, 0, {1, 2, 3, 4, 5, 6, 7, 8}});
+        TypeTable tt;
+        tt.addBasicType(longName, 4);
+
+        MemoryUsage now = trackedMemory();
+        EXPECT_GE(now.keys, before.keys + longId.size());
+        EXPECT_GE(now.params, before.params + 8 * sizeof(int));
+        EXPECT_GE(now.names, before.names + longName.size());
+        EXPECT_GE(memoryHighWaterMark(), peakBefore + longId.size() + longName.size() + 8 * sizeof(int));
+
+        // Una copia fuera de la tabla usa el recurso por defecto, no el de la tabla
+        std::pmr::monotonic_buffer_resource arena;
+        SymbolTable inArena(&arena);
+        inArena.insert({longId, 0, Category::VAR, 0, {}});
+        SymbolEntry copy = *inArena.lookup(longId);
+        EXPECT_EQ(copy.id.get_allocator().resource(), std::pmr::get_default_resource());
+    }
+    MemoryUsage after = trackedMemory();
+    EXPECT_EQ(after.keys, before.keys);
+    EXPECT_EQ(after.params, before.params);
+    EXPECT_EQ(after.names, before.names);
+}
+
+namespace
+{
+    // Recurso que cuenta lo que se le pide y lo que sigue sin devolverse
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        size_t requested = 0;
+        size_t outstanding = 0;
+
+    private:
+        void *do_allocate(size_t bytes, size_t align) override
+        {
+            requested += bytes;
+            outstanding += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+        void do_deallocate(void *p, size_t bytes, size_t align) override
+        {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+}
+
+// Una sesión completa sobre una arena monotónica se libera de una vez
+TEST(MemoryAccountingTest, SessionRunsOnMonotonicArena)
+{
+    CountingResource upstream;
+    {
+        std::pmr::monotonic_buffer_resource arena(&upstream);
+        {
+            TypeTable tt(&arena);
+            int tInt = tt.addBasicType("int", 4);
+            auto source = std::make_shared<const std::string>("struct Uno { int u; };");
+            int idUno = tt.addLazyStructType("Uno", 4, LazyStructDescriptor{source, {{17, 1, tInt}}});
+
+            SymbolTableStack stack(&arena);
+            stack.pushScope();
+            for (int i = 0; i < 200; ++i)
+                stack.insertBase({"g" + std::to_string(i), tInt, Category::VAR, i * 4, {}});
+            stack.pushScope();
+            stack.insertTop({"x", idUno, Category::VAR, 0, {}});
+
+            EXPECT_EQ(stack.currentScope()->resource(), &arena);
+            EXPECT_EQ(stack.lookup("g150")->address, 600);
+            EXPECT_EQ(tt.lookupMember(stack.lookup("x")->typeId, "u")->typeId, tInt);
+            tt.freezeStructFields();
+            EXPECT_EQ(tt.getFrozenFields(idUno)->resource(), &arena);
+        }
+        EXPECT_GT(upstream.requested, 0u);
+        EXPECT_GT(upstream.outstanding, 0u); // la arena no devuelve nada hasta release
+        arena.release();
+        EXPECT_EQ(upstream.outstanding, 0u);
+    }
+
+    // Sin recurso explícito se usa el del proceso
+    SymbolTable st;
+    EXPECT_EQ(st.resource(), std::pmr::get_default_resource());
+}
+
+// Con un recurso, lo que la sesión conserva no toca el heap global: tablas de ámbitos y de
+// campos, entradas con ids largos y parámetros, vectores de la pila y tablas congeladas.
+// Los temporales que se liberan dentro de cada llamada no cuentan.
+TEST(MemoryAccountingTest, SessionKeepsNothingOnGlobalHeap)
+{
+    std::vector<char> buffer(1 << 20);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    auto source = std::make_shared<const std::string>("struct Uno { int un_campo_con_nombre_largo; };");
+    LazyStructDescriptor descriptor{source, {{17, 25, 0}}};
+
+    long liveInSession = -1;
+    int foundAddress = -1;
+    {
+        countGlobalNews = true;
+        TypeTable tt(&arena);
+        int tInt = tt.addBasicType("int", 4);
+        tt.addArrayType(tInt, 10);
+        int idUno = tt.addLazyStructType("Uno", 4, std::move(descriptor));
+
+        SymbolTableStack stack(&arena);
+        stack.setHotCache(16);
+        stack.setBloomFilters(true);
+        stack.pushScope();
+        for (int i = 0; i < 100; ++i)
+            stack.insertBase({"identificador_global_largo_" + std::to_string(i), tInt, Category::FUNCTION, i * 4, {1, 2, 3}});
+        stack.pushScope();
+        stack.insertTop({"campo_de_estructura_largo", tInt, Category::VAR, 0, {}});
+        SymbolTableStack::ScopePtr fields = stack.takeScope();
+        int idDos = tt.addStructType("Dos", 4, fields.get());
+        for (int f = 0; f < 10; ++f)
+        {
+            ScopeGuard scope(stack);
+            stack.insertTop({"variable_local_con_nombre_largo", idDos, Category::VAR, 0, {}});
+            stack.lookup("identificador_global_largo_42");
+        }
+        tt.lookupMember(idUno, "un_campo_con_nombre_largo");
+        tt.freezeStructFields();
+        std::shared_ptr<const SymbolTable> global = stack.freezeBase();
+        foundAddress = global->getAddress("identificador_global_largo_7");
+
+        liveInSession = liveGlobalNews.load();
+        countGlobalNews = false;
+    }
+
+    EXPECT_EQ(liveInSession, 0);
+    EXPECT_EQ(liveGlobalNews.load(), 0);
+    EXPECT_EQ(foundAddress, 28);
+}
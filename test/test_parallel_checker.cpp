@@ -0,0 +1,221 @@
+#include "../src/ParallelChecker.hpp"
+#include "../src/TypeManager.hpp"
+#include "../src/TypeTable.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+
+// Al congelar la base, la pila conserva sus niveles pero el global ya no acepta inserciones
+TEST(ParallelCheckerTest, FreezeBaseMakesGlobalReadOnly)
+{
+    SymbolTableStack stack;
+    stack.pushScope(); // global
+    stack.insertBase({"g", 3, Category::VAR, 0, {}});
+    stack.pushScope(); // local
+
+    auto frozen = stack.freezeBase();
+    ASSERT_NE(frozen, nullptr);
+    EXPECT_TRUE(stack.isBaseFrozen());
+    EXPECT_EQ(stack.levels(), 2u);
+
+    EXPECT_FALSE(stack.insertBase({"h", 3, Category::VAR, 0, {}}));
+    ASSERT_NE(stack.findBase("g"), nullptr);
+    EXPECT_EQ(stack.globalScope(), nullptr);
+    EXPECT_EQ(stack.frozenGlobal(), frozen.get());
+
+    // Congelar de nuevo regresa la misma tabla
+    EXPECT_EQ(stack.freezeBase(), frozen);
+}
+
+// Una pila montada sobre el global congelado ve el global como tope hasta abrir un ámbito
+TEST(ParallelCheckerTest, LayeredStackSeesFrozenGlobal)
+{
+    SymbolTableStack builder;
+    builder.pushScope();
+    builder.insertBase({"g", 3, Category::VAR, 0, {}});
+    auto frozen = builder.freezeBase();
+
+    SymbolTableStack local(frozen);
+    EXPECT_EQ(local.levels(), 1u);
+    ASSERT_NE(local.findTop("g"), nullptr);
+    EXPECT_FALSE(local.insertTop({"x", 3, Category::VAR, 0, {}}));
+
+    local.pushScope();
+    EXPECT_TRUE(local.insertTop({"g", 4, Category::VAR, 8, {}})); // sombra local
+    EXPECT_EQ(local.findTop("g")->typeId, 4);
+    EXPECT_EQ(local.findBase("g")->typeId, 3);
+
+    // popScope nunca saca el global congelado
+    local.popScope();
+    local.popScope();
+    EXPECT_EQ(local.levels(), 1u);
+    EXPECT_EQ(local.popSymbolTable(), nullptr);
+}
+
+// La alberca ejecuta todas las tareas, incluidas las que se envían desde otra tarea
+TEST(ParallelCheckerTest, PoolRunsNestedTasks)
+{
+    WorkStealingPool pool(4);
+    std::atomic<int> count{0};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        pool.submit([&]
+                    {
+                        count++;
+                        pool.submit([&]
+                                    { count++; }); });
+    }
+    pool.wait();
+    EXPECT_EQ(count.load(), 200);
+}
+
+// Los resultados en paralelo coinciden exactamente con la comprobación secuencial
+TEST(ParallelCheckerTest, ParallelMatchesSequential)
+{
+    TypeTable types;
+    int tInt = types.addBasicType("int", 4);
+    int tFloat = types.addBasicType("float", 4);
+    TypeManager manager(types);
+
+    SymbolTableStack globals;
+    globals.pushScope();
+    globals.insertBase({"gi", tInt, Category::VAR, 0, {}});
+    globals.insertBase({"gf", tFloat, Category::VAR, 4, {}});
+
+    WorkStealingPool pool(4);
+    ParallelChecker checker(globals.freezeBase(), pool);
+
+    // Cada "cuerpo" declara un local y calcula el tipo de local + global
+    std::vector<int> bodies;
+    for (int i = 0; i < 500; ++i)
+        bodies.push_back(i);
+
+    auto check = [&](const int &body, SymbolTableStack &stack)
+    {
+        stack.pushScope();
+        stack.insertTop({"x", body % 2 ? tFloat : tInt, Category::VAR, 0, {}});
+        const char *global = body % 3 ? "gi" : "gf";
+        return manager.max(stack.findTop("x")->typeId, stack.findBase(global)->typeId);
+    };
+
+    EXPECT_EQ(checker.checkAll(bodies, check), checker.checkSequential(bodies, check));
+}
+
+// Si varias comprobaciones fallan, se relanza el error del primer cuerpo en orden
+TEST(ParallelCheckerTest, FirstErrorInOrderIsRethrown)
+{
+    SymbolTableStack globals;
+    globals.pushScope();
+
+    WorkStealingPool pool(4);
+    ParallelChecker checker(globals.freezeBase(), pool);
+
+    std::vector<int> bodies = {0, 1, 2, 3, 4, 5};
+    auto check = [](const int &body, SymbolTableStack &) -> int
+    {
+        if (body >= 2)
+            throw std::runtime_error("cuerpo " + std::to_string(body));
+        return body;
+    };
+
+    try
+    {
+        checker.checkAll(bodies, check);
+        FAIL() << "Se esperaba una excepción";
+    }
+    catch (const std::runtime_error &e)
+    {
+        EXPECT_STREQ(e.what(), "cuerpo 2");
+    }
+}
+
+// Con resultados bool cada tarea escribe en su propia ranura (no en los bits compartidos
+// de std::vector<bool>), y el resultado no necesita constructor por omisión
+TEST(ParallelCheckerTest, BoolAndNonDefaultResults)
+{
+    SymbolTableStack globals;
+    globals.pushScope();
+    globals.insertBase({"g", 1, Category::VAR, 0, {}});
+
+    WorkStealingPool pool(4);
+    ParallelChecker checker(globals.freezeBase(), pool);
+
+    std::vector<int> bodies;
+    for (int i = 0; i < 2000; ++i)
+        bodies.push_back(i);
+
+    auto isEven = [](const int &body, SymbolTableStack &stack)
+    {
+        return body % 2 == 0 && stack.find("g") != nullptr;
+    };
+    std::vector<bool> flags = checker.checkAll(bodies, isEven);
+    ASSERT_EQ(flags.size(), bodies.size());
+    EXPECT_EQ(flags, checker.checkSequential(bodies, isEven));
+
+    struct Named
+    {
+        explicit Named(int v) : value(v) {}
+        int value;
+    };
+    auto named = [](const int &body, SymbolTableStack &)
+    { return Named(body * 3); };
+    std::vector<Named> values = checker.checkAll(bodies, named);
+    for (size_t i = 0; i < bodies.size(); ++i)
+        EXPECT_EQ(values[i].value, bodies[i] * 3);
+}
+
+// Cada lote espera solo a sus tareas: un hilo cuyo lote es rápido no queda bloqueado por
+// el lote lento de otro hilo en la misma alberca
+TEST(ParallelCheckerTest, BatchesOnSharedPoolWaitIndependently)
+{
+    WorkStealingPool pool(4);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+
+    auto slow = std::async(std::launch::async, [&]
+                           { return collectInOrder(pool, 2, [&](size_t i)
+                                                   {
+                                                       released.wait();
+                                                       return static_cast<int>(i); }); });
+    auto fast = std::async(std::launch::async, [&]
+                           { return collectInOrder(pool, 50, [](size_t i)
+                                                   { return static_cast<int>(i) * 2; }); });
+
+    bool fastFinished = fast.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+    release.set_value();
+    ASSERT_TRUE(fastFinished);
+    EXPECT_EQ(fast.get()[49], 98);
+    EXPECT_EQ(slow.get(), (std::vector<int>{0, 1}));
+}
+
+// Esperar desde una tarea de la misma alberca nunca terminaría: se rechaza con una excepción
+TEST(ParallelCheckerTest, WaitFromTaskThrows)
+{
+    WorkStealingPool pool(2);
+    std::atomic<int> rejected{0};
+    WorkStealingPool::TaskGroup group;
+    pool.submit(group, [&]
+                {
+                    try
+                    {
+                        pool.wait();
+                    }
+                    catch (const std::logic_error &)
+                    {
+                        rejected++;
+                    }
+                    try
+                    {
+                        collectInOrder(pool, 1, [](size_t i)
+                                       { return i; });
+                    }
+                    catch (const std::logic_error &)
+                    {
+                        rejected++;
+                    } });
+    pool.wait(group);
+    EXPECT_EQ(rejected.load(), 2);
+}
@@ -1,5 +1,7 @@
 #include "../src/SymbolTable.hpp"
 #include <gtest/gtest.h>
+#include <type_traits>
+#include <utility>
 
 // Pruebas para símbolos de variable
 TEST(SymbolTableTest, InsertAndQueryVariableSymbol)
@@ -24,7 +26,7 @@ TEST(SymbolTableTest, InsertAndQueryVariableSymbol)
     EXPECT_EQ(st.getCategory("x"), Category::VAR);
 
     // Para una variable, la lista de parámetros debe estar vacía.
-    auto params = st.getParams("x");
+    std::vector<int> params = st.getParams("x");
     EXPECT_TRUE(params.empty());
 
     // Usamos lookup para obtener la entrada completa.
@@ -57,7 +59,7 @@ TEST(SymbolTableTest, InsertFunctionSymbolWithParams)
     EXPECT_EQ(st.getCategory("sum"), Category::FUNCTION);
 
     // Recuperamos y verificamos la lista de parámetros.
-    auto params = st.getParams("sum");
+    std::vector<int> params = st.getParams("sum");
     // Debe tener solo dos parámetros y ambos de tipo int (typeId 3).
     ASSERT_EQ(params.size(), 2u);
     EXPECT_EQ(params[0], 3);
@@ -109,3 +111,92 @@ TEST(SymbolTableTest, NotFoundThrowsOnGetters)
     // lookup devuelve un puntero nulo si no se encuentra el símbolo
     EXPECT_EQ(st.lookup("y"), nullptr);
 }
+
+// El filtro de Bloom nunca descarta un id que sí está, incluso después de crecer
+TEST(SymbolTableTest, BloomFilterHasNoFalseNegatives)
+{
+    SymbolTable st;
+    st.insert({"antes", 3, Category::VAR, 0, {}});
+    st.enableBloomFilter(true);
+    EXPECT_TRUE(st.hasBloomFilter());
+
+    // Suficientes ids para forzar varias reconstrucciones del filtro
+    for (int i = 0; i < 1000; ++i)
+        st.insert({"v" + std::to_string(i), 3, Category::VAR, i, {}});
+
+    EXPECT_TRUE(st.mayContain(SymbolTable::hashId("antes")));
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string id = "v" + std::to_string(i);
+        ASSERT_NE(st.lookup(id, SymbolTable::hashId(id)), nullptr);
+    }
+
+    // Al vaciar la tabla el filtro también se vacía
+    st.clear();
+    EXPECT_FALSE(st.mayContain(SymbolTable::hashId("v1")));
+    EXPECT_EQ(st.lookup("v1", SymbolTable::hashId("v1")), nullptr);
+}
+
+// ¿La tabla acepta insert(entry)?
+template <typename Table, typename = void>
+struct HasInsert : std::false_type
+{
+};
+
+template <typename Table>
+struct HasInsert<Table, std::void_t<decltype(std::declval<Table &>().insert(std::declval<const SymbolEntry &>()))>>
+    : std::true_type
+{
+};
+
+TEST(SymbolTableTest, FreezeKeepsEveryEntry)
+{
+    SymbolTable st;
+    for (int i = 0; i < 500; ++i)
+        st.insert({"campo" + std::to_string(i), i % 7, Category::VAR, i * 4, {}});
+
+    FrozenSymbolTable frozen = st.freeze();
+    EXPECT_EQ(frozen.size(), 500u);
+    for (int i = 0; i < 500; ++i)
+    {
+        std::string id = "campo" + std::to_string(i);
+        const SymbolEntry *entry = frozen.lookup(id);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->address, i * 4);
+        EXPECT_EQ(frozen.getType(id), i % 7);
+    }
+    EXPECT_EQ(frozen.lookup("campo500"), nullptr);
+    EXPECT_THROW(frozen.getAddress("otro"), SymbolNotFoundError);
+
+    // Una tabla vacía también se puede congelar
+    EXPECT_EQ(SymbolTable().freeze().lookup("x"), nullptr);
+
+    // La copia congelada es de solo lectura
+    static_assert(!HasInsert<FrozenSymbolTable>::value, "FrozenSymbolTable no debe tener insert");
+    static_assert(HasInsert<SymbolTable>::value, "SymbolTable debe tener insert");
+}
+
+// Los bloques de ChunkedStorage conservan las direcciones y el orden al crecer y al vaciarse
+TEST(SymbolTableTest, ChunkedStorageKeepsOrderAndPointers)
+{
+    SymbolTable st;
+    std::vector<const SymbolEntry *> first;
+    for (int i = 0; i < 1000; ++i)
+    {
+        st.insert({"v" + std::to_string(i), 0, Category::VAR, i, {}});
+        if (i < 20)
+            first.push_back(st.lookup("v" + std::to_string(i)));
+    }
+    int expected = 0;
+    for (const SymbolEntry &entry : st)
+        EXPECT_EQ(entry.address, expected++);
+    EXPECT_EQ(expected, 1000);
+    for (int i = 0; i < 20; ++i)
+        EXPECT_EQ(first[i], st.lookup("v" + std::to_string(i)));
+
+    st.clear();
+    EXPECT_EQ(st.begin(), st.end());
+    st.insert({"otra", 0, Category::VAR, 0, {}});
+    EXPECT_EQ(st.begin()->id, "otra");
+    EXPECT_EQ(std::next(st.begin()), st.end());
+}
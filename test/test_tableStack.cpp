@@ -1,6 +1,10 @@
 #include "../src/SymbolTableStack.hpp"
 #include "../src/SymbolTable.hpp"
+#include "../src/DependencyTracker.hpp"
 #include <gtest/gtest.h>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
 
 // Pruebas básicas de creación
 TEST(SymbolTableStackTest, PushScopeIncreasesLevels)
@@ -148,3 +152,253 @@ TEST(SymbolTableStackTest, EmptyStackBehaviors)
 
     EXPECT_EQ(stack.popSymbolTable(), nullptr);
 }
+
+// popScope recicla la tabla: el siguiente pushScope reutiliza la misma, ya vacía
+TEST(SymbolTableStackTest, PopScopeRecyclesTable)
+{
+    SymbolTableStack stack;
+
+    stack.pushScope();
+    stack.pushScope();
+    SymbolTable *local = stack.currentScope();
+    stack.insertTop({"x", 1, Category::VAR, 0, {}});
+
+    stack.popScope();
+    EXPECT_EQ(stack.recycledScopes(), 1u);
+
+    stack.pushScope();
+    EXPECT_EQ(stack.currentScope(), local);
+    EXPECT_EQ(stack.recycledScopes(), 0u);
+    EXPECT_EQ(stack.lookupTop("x"), nullptr);
+}
+
+// takeScope transfiere la propiedad de la tabla al llamador
+TEST(SymbolTableStackTest, TakeScopeTransfersOwnership)
+{
+    SymbolTableStack stack;
+
+    stack.pushScope();
+    stack.insertTop({"campo", 1, Category::VAR, 0, {}});
+    SymbolTable *top = stack.currentScope();
+
+    SymbolTableStack::ScopePtr fields = stack.takeScope();
+    EXPECT_EQ(fields.get(), top);
+    EXPECT_EQ(stack.levels(), 0u);
+    EXPECT_EQ(stack.recycledScopes(), 0u);
+    EXPECT_NE(fields->lookup("campo"), nullptr);
+
+    EXPECT_EQ(stack.takeScope(), nullptr);
+}
+
+// popSymbolTable siempre entrega una tabla que se libera con delete, aun con la pila en una arena
+TEST(SymbolTableStackTest, PopSymbolTableFromArenaIsDeletable)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    SymbolTableStack stack(&arena);
+    stack.setBloomFilters(true);
+    stack.pushScope();
+    stack.insertTop({"campo", 1, Category::VAR, 0, {}});
+    stack.insertTop({"otro", 2, Category::VAR, 4, {3, 4}});
+    SymbolTable *top = stack.currentScope();
+    Fingerprint print = top->fingerprint();
+
+    std::unique_ptr<SymbolTable> popped(stack.popSymbolTable());
+    ASSERT_NE(popped, nullptr);
+    EXPECT_NE(popped.get(), top);
+    EXPECT_EQ(popped->resource(), std::pmr::new_delete_resource());
+    EXPECT_TRUE(popped->hasBloomFilter());
+    EXPECT_EQ(popped->fingerprint(), print);
+    EXPECT_EQ(popped->getParams("otro"), (std::vector<int>{3, 4}));
+
+    // La original se vació y se recicla
+    EXPECT_EQ(stack.levels(), 0u);
+    EXPECT_EQ(stack.recycledScopes(), 1u);
+}
+
+// La guarda cierra el ámbito al salir del bloque, incluso con una excepción
+TEST(SymbolTableStackTest, ScopeGuardClosesScope)
+{
+    SymbolTableStack stack;
+    stack.pushScope(); // global
+
+    {
+        ScopeGuard scope(stack);
+        EXPECT_EQ(stack.levels(), 2u);
+        stack.pushScope(); // ámbito anidado que no se cerró a mano
+        EXPECT_EQ(stack.levels(), 3u);
+    }
+    EXPECT_EQ(stack.levels(), 1u);
+
+    try
+    {
+        ScopeGuard scope(stack);
+        throw std::runtime_error("error semántico");
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+    EXPECT_EQ(stack.levels(), 1u);
+}
+
+// Con tablas reservadas, abrir y cerrar ámbitos solo reutiliza tablas existentes
+TEST(SymbolTableStackTest, ReservedScopesAreReused)
+{
+    SymbolTableStack stack;
+    stack.reserveScopes(3);
+    EXPECT_EQ(stack.recycledScopes(), 3u);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ScopeGuard a(stack);
+        ScopeGuard b(stack);
+        ScopeGuard c(stack);
+        EXPECT_EQ(stack.recycledScopes(), 0u);
+    }
+    EXPECT_EQ(stack.recycledScopes(), 3u);
+}
+
+// lookup recorre del ámbito más interno al global, con y sin filtros de Bloom
+TEST(SymbolTableStackTest, LookupResolvesInnermostFirst)
+{
+    for (bool bloom : {false, true})
+    {
+        SymbolTableStack stack;
+        stack.setBloomFilters(bloom);
+
+        stack.pushScope(); // global
+        stack.insertBase({"g", 1, Category::VAR, 0, {}});
+        stack.insertBase({"a", 1, Category::VAR, 4, {}});
+        stack.pushScope();
+        stack.insertTop({"a", 2, Category::VAR, 0, {}});
+        stack.pushScope();
+        stack.insertTop({"b", 3, Category::VAR, 0, {}});
+
+        ASSERT_NE(stack.lookup("a"), nullptr);
+        EXPECT_EQ(stack.lookup("a")->typeId, 2); // la sombra local gana
+        EXPECT_EQ(stack.lookup("g")->typeId, 1);
+        EXPECT_EQ(stack.lookup("b")->typeId, 3);
+        EXPECT_EQ(stack.lookup("z"), nullptr);
+
+        // Al salir del ámbito, sus ids (y su filtro) desaparecen
+        stack.popScope();
+        EXPECT_EQ(stack.lookup("b"), nullptr);
+        stack.popScope();
+        EXPECT_EQ(stack.lookup("a")->typeId, 1);
+
+        // Un ámbito reciclado no arrastra bits del filtro anterior
+        stack.pushScope();
+        EXPECT_EQ(stack.currentScope()->hasBloomFilter(), bloom);
+        EXPECT_EQ(stack.lookupTop("a"), nullptr);
+    }
+}
+
+// Iteración sin copias en orden de inserción, dentro de un ámbito y sobre toda la pila
+TEST(SymbolTableStackTest, VisibleBindingsSkipShadowed)
+{
+    SymbolTableStack stack;
+    stack.pushScope(); // global
+    stack.insertBase({"g", 1, Category::VAR, 0, {}});
+    stack.insertBase({"a", 1, Category::VAR, 4, {}});
+    stack.insertBase({"h", 1, Category::VAR, 8, {}});
+    auto global = stack.freezeBase();
+    stack.pushScope();
+    stack.insertTop({"a", 2, Category::VAR, 0, {}});
+    stack.insertTop({"b", 2, Category::VAR, 4, {}});
+    stack.pushScope();
+    stack.insertTop({"b", 3, Category::VAR, 0, {}});
+    stack.insertTop({"c", 3, Category::VAR, 4, {}});
+
+    ASSERT_EQ(stack.scope(2), global.get());
+    EXPECT_EQ(stack.scope(3), nullptr);
+
+    // Un solo ámbito: orden de inserción y referencias a las entradas guardadas
+    std::vector<std::string> ids;
+    for (const SymbolEntry &entry : *stack.scope(0))
+    {
+        ids.emplace_back(entry.id);
+        EXPECT_EQ(&entry, stack.findTop(entry.id));
+    }
+    EXPECT_EQ(ids, (std::vector<std::string>{"b", "c"}));
+
+    // Toda la pila: del más interno al global, sin las vinculaciones ocultas
+    std::vector<std::pair<std::string, int>> visible;
+    VisibleSymbols bindings = stack.visible();
+    for (auto it = bindings.begin(); it != bindings.end(); ++it)
+    {
+        visible.emplace_back(it->id, it->typeId);
+        EXPECT_EQ(&*it, stack.find(it->id));
+    }
+    EXPECT_EQ(visible, (std::vector<std::pair<std::string, int>>{
+                           {"b", 3}, {"c", 3}, {"a", 2}, {"g", 1}, {"h", 1}}));
+
+    // Ámbitos vacíos en medio no cortan el recorrido
+    stack.pushScope();
+    size_t count = 0;
+    for (const SymbolEntry &entry : stack.visible())
+        count += !entry.id.empty();
+    EXPECT_EQ(count, 5u);
+}
+
+// La caché de símbolos calientes regresa lo mismo que la búsqueda completa
+TEST(SymbolTableStackTest, HotCacheFollowsShadowingAndScopes)
+{
+    SymbolTableStack stack;
+    stack.setHotCache(50);
+    EXPECT_EQ(stack.hotCacheSlots(), 64u);
+
+    stack.pushScope(); // global
+    stack.insertBase({"g", 1, Category::VAR, 0, {}});
+    stack.insertBase({"i", 1, Category::VAR, 4, {}});
+    stack.pushScope();
+
+    SymbolEntry *global = stack.lookup("i");
+    ASSERT_NE(global, nullptr);
+    EXPECT_EQ(stack.lookup("i"), global); // segundo lookup: acierto
+    EXPECT_EQ(stack.hotCacheStats().hits, 1u);
+    EXPECT_EQ(stack.hotCacheStats().misses, 1u);
+
+    // Un insertTop que oculta el id descarta la ranura
+    stack.insertTop({"i", 2, Category::VAR, 0, {}});
+    EXPECT_EQ(stack.hotCacheStats().invalidations, 1u);
+    EXPECT_EQ(stack.lookup("i")->typeId, 2);
+    EXPECT_EQ(stack.lookup("i")->typeId, 2);
+
+    // Al cerrar el ámbito la entrada local deja de ser visible aunque siga en la caché
+    stack.popScope();
+    EXPECT_EQ(stack.lookup("i"), global);
+
+    // Un ámbito nuevo en el mismo nivel (con la tabla reciclada) no revive la entrada vieja
+    stack.pushScope();
+    stack.insertTop({"j", 3, Category::VAR, 0, {}});
+    EXPECT_EQ(stack.lookup("j")->typeId, 3);
+    stack.popScope();
+    stack.pushScope();
+    EXPECT_EQ(stack.lookup("j"), nullptr);
+
+    // Congelar el global no invalida sus entradas
+    stack.popScope();
+    stack.freezeBase();
+    stack.pushScope();
+    size_t hits = stack.hotCacheStats().hits;
+    EXPECT_EQ(stack.find("i"), global);
+    EXPECT_EQ(stack.hotCacheStats().hits, hits + 1);
+
+    // El global ya es compartido: sus entradas no se entregan modificables
+    EXPECT_THROW(stack.lookup("i"), std::logic_error);
+    EXPECT_THROW(stack.lookupBase("i"), std::logic_error);
+    EXPECT_EQ(stack.lookup("nada"), nullptr);
+    EXPECT_GT(stack.hotCacheStats().hitRate(), 0.0);
+
+    // Un acierto sobre una entrada global se anota igual que la búsqueda completa
+    DependencyTracker deps;
+    stack.attachDependencyTracker(&deps);
+    deps.beginRegion("f");
+    EXPECT_EQ(stack.find("i"), global);
+    deps.endRegion();
+    EXPECT_EQ(deps.symbolsReadBy("f"), std::vector<std::string>{"i"});
+    stack.attachDependencyTracker(nullptr);
+
+    stack.setHotCache(0);
+    EXPECT_EQ(stack.hotCacheSlots(), 0u);
+    EXPECT_EQ(stack.find("g")->typeId, 1);
+}
@@ -0,0 +1,105 @@
+#include "../src/TableExport.hpp"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <unistd.h>
+
+namespace
+{
+    SymbolTable sampleTable()
+    {
+        SymbolTable st;
+        st.insert({"zeta", 2, Category::VAR, 8, {}});
+        st.insert({"alfa", 1, Category::FUNCTION, 0, {1, 2}});
+        st.insert({"a,\"b\"", 3, Category::CONST, 4, {}});
+        return st;
+    }
+
+    // Lee de vuelta lo que se escribió en un archivo temporal
+    std::string readAll(FILE *file)
+    {
+        std::string text;
+        std::rewind(file);
+        char chunk[256];
+        size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+            text.append(chunk, n);
+        return text;
+    }
+}
+
+// El orden determinista no depende del orden de inserción
+TEST(TableExportTest, SortedSymbolsInEveryFormat)
+{
+    SymbolTable st = sampleTable();
+    ExportOptions options;
+    options.sorted = true;
+
+    EXPECT_EQ(exportSymbolsToString(st, options),
+              "Symbol Table:\n"
+              "a,\"b\" | 3 | CONST | 4 | []\n"
+              "alfa | 1 | FUNCTION | 0 | [1, 2]\n"
+              "zeta | 2 | VAR | 8 | []\n");
+
+    options.format = ExportFormat::CSV;
+    EXPECT_EQ(exportSymbolsToString(st, options),
+              "id,type,category,address,params\n"
+              "\"a,\"\"b\"\"\",3,CONST,4,\n"
+              "alfa,1,FUNCTION,0,1;2\n"
+              "zeta,2,VAR,8,\n");
+
+    options.format = ExportFormat::JSON;
+    EXPECT_EQ(exportSymbolsToString(st, options),
+              "[\n"
+              "{\"id\":\"a,\\\"b\\\"\",\"type\":3,\"category\":\"CONST\",\"address\":4,\"params\":[]},\n"
+              "{\"id\":\"alfa\",\"type\":1,\"category\":\"FUNCTION\",\"address\":0,\"params\":[1,2]},\n"
+              "{\"id\":\"zeta\",\"type\":2,\"category\":\"VAR\",\"address\":8,\"params\":[]}\n"
+              "]\n");
+
+    EXPECT_EQ(exportSymbolsToString(SymbolTable(), options), "[\n]\n");
+}
+
+TEST(TableExportTest, TypesFollowIdOrder)
+{
+    TypeTable tt;
+    int tInt = tt.addBasicType("int", 4);
+    tt.addArrayType(tInt, 10);
+
+    EXPECT_EQ(exportTypesToString(tt),
+              "=== Tabla de Tipos ===\n"
+              "ID\tNombre\tTam\tTipo\tElem\tBase\n"
+              "0\tint\t4\tBASIC\t0\t-1\n"
+              "1\tint[10]\t40\tARRAY\t10\t0\n"
+              "======================\n");
+
+    ExportOptions options;
+    options.format = ExportFormat::CSV;
+    EXPECT_EQ(exportTypesToString(tt, options),
+              "id,name,size,kind,elements,base\n"
+              "0,int,4,BASIC,0,-1\n"
+              "1,int[10],40,ARRAY,10,0\n");
+}
+
+// En streaming el búfer se vacía por bloques y el resultado es el mismo
+TEST(TableExportTest, StreamingToFileMatchesSingleBuffer)
+{
+    SymbolTable st;
+    for (int i = 0; i < 1000; ++i)
+        st.insert({"simbolo" + std::to_string(i), i % 4, Category::VAR, i * 4, {i}});
+
+    ExportOptions options;
+    options.format = ExportFormat::JSON;
+    options.sorted = true;
+    std::string whole = exportSymbolsToString(st, options);
+
+    options.chunkBytes = 100;
+    EXPECT_EQ(exportSymbolsToString(st, options), whole);
+
+    FILE *file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(exportSymbols(st, fileno(file), options), whole.size());
+    EXPECT_EQ(readAll(file), whole);
+    std::fclose(file);
+
+    // Un descriptor inválido se reporta con excepción
+    EXPECT_THROW(exportSymbols(st, -1, options), std::runtime_error);
+}
@@ -1,6 +1,8 @@
 #include "../src/TypeManager.hpp"
 #include "../src/TypeTable.hpp"
+#include "../src/CodeGenerator.hpp"
 #include <gtest/gtest.h>
+#include <thread>
 
 // PRUEBA 1: Función max() 
 TEST(TypeManager, MaxComparaTipos) {
@@ -99,3 +101,262 @@ TEST(TypeManager, JerarquiaCompleta) {
     EXPECT_EQ(manager.max(tipoChar, tipoDouble), tipoDouble);
 }
 
+
+// PRUEBA 8: ampliar con generador reutiliza la conversión dentro del bloque
+TEST(TypeManager, AmpliarReutilizaConversionEnBloque) {
+    TypeTable tabla;
+    int tipoInt = tabla.addBasicType("int", 4);
+    int tipoDouble = tabla.addBasicType("double", 8);
+
+    TypeManager manager(tabla);
+    CodeGenerator gen;
+
+    // i convertido a double en cada término de a*i*i + b*i + c
+    std::string primero = manager.ampliar("i", tipoInt, tipoDouble, gen);
+    EXPECT_EQ(manager.ampliar("i", tipoInt, tipoDouble, gen), primero);
+    EXPECT_EQ(manager.ampliar("i", tipoInt, tipoDouble, gen), primero);
+    EXPECT_EQ(gen.getCode().size(), 1u);
+    EXPECT_EQ(gen.getCode()[0].op, "(double)");
+    EXPECT_EQ(gen.conversionCacheHits(), 2);
+
+    // Mismo tipo: no hay conversión
+    EXPECT_EQ(manager.ampliar("i", tipoInt, tipoInt, gen), "i");
+
+    // Escribir en i invalida la conversión
+    gen.emit("+", "i", "1", "i");
+    EXPECT_NE(manager.ampliar("i", tipoInt, tipoDouble, gen), primero);
+
+    // Un bloque nuevo tampoco la reutiliza
+    std::string segundo = manager.ampliar("i", tipoInt, tipoDouble, gen);
+    gen.endBlock();
+    EXPECT_NE(manager.ampliar("i", tipoInt, tipoDouble, gen), segundo);
+}
+
+// PRUEBA 9: liberar el temporal de una conversión la invalida
+TEST(TypeManager, AmpliarNoReutilizaTemporalLiberado) {
+    TypeTable tabla;
+    int tipoInt = tabla.addBasicType("int", 4);
+    int tipoFloat = tabla.addBasicType("float", 4);
+
+    TypeManager manager(tabla);
+    CodeGenerator gen;
+    gen.setTempReuse(TempReuse::RECYCLE);
+
+    std::string t = manager.ampliar("i", tipoInt, tipoFloat, gen);
+    gen.releaseTemp(t);
+    manager.ampliar("j", tipoInt, tipoFloat, gen); // reutiliza el nombre t
+
+    EXPECT_EQ(gen.getCode().size(), 2u);
+    std::string otra = manager.ampliar("i", tipoInt, tipoFloat, gen);
+    EXPECT_EQ(gen.getCode().size(), 3u);
+    EXPECT_EQ(gen.getCode()[2].arg1, "i");
+    EXPECT_NE(otra, t);
+}
+
+// PRUEBA 10: conversión inválida con generador
+TEST(TypeManager, AmpliarConGeneradorInvalidoLanzaExcepcion) {
+    TypeTable tabla;
+    int tipoInt = tabla.addBasicType("int", 4);
+    int tipoFloat = tabla.addBasicType("float", 4);
+
+    TypeManager manager(tabla);
+    CodeGenerator gen;
+
+    EXPECT_THROW(manager.ampliar("x", tipoFloat, tipoInt, gen), std::runtime_error);
+    EXPECT_TRUE(gen.getCode().empty());
+}
+
+// PRUEBA 11: checkBatch da lo mismo que las funciones escalares
+TEST(TypeManager, CheckBatchCoincideConEscalar) {
+    TypeTable tabla;
+    tabla.addBasicType("void", 0);
+    tabla.addBasicType("bool", 1);
+    tabla.addBasicType("char", 1);
+    int tipoInt = tabla.addBasicType("int", 4);
+    tabla.addBasicType("float", 4);
+    tabla.addBasicType("double", 8);
+    tabla.addArrayType(tipoInt, 10);
+    tabla.addStructType("Persona", 16, nullptr);
+    tabla.addBasicType("int", 4); // un segundo int con otro ID
+    tabla.addArrayType(tipoInt, 10); // arreglo equivalente al primero
+
+    TypeManager manager(tabla);
+    int n = tabla.count();
+
+    // Todas las combinaciones de tipos y operaciones, más IDs inválidos
+    std::vector<int32_t> t1, t2;
+    std::vector<TypeOp> ops;
+    for (int op = 0; op < static_cast<int>(TypeOp::COUNT); ++op) {
+        for (int a = -1; a <= n; ++a) {
+            for (int b = -1; b <= n; ++b) {
+                t1.push_back(a);
+                t2.push_back(b);
+                ops.push_back(static_cast<TypeOp>(op));
+            }
+        }
+    }
+
+    std::vector<int32_t> result(t1.size());
+    std::vector<uint8_t> error(t1.size());
+    manager.checkBatch(t1.data(), t2.data(), ops.data(), t1.size(), result.data(), error.data());
+
+    for (size_t i = 0; i < t1.size(); ++i) {
+        int a = t1[i], b = t2[i];
+        if (!tabla.exists(a) || !tabla.exists(b)) {
+            EXPECT_EQ(error[i], 1);
+            EXPECT_EQ(result[i], -1);
+            continue;
+        }
+
+        int expected = -1;
+        try {
+            switch (ops[i]) {
+                case TypeOp::MAX: expected = manager.max(a, b); break;
+                case TypeOp::MIN: expected = manager.min(a, b); break;
+                case TypeOp::COMPATIBLE: expected = manager.areCompatible(a, b); break;
+                case TypeOp::IMPLICIT: expected = manager.isValidConversion(a, b, true); break;
+                case TypeOp::EXPLICIT: expected = manager.isValidConversion(a, b, false); break;
+                default: break;
+            }
+        } catch (const std::runtime_error&) {
+            expected = -1;
+        }
+        EXPECT_EQ(result[i], expected) << "op " << static_cast<int>(ops[i]) << " (" << a << ", " << b << ")";
+        EXPECT_EQ(error[i], expected < 0 ? 1 : 0);
+    }
+}
+
+// PRUEBA 11b: la ruta AVX2 de checkBatch da lo mismo que la escalar (se compila siempre en
+// x86 y se elige al ejecutar, así que esta prueba la cubre sin -mavx2). Sin AVX2, forzarla
+// debe fallar en vez de correr la escalar.
+TEST(TypeManager, CheckBatchAvx2CoincideConEscalar) {
+    TypeTable tabla;
+    tabla.addBasicType("void", 0);
+    tabla.addBasicType("bool", 1);
+    tabla.addBasicType("char", 1);
+    int tipoInt = tabla.addBasicType("int", 4);
+    tabla.addBasicType("float", 4);
+    tabla.addBasicType("double", 8);
+    tabla.addArrayType(tipoInt, 10);
+    tabla.addArrayType(tipoInt, 10);
+    tabla.addStructType("Persona", 16, nullptr);
+    tabla.addBasicType("int", 4);
+
+    TypeManager manager(tabla);
+    int n = tabla.count();
+
+    // Lote con un residuo que no llena un bloque de 8, IDs y operaciones inválidos
+    std::vector<int32_t> t1, t2;
+    std::vector<TypeOp> ops;
+    uint32_t semilla = 12345;
+    auto siguiente = [&semilla](int modulo) {
+        semilla = semilla * 1103515245u + 12345u;
+        return static_cast<int>((semilla >> 8) % modulo);
+    };
+    for (int k = 0; k < 8 * 500 + 5; ++k) {
+        t1.push_back(siguiente(n + 3) - 1);
+        t2.push_back(siguiente(n + 3) - 1);
+        ops.push_back(static_cast<TypeOp>(siguiente(static_cast<int>(TypeOp::COUNT) + 2) - 1));
+    }
+
+    std::vector<int32_t> simd(t1.size()), escalar(t1.size());
+    std::vector<uint8_t> errorSimd(t1.size()), errorEscalar(t1.size());
+    if (!TypeManager::batchAvx2Available()) {
+        EXPECT_THROW(manager.checkBatch(t1.data(), t2.data(), ops.data(), t1.size(), simd.data(),
+                                        errorSimd.data(), TypeManager::BatchPath::AVX2),
+                     std::runtime_error);
+        GTEST_SKIP() << "El procesador no tiene AVX2; solo se revisó que forzarla falle";
+    }
+    manager.checkBatch(t1.data(), t2.data(), ops.data(), t1.size(), simd.data(), errorSimd.data(),
+                       TypeManager::BatchPath::AVX2);
+    manager.checkBatch(t1.data(), t2.data(), ops.data(), t1.size(), escalar.data(), errorEscalar.data(),
+                       TypeManager::BatchPath::SCALAR);
+    EXPECT_EQ(simd, escalar);
+    EXPECT_EQ(errorSimd, errorEscalar);
+}
+
+// PRUEBA 12: arreglos creados por separado con la misma estructura son compatibles
+TEST(TypeManager, ArreglosEstructuralmenteIgualesSonCompatibles) {
+    TypeTable tabla;
+    int tipoInt = tabla.addBasicType("int", 4);
+    int tipoFloat = tabla.addBasicType("float", 4);
+    int a1 = tabla.addArrayType(tipoInt, 10);
+    int a2 = tabla.addArrayType(tipoInt, 10);
+    int a3 = tabla.addArrayType(tipoInt, 5);
+    int a4 = tabla.addArrayType(tipoFloat, 10);
+
+    TypeManager manager(tabla);
+
+    EXPECT_TRUE(manager.areCompatible(a1, a2));
+    EXPECT_EQ(manager.max(a1, a2), a1);
+    EXPECT_TRUE(manager.isValidConversion(a1, a2, true));
+    EXPECT_EQ(manager.ampliar(300, a1, a2), 300); // sin conversión
+
+    EXPECT_FALSE(manager.areCompatible(a1, a3));
+    EXPECT_FALSE(manager.areCompatible(a1, a4));
+    EXPECT_THROW(manager.max(a1, a3), std::runtime_error);
+}
+
+// Las funciones escalares no dependen de la clasificación de prepareBatch: dan lo mismo
+// con o sin ella, también para tipos agregados después de preparar
+TEST(TypeManager, EscalaresIgualesConClasesPreparadas) {
+    TypeTable tabla;
+    int tipoChar = tabla.addBasicType("char", 1);
+    int tipoInt = tabla.addBasicType("int", 4);
+    int tipoDouble = tabla.addBasicType("double", 8);
+
+    TypeManager frio(tabla);
+    TypeManager preparado(tabla);
+    preparado.prepareBatch();
+
+    int tipoFloat = tabla.addBasicType("float", 4);
+    int arreglo = tabla.addArrayType(tipoInt, 3);
+    std::vector<int> tipos = {tipoChar, tipoInt, tipoDouble, tipoFloat, arreglo};
+
+    for (int t1 : tipos) {
+        for (int t2 : tipos) {
+            EXPECT_EQ(frio.areCompatible(t1, t2), preparado.areCompatible(t1, t2));
+            EXPECT_EQ(frio.isValidConversion(t1, t2, true), preparado.isValidConversion(t1, t2, true));
+            if (frio.areCompatible(t1, t2)) {
+                EXPECT_EQ(frio.max(t1, t2), preparado.max(t1, t2));
+                EXPECT_EQ(frio.min(t1, t2), preparado.min(t1, t2));
+            } else {
+                EXPECT_THROW(preparado.max(t1, t2), std::runtime_error);
+            }
+        }
+    }
+    EXPECT_THROW(preparado.max(tipoInt, 99), std::out_of_range);
+}
+
+// Las funciones escalares pueden correr en otro hilo mientras checkBatch llena por primera
+// vez sus clases (así trabajan las etapas de FrontEndPipeline)
+TEST(TypeManager, EscalaresConcurrentesConCheckBatch) {
+    TypeTable tabla;
+    int tipoChar = tabla.addBasicType("char", 1);
+    int tipoInt = tabla.addBasicType("int", 4);
+    int tipoDouble = tabla.addBasicType("double", 8);
+    for (int k = 1; k <= 2000; ++k) {
+        tabla.addArrayType(tipoInt, k);
+    }
+
+    for (int ronda = 0; ronda < 20; ++ronda) {
+        TypeManager manager(tabla);
+        std::vector<int32_t> t1(4096, tipoInt), t2(4096, tipoDouble);
+        std::vector<TypeOp> ops(4096, TypeOp::MAX);
+        std::vector<int32_t> result(t1.size());
+        std::vector<uint8_t> error(t1.size());
+
+        long maximos = 0;
+        std::thread escalar([&] {
+            for (int k = 0; k < 5000; ++k) {
+                maximos += manager.max(tipoChar, tipoDouble) == tipoDouble;
+                maximos += manager.isValidConversion(tipoInt + 1 + k % 2000, tipoInt, true) ? 1 : 0;
+            }
+        });
+        manager.checkBatch(t1.data(), t2.data(), ops.data(), t1.size(), result.data(), error.data());
+        escalar.join();
+
+        EXPECT_EQ(maximos, 5000);
+        EXPECT_EQ(result[4095], tipoDouble);
+    }
+}
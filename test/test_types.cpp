@@ -1,5 +1,7 @@
 #include "../src/TypeTable.hpp"
+#include "../src/SymbolTable.hpp"
 #include <gtest/gtest.h>
+#include <thread>
 
 // Pruebas para Tipos Básicos
 TEST(TypeTableTest, AddAndRetrieveBasicType) {
@@ -61,6 +63,29 @@ TEST(TypeTableTest, AddAndRetrieveStructType) {
     EXPECT_EQ(entry.kind, TypeKind::STRUCT);
 }
 
+// get() conserva su contrato: referencia estable con el nombre como std::string; view()
+// arma lo mismo sin copias
+TEST(TypeTableTest, GetKeepsReferenceContract) {
+    TypeTable tt;
+    int idInt = tt.addBasicType("int", 4);
+    const TypeEntry* first = &tt.get(idInt);
+    std::string name = tt.get(idInt).name;
+    EXPECT_EQ(name, "int");
+
+    // Agregar tipos no invalida la referencia ni cambia la entrada
+    for (int k = 0; k < 1000; ++k) {
+        tt.addArrayType(idInt, k + 1);
+    }
+    EXPECT_EQ(&tt.get(idInt), first);
+    EXPECT_EQ(first->name, "int");
+
+    TypeEntryView view = tt.view(idInt + 5);
+    EXPECT_EQ(view.name, "int[5]");
+    EXPECT_EQ(view.baseTypeId, idInt);
+    EXPECT_EQ(tt.get(idInt + 5).name, std::string(view.name));
+    EXPECT_THROW(tt.view(-1), std::out_of_range);
+}
+
 // Pruebas de Manejo de Errores
 TEST(TypeTableTest, InvalidAccess) {
     TypeTable tt;
@@ -70,3 +95,255 @@ TEST(TypeTableTest, InvalidAccess) {
     // Intentar crear un arreglo con un tipo base inválido debe lanzar error
     EXPECT_THROW(tt.addArrayType(999, 5), std::runtime_error);
 }
+
+// Pruebas para estructuras perezosas
+TEST(TypeTableTest, LazyStructBuildsFieldsOnFirstUse) {
+    TypeTable tt;
+    int idInt = tt.addBasicType("int", 4);
+    int idDouble = tt.addBasicType("double", 8);
+
+    // Los nombres de los campos son rangos del texto fuente
+    auto source = std::make_shared<const std::string>("struct Punto { int x; double y; };");
+    LazyStructDescriptor desc{source, {{19, 1, idInt}, {29, 1, idDouble}}};
+    int idPunto = tt.addLazyStructType("Punto", 16, desc);
+
+    // Aún no se construye nada
+    EXPECT_FALSE(tt.isMaterialized(idPunto));
+    EXPECT_EQ(tt.get(idPunto).structFields, nullptr);
+    EXPECT_EQ(tt.get(idPunto).kind, TypeKind::STRUCT);
+    EXPECT_EQ(tt.getSize(idPunto), 16);
+
+    // La primera búsqueda de un miembro construye la tabla
+    const SymbolEntry* y = tt.lookupMember(idPunto, "y");
+    ASSERT_NE(y, nullptr);
+    EXPECT_EQ(y->typeId, idDouble);
+    EXPECT_EQ(y->address, 8); // Alineado como lo haría FrameAllocator
+    EXPECT_TRUE(tt.isMaterialized(idPunto));
+    EXPECT_EQ(tt.lookupMember(idPunto, "z"), nullptr);
+
+    // getStructFields regresa siempre la misma tabla, ya visible en get()
+    SymbolTable* fields = tt.getStructFields(idPunto);
+    ASSERT_NE(fields, nullptr);
+    EXPECT_EQ(fields, tt.getStructFields(idPunto));
+    EXPECT_EQ(tt.get(idPunto).structFields, fields);
+    EXPECT_EQ(fields->getAddress("x"), 0);
+}
+
+// Un descriptor inválido se rechaza sin dejar un tipo a medio registrar
+TEST(TypeTableTest, LazyStructRejectsInvalidDescriptor) {
+    TypeTable tt;
+    int idInt = tt.addBasicType("int", 4);
+    auto source = std::make_shared<const std::string>("ab");
+    int before = tt.count();
+    Fingerprint print = tt.fingerprint();
+
+    EXPECT_THROW(tt.addLazyStructType("Malo", 8, {source, {{0, 1, idInt}, {1, 1, 99}}}), std::runtime_error);
+    EXPECT_THROW(tt.addLazyStructType("Malo", 8, {source, {{0, 1, idInt}, {1, 5, idInt}}}), std::out_of_range);
+    EXPECT_THROW(tt.addLazyStructType("Malo", 8, {source, {{3, 0, idInt}}}), std::out_of_range);
+    EXPECT_THROW(tt.addLazyStructType("Malo", 8, {nullptr, {{0, 0, idInt}}}), std::invalid_argument);
+    EXPECT_EQ(tt.count(), before);
+    EXPECT_EQ(tt.fingerprint(), print);
+
+    // Después se pueden agregar tipos normalmente
+    int id = tt.addLazyStructType("Bueno", 8, {source, {{0, 1, idInt}, {1, 1, idInt}}});
+    EXPECT_EQ(id, before);
+    EXPECT_EQ(tt.lookupMember(id, "b")->address, 4);
+
+    // Sin campos no hace falta búfer
+    int empty = tt.addLazyStructType("Vacio", 0, {nullptr, {}});
+    ASSERT_NE(tt.getStructFields(empty), nullptr);
+    EXPECT_EQ(tt.getStructFields(empty)->size(), 0u);
+}
+
+// Varios hilos construyen y consultan la misma estructura perezosa de una tabla const: una
+// sola construcción, y isMaterialized solo la ve terminada
+TEST(TypeTableTest, LazyStructMaterializesOnceAcrossThreads) {
+    auto owner = std::make_shared<TypeTable>();
+    TypeTable& tt = *owner;
+    int idInt = tt.addBasicType("int", 4);
+    auto source = std::make_shared<const std::string>("abcdefgh");
+    LazyStructDescriptor desc{source, {}};
+    for (size_t k = 0; k < 8; ++k) {
+        desc.fields.push_back({k, 1, idInt});
+    }
+    int id = tt.addLazyStructType("Ocho", 32, desc);
+
+    const TypeTable& shared = tt;
+    std::vector<SymbolTable*> seen(4, nullptr);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            if (shared.isMaterialized(id)) {
+                EXPECT_NE(shared.get(id).structFields, nullptr);
+            }
+            seen[t] = shared.getStructFields(id);
+            EXPECT_EQ(shared.lookupMember(id, "h")->address, 28);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (SymbolTable* fields : seen) {
+        EXPECT_EQ(fields, seen[0]);
+    }
+    EXPECT_TRUE(tt.isMaterialized(id));
+
+    // La capa apunta a la misma tabla sin volver a construirla
+    TypeTable layer = TypeTable::overlay(owner);
+    EXPECT_EQ(layer.getStructFields(id), seen[0]);
+    EXPECT_TRUE(layer.isMaterialized(id));
+}
+
+// La capa no copia la base: le pasa las consultas de sus IDs y guarda solo lo propio
+TEST(TypeTableTest, OverlaySharesBaseAndStoresOnlyOwnTypes) {
+    auto base = std::make_shared<TypeTable>();
+    int idInt = base->addBasicType("int", 4);
+    int idChar = base->addBasicType("char", 1);
+    for (int n = 1; n <= 200; ++n) {
+        base->addArrayType(idInt, n);
+    }
+    SymbolTable fields;
+    fields.insert({"x", idInt, Category::VAR, 0, {}});
+    int point = base->addStructType("Punto", 4, &fields);
+    base->freezeStructFields();
+    int baseCount = base->count();
+
+    TypeTable layer = TypeTable::overlay(base);
+    EXPECT_EQ(layer.count(), baseCount);
+    EXPECT_LT(layer.memoryUsage().total(), base->memoryUsage().total() / 10);
+
+    // Consultas de IDs de la base: mismas respuestas y mismas tablas de campos
+    EXPECT_EQ(layer.getNameView(idChar).data(), base->getNameView(idChar).data());
+    EXPECT_EQ(layer.getSize(idInt + 2), 4);
+    EXPECT_EQ(layer.getStructFields(point), &fields);
+    EXPECT_EQ(layer.getFrozenFields(point), base->getFrozenFields(point));
+    EXPECT_EQ(layer.lookupMember(point, "x")->typeId, idInt);
+    EXPECT_EQ(&layer.get(point), &base->get(point));
+    EXPECT_EQ(layer.ref(idInt + 5).numElements(), 4);
+
+    // Los tipos propios siguen a los de la base y se canonicalizan contra ella
+    int arr = layer.addArrayType(idInt, 3);
+    EXPECT_EQ(arr, baseCount);
+    EXPECT_EQ(layer.canonicalId(arr), 4); // int[3] de la base
+    EXPECT_TRUE(layer.equivalent(arr, 4));
+    EXPECT_EQ(layer.getName(arr), "int[3]");
+    EXPECT_EQ(layer.alignmentOf(layer.addArrayType(arr, 2)), 4);
+
+    SymbolTable same;
+    same.insert({"x", idInt, Category::VAR, 0, {}});
+    int other = layer.addStructType("Otro", 4, &same);
+    EXPECT_EQ(layer.canonicalId(other), point);
+    EXPECT_EQ(base->count(), baseCount);
+    EXPECT_FALSE(layer.exists(baseCount + 3));
+    EXPECT_THROW(layer.view(baseCount + 3), std::out_of_range);
+}
+
+// Pruebas de canonicalización estructural
+TEST(TypeTableTest, CanonicalIdsCaptureStructuralEquivalence) {
+    TypeTable tt;
+    int idInt = tt.addBasicType("int", 4);
+    int idChar = tt.addBasicType("char", 1);
+
+    // Arreglos: (tipo base canónico, elementos), también en arreglos de arreglos
+    int m1 = tt.addArrayType(tt.addArrayType(idInt, 3), 2);
+    int m2 = tt.addArrayType(tt.addArrayType(idInt, 3), 2);
+    int m3 = tt.addArrayType(tt.addArrayType(idInt, 2), 3);
+    EXPECT_TRUE(tt.equivalent(m1, m2));
+    EXPECT_EQ(tt.canonicalId(m2), m1);
+    EXPECT_FALSE(tt.equivalent(m1, m3));
+
+    // Estructuras: mismos campos con el mismo tipo y dirección, sin importar el nombre
+    SymbolTable f1, f2, f3;
+    f1.insert({"x", idInt, Category::VAR, 0, {}});
+    f1.insert({"c", idChar, Category::VAR, 4, {}});
+    f2.insert({"c", idChar, Category::VAR, 4, {}});
+    f2.insert({"x", idInt, Category::VAR, 0, {}});
+    f3.insert({"x", idInt, Category::VAR, 0, {}});
+    f3.insert({"d", idChar, Category::VAR, 4, {}});
+    int s1 = tt.addStructType("A", 8, &f1);
+    int s2 = tt.addStructType("B", 8, &f2);
+    int s3 = tt.addStructType("C", 8, &f3);
+    EXPECT_TRUE(tt.equivalent(s1, s2));
+    EXPECT_FALSE(tt.equivalent(s1, s3));
+
+    // Una perezosa con los mismos campos es equivalente sin construir su tabla
+    auto source = std::make_shared<const std::string>("x c");
+    int s4 = tt.addLazyStructType("D", 8, {source, {{0, 1, idInt}, {2, 1, idChar}}});
+    EXPECT_TRUE(tt.equivalent(s1, s4));
+    EXPECT_FALSE(tt.isMaterialized(s4));
+
+    // Los básicos son nominales y las estructuras sin campos también
+    EXPECT_FALSE(tt.equivalent(idInt, tt.addBasicType("int", 4)));
+    EXPECT_FALSE(tt.equivalent(tt.addStructType("E", 0, nullptr), tt.addStructType("E", 0, nullptr)));
+    EXPECT_THROW(tt.canonicalId(999), std::out_of_range);
+}
+
+// Congelar los campos de estructuras terminadas
+TEST(TypeTableTest, FrozenStructFieldsServeMemberLookups) {
+    TypeTable tt;
+    int idInt = tt.addBasicType("int", 4);
+    SymbolTable fields;
+    fields.insert({"a", idInt, Category::VAR, 0, {}});
+    fields.insert({"b", idInt, Category::VAR, 4, {}});
+    int idPar = tt.addStructType("Par", 8, &fields);
+
+    auto source = std::make_shared<const std::string>("struct Uno { int u; };");
+    int idUno = tt.addLazyStructType("Uno", 4, LazyStructDescriptor{source, {{17, 1, idInt}}});
+
+    EXPECT_EQ(tt.getFrozenFields(idPar), nullptr);
+    tt.freezeStructFields();
+    ASSERT_NE(tt.getFrozenFields(idPar), nullptr);
+    EXPECT_EQ(tt.getFrozenFields(idInt), nullptr);
+
+    // La copia congelada responde, incluida la de la estructura perezosa
+    EXPECT_EQ(tt.lookupMember(idPar, "b")->address, 4);
+    EXPECT_EQ(tt.lookupMember(idPar, "c"), nullptr);
+    EXPECT_TRUE(tt.isMaterialized(idUno));
+    EXPECT_EQ(tt.lookupMember(idUno, "u")->typeId, idInt);
+    EXPECT_EQ(tt.lookupMember(idPar, "a"), tt.getFrozenFields(idPar)->lookup("a"));
+
+    // Volver a congelar no crea otra copia
+    const FrozenSymbolTable* frozen = tt.getFrozenFields(idPar);
+    size_t bytes = tt.memoryUsage().total();
+    tt.freezeStructFields(idPar);
+    tt.freezeStructFields(idUno);
+    EXPECT_EQ(tt.getFrozenFields(idPar), frozen);
+    EXPECT_EQ(tt.memoryUsage().total(), bytes);
+}
+
+// Referencias validadas y accesores sin validación
+TEST(TypeTableTest, TypeRefReadsWithoutRevalidating) {
+    TypeTable tt;
+    int idInt = tt.addBasicType("int", 4);
+    int idArr = tt.addArrayType(idInt, 10);
+    auto source = std::make_shared<const std::string>("x");
+    int idLazy = tt.addLazyStructType("L", 4, LazyStructDescriptor{source, {{0, 1, idInt}}});
+
+    EXPECT_THROW(tt.ref(99), std::out_of_range);
+    EXPECT_THROW(tt.getNameView(-1), std::out_of_range);
+
+    TypeRef arr = tt.ref(idArr);
+    EXPECT_EQ(arr.id(), idArr);
+    EXPECT_EQ(arr.kind(), TypeKind::ARRAY);
+    EXPECT_EQ(arr.name(), "int[10]");
+    EXPECT_EQ(arr.size(), 40);
+    EXPECT_EQ(arr.numElements(), 10);
+    EXPECT_EQ(arr.base(), tt.ref(idInt));
+    EXPECT_EQ(arr.structFields(), nullptr);
+
+    // La vista del nombre apunta al nombre internado (sin copia)
+    EXPECT_EQ(tt.getNameView(idArr).data(), tt.nameUnchecked(idArr).data());
+    EXPECT_EQ(tt.baseTypeUnchecked(idInt), -1);
+
+    // La estructura perezosa se construye también por el camino sin validación
+    SymbolTable* fields = tt.ref(idLazy).structFields();
+    ASSERT_NE(fields, nullptr);
+    EXPECT_EQ(fields->lookup("x")->typeId, idInt);
+    EXPECT_EQ(tt.structFieldsUnchecked(idLazy), fields);
+
+    // Agregar tipos no invalida la referencia
+    for (int i = 0; i < 100; ++i) {
+        tt.addArrayType(idInt, i + 20);
+    }
+    EXPECT_EQ(arr.name(), "int[10]");
+}
@@ -0,0 +1,134 @@
+#include "../src/ValueNumbering.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+
+namespace
+{
+    struct Fixture
+    {
+        TypeTable table;
+        int tInt, tFloat;
+        TypeManager manager{table};
+        CodeGenerator gen;
+        ValueNumbering vn{gen, manager};
+
+        Fixture()
+        {
+            table.addBasicType("void", 0);
+            table.addBasicType("bool", 1);
+            table.addBasicType("char", 1);
+            tInt = table.addBasicType("int", 4);
+            tFloat = table.addBasicType("float", 4);
+        }
+    };
+}
+
+// Operaciones entre constantes se pliegan sin emitir código
+TEST(ValueNumberingTest, FoldsConstantArithmetic)
+{
+    Fixture f;
+
+    Operand sum = f.vn.binary("+", f.vn.constant(2, f.tInt), f.vn.constant(3, f.tInt));
+    EXPECT_TRUE(sum.isConstant);
+    EXPECT_EQ(sum.addr, "5");
+
+    Operand quotient = f.vn.binary("/", f.vn.constant(7, f.tInt), f.vn.constant(2, f.tInt));
+    EXPECT_EQ(quotient.addr, "3"); // división entera
+
+    // int + float: la literal entera se amplía en tiempo de compilación
+    Operand mixed = f.vn.binary("*", f.vn.constant(3, f.tInt), f.vn.constant(1.5, f.tFloat));
+    EXPECT_TRUE(mixed.isConstant);
+    EXPECT_EQ(mixed.typeId, f.tFloat);
+    EXPECT_EQ(mixed.addr, "4.5");
+
+    // La división entre cero se deja para tiempo de ejecución
+    Operand byZero = f.vn.binary("/", f.vn.constant(1, f.tInt), f.vn.constant(0, f.tInt));
+    EXPECT_FALSE(byZero.isConstant);
+
+    EXPECT_EQ(f.gen.getCode().size(), 1u);
+}
+
+// La misma conversión de la misma dirección en un bloque se emite una sola vez
+TEST(ValueNumberingTest, DropsRedundantConversions)
+{
+    Fixture f;
+    Operand i = Operand::variable("i", f.tInt);
+    Operand x = Operand::variable("x", f.tFloat);
+
+    Operand a = f.vn.binary("*", i, x); // (float) i ; i * x
+    Operand b = f.vn.binary("+", i, x); // reutiliza (float) i
+
+    const auto &code = f.gen.getCode();
+    ASSERT_EQ(code.size(), 3u);
+    EXPECT_EQ(code[0].op, "(float)");
+    EXPECT_EQ(code[0].arg1, "i");
+    EXPECT_EQ(code[1].arg1, code[0].result);
+    EXPECT_EQ(code[2].arg1, code[0].result);
+    EXPECT_NE(a.addr, b.addr);
+    EXPECT_EQ(f.vn.reusedCount(), 1);
+
+    // La conversión vive en la memoria del generador, y endBlock también la olvida
+    EXPECT_EQ(f.gen.rememberedConversions(), 1u);
+    f.vn.endBlock();
+    EXPECT_EQ(f.gen.rememberedConversions(), 0u);
+}
+
+// Subexpresiones comunes (incluidas las conmutadas) reutilizan el temporal
+TEST(ValueNumberingTest, ReusesCommonSubexpressions)
+{
+    Fixture f;
+    Operand a = Operand::variable("a", f.tInt);
+    Operand b = Operand::variable("b", f.tInt);
+
+    Operand first = f.vn.binary("+", a, b);
+    Operand second = f.vn.binary("+", b, a);
+    EXPECT_EQ(first.addr, second.addr);
+
+    // a - b no es conmutativa
+    Operand d1 = f.vn.binary("-", a, b);
+    Operand d2 = f.vn.binary("-", b, a);
+    EXPECT_NE(d1.addr, d2.addr);
+
+    // Tras asignar a, a + b es un valor nuevo
+    f.vn.assign("a", f.vn.constant(1, f.tInt));
+    Operand third = f.vn.binary("+", a, b);
+    EXPECT_NE(third.addr, first.addr);
+
+    // Al terminar el bloque se olvida todo
+    f.vn.endBlock();
+    Operand fourth = f.vn.binary("+", a, b);
+    EXPECT_NE(fourth.addr, third.addr);
+}
+
+// Conversiones inválidas siguen reportándose como en TypeManager::ampliar
+TEST(ValueNumberingTest, InvalidConversionThrows)
+{
+    Fixture f;
+    EXPECT_THROW(f.vn.convert(Operand::variable("x", f.tFloat), f.tInt), std::runtime_error);
+}
+
+// El plegado entero respeta el ancho del tipo: si el resultado desborda se deja para
+// tiempo de ejecución, y las literales fuera de rango dan la vuelta
+TEST(ValueNumberingTest, IntegerFoldingRespectsTypeWidth)
+{
+    Fixture f;
+
+    Operand big = f.vn.constant(2147483647, f.tInt);
+    EXPECT_EQ(big.addr, "2147483647");
+    EXPECT_FALSE(f.vn.binary("+", big, f.vn.constant(1, f.tInt)).isConstant);
+    EXPECT_FALSE(f.vn.binary("*", big, big).isConstant);
+
+    Operand minimum = f.vn.constant(-2147483648.0, f.tInt);
+    EXPECT_FALSE(f.vn.binary("/", minimum, f.vn.constant(-1, f.tInt)).isConstant);
+    EXPECT_EQ(f.vn.binary("%", f.vn.constant(-7, f.tInt), f.vn.constant(2, f.tInt)).addr, "-1");
+
+    // 2^31 da la vuelta a -2^31; valores enormes o no finitos no son indefinidos
+    EXPECT_EQ(f.vn.constant(2147483648.0, f.tInt).addr, "-2147483648");
+    EXPECT_EQ(f.vn.constant(4294967297.5, f.tInt).addr, "1");
+    long long huge = std::stoll(f.vn.constant(1e30, f.tInt).addr);
+    EXPECT_GE(huge, -2147483648LL);
+    EXPECT_LT(huge, 2147483648LL);
+    EXPECT_EQ(f.vn.constant(std::nan(""), f.tInt).addr, "0");
+
+    EXPECT_EQ(f.gen.getCode().size(), 3u);
+}